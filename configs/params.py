@@ -7,6 +7,10 @@ class CPU:
 class AtomicCPU(CPU):
     cxx_header = "cpu/atomiccpu.h"
 
+class JitCPU(AtomicCPU):
+    cxx_header = "cpu/jitcpu.h"
+    jit_threshold = 16
+
 class CacheCPU(CPU):
     cxx_header = "cpu/cachecpu.h"
 
@@ -20,6 +24,20 @@ class PipelineCPU(CPU):
     fdiv_delay = 19
     fsqrt_delay = 19
     fmisc_complex_delay = 1
+    valu_delay = 1
+    vmul_delay = 3
+    vdiv_delay = 20
+    vfadd_delay = 3
+    vfmul_delay = 3
+    vfma_delay = 4
+    vfdiv_delay = 20
+    vred_delay = 4
+    vperm_delay = 2
+    vload_delay = 3
+    vstore_delay = 1
+    aes_delay = 3
+    sha_delay = 1
+    clmul_delay = 2
     retire_size = 10
 
 class Predictor:
@@ -68,6 +86,28 @@ class ICache(Cache):
 
 class DCache(Cache):
     cxx_header = "cache/dcache.h"
+    mshr_num = 4
+    mshr_target_num = 4
+
+class SharedCache(Cache):
+    cxx_header = "cache/sharedcache.h"
+    set_size = 1024
+    way = 8
+    delay = 12
+    level = 2
+    inclusion = "nine"
+    queue_size = 16
+    mshr_num = 16
+    mshr_target_num = 4
+
+class L3Cache(SharedCache):
+    cxx_header = "cache/sharedcache.h"
+    set_size = 4096
+    way = 16
+    delay = 36
+    level = 3
+    inclusion = "nine"
+    mshr_num = 32
 
 class Memory(Cache):
     cxx_header = "cache/memory.h"
@@ -8,6 +8,8 @@
 #include <sstream>
 #include <string>
 
+class Checkpoint;
+
 enum FETCH_TYPE {
     IFETCH = 1,
     LFETCH = 2,
@@ -78,6 +80,19 @@ public:
      */
     virtual uint64_t updateEnv(){return 0;}
 
+    /**
+     * @brief run up to n instructions without @ref decode and @ref updateEnv
+     *
+     * Only called while the devices lag behind in a quantum. It increases tick
+     * and instret for each instruction and stops before an instruction it
+     * can not run, a pending interrupt or after a device access.
+     *
+     * @param pc pc of the next instruction, updated to the first one not run
+     * @param jit_threshold runs of a block before it is compiled to host code, 0 never compiles
+     * @return instructions run
+     */
+    virtual uint64_t run(uint64_t& pc, uint64_t n, int jit_threshold) { return 0; }
+
     /**
      * @brief flush cache
      * 
@@ -100,6 +115,14 @@ public:
     virtual constexpr uint64_t getExceptionNone() {return 0;}
     virtual bool needFlush(DecodeInfo* info) { return false; }
 
+    /**
+     * @brief whether every decoded instruction has been applied by @ref updateEnv,
+     * checkpoints can only be taken at this point
+     */
+    virtual bool instCommitted() { return true; }
+    virtual void save(Checkpoint* cp) {}
+    virtual void restore(Checkpoint* cp) {}
+
     virtual void initConfig(const std::string& config_path) {
         std::ifstream file(config_path);
         if (!file.is_open()) {
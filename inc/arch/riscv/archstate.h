@@ -2,6 +2,7 @@
 #define RISCV_ARCHSTATE_H
 #include "common/common.h"
 #include <cstddef>
+#include <vector>
 #include "arch/arch.h"
 extern "C" {
 #include "fpu/softfloat.h"
@@ -9,6 +10,9 @@ extern "C" {
 namespace cds::arch::riscv {
 
 #define MAX_RISCV_PMPS (16)
+// vector register length in bits, a register is as wide as an avx2 register
+#define VLEN 256
+#define VLENB (VLEN / 8)
 
 typedef struct {
     uint64_t pmp[MAX_RISCV_PMPS / 8];
@@ -56,6 +60,137 @@ struct ArchState {
     uint64_t mscratch;
     uint64_t stimecmp;
     pmp_table_t pmp_table;
+    uint64_t vstart;
+    uint64_t vxsat;
+    uint64_t vxrm;
+    uint64_t vl;
+    uint64_t vtype;
+    alignas(32) uint8_t vreg[32][VLENB];
+};
+
+// max size of the arg_* structs generated by decodetree.py
+#define DECODE_CACHE_ARGS 20
+
+/**
+ * @brief decoded instruction, filled by cpu_put_ic during a full decode and
+ * replayed by RiscvArch::decode while the instruction at paddr stays unchanged
+ */
+struct DecodeCacheEntry {
+    uint64_t paddr;
+    bool (*trans)(void*, void*);
+    uint32_t inst;
+    uint8_t inst_size;
+    uint8_t args[DECODE_CACHE_ARGS];
+};
+
+/**
+ * @brief how a block op commits the DecodeInfo its trans function fills
+ */
+enum BlockOpKind {
+    BLOCK_OP_NONE,   // not run by blocks, ends the block before it
+    BLOCK_OP_REG,    // writes dst 0 only
+    BLOCK_OP_LOAD,   // writes dst 0, may raise an exception
+    BLOCK_OP_STORE,  // writes dst_data[1] to dst_data[2], may raise an exception
+    BLOCK_OP_BRANCH, // taken in dst_data[1], target in dst_data[2]
+    BLOCK_OP_JUMP,   // writes dst 0, target in dst_data[2]
+    BLOCK_OP_END,    // falls through to the next block
+};
+
+struct BlockOp {
+    // label of the handler in RiscvArch::run
+    const void* handler;
+    bool (*trans)(void*, void*);
+    uint8_t kind;
+    uint8_t inst_size;
+    uint8_t args[DECODE_CACHE_ARGS];
+};
+
+/**
+ * @brief host code of a block
+ *
+ * Guest registers stay in state. Returns the pc after the last instruction
+ * run and writes their number to executed. The code leaves before a load or
+ * store that misses the tlb, is misaligned, hits mmio or a code page, the
+ * interpreter runs that instruction.
+ */
+typedef uint64_t (*JitFunc)(ArchState* state, uint64_t pc, uint64_t* executed);
+
+/**
+ * @brief straight line code starting at paddr, replayed by RiscvArch::run
+ *
+ * A block stays in one page and ends with a branch, a jump or an END op.
+ * chain caches the successor block of the taken and the not taken exit.
+ */
+struct Block {
+    uint64_t paddr;
+    // the block stopped at an instruction missing in the decode cache
+    bool partial;
+    Block* chain[2];
+    std::vector<BlockOp> ops;
+    // bytes of guest code, the not taken exit is at paddr + size
+    uint32_t size;
+    // runs before jit compilation, compiled is set after the first attempt
+    uint32_t exec_count;
+    bool compiled;
+    JitFunc native;
+};
+
+#define TLB_SIZE 256
+#define TLB_MASK (TLB_SIZE - 1)
+#define TLB_PGSHFT 12
+#define TLB_PGMASK ((1ULL << TLB_PGSHFT) - 1)
+#define TLB_ASID_GLOBAL ((uint64_t)-1)
+
+/**
+ * @brief software tlb entry for one 4K virtual page
+ *
+ * tag_read is valid for load and fetch, tag_write for store. host points
+ * to the page in guest ram, it is nullptr for mmio pages
+ */
+struct TLBEntry {
+    uint64_t tag_read;
+    uint64_t tag_write;
+    uint64_t asid;
+    uint64_t paddr;
+    uint8_t* host;
+};
+
+/**
+ * @brief direct mapped tlb, separate for fetch and data access
+ */
+struct SoftTLB {
+    TLBEntry itlb[TLB_SIZE];
+    TLBEntry dtlb[TLB_SIZE];
+    uint64_t asid;
+};
+
+static inline bool tlb_hit(SoftTLB* tlb, TLBEntry* entry, uint64_t tag, uint64_t vaddr) {
+    return tag == (vaddr >> TLB_PGSHFT) && (entry->asid == tlb->asid || entry->asid == TLB_ASID_GLOBAL);
+}
+
+/**
+ * @brief part of a vector store, size bytes at offset of VecDest::data
+ */
+struct VecStore {
+    uint64_t paddr;
+    uint16_t offset;
+    uint16_t size;
+};
+
+/**
+ * @brief vector registers and memory written by a vector instruction
+ *
+ * They do not fit the dst entries of DecodeInfo, so the trans function fills
+ * this and RiscvArch::updateEnv applies it. A store uses data for the stored
+ * bytes and writes no register.
+ */
+struct VecDest {
+    // registers vd to vd + nregs - 1 are replaced by data
+    uint8_t vd;
+    uint8_t nregs;
+    uint16_t nstores;
+    alignas(32) uint8_t data[8 * VLENB];
+    VecStore stores[8 * VLENB];
 };
 
 struct ArchEnv {
@@ -64,6 +199,9 @@ struct ArchEnv {
     Arch* arch;
     uint64_t pc;
     uint64_t paddr;
+    DecodeCacheEntry* ic;
+    SoftTLB* tlb;
+    VecDest* vdest;
 };
 
 #define DisasContext ArchEnv
@@ -177,6 +315,11 @@ constexpr size_t ARCH_MSCRATCH = offsetof(ArchState, mscratch);
 constexpr size_t ARCH_STIMECMP = offsetof(ArchState, stimecmp);
 constexpr size_t ARCH_PMPCFG = offsetof(ArchState, pmp_table.pmp);
 constexpr size_t ARCH_PMPADDR = offsetof(ArchState, pmp_table.addr);
+constexpr size_t ARCH_VSTART = offsetof(ArchState, vstart);
+constexpr size_t ARCH_VXSAT = offsetof(ArchState, vxsat);
+constexpr size_t ARCH_VXRM = offsetof(ArchState, vxrm);
+constexpr size_t ARCH_VL = offsetof(ArchState, vl);
+constexpr size_t ARCH_VTYPE = offsetof(ArchState, vtype);
 
 
 
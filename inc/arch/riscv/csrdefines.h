@@ -47,6 +47,15 @@ namespace cds::arch::riscv {
 #define CSR_FRM             0x002
 #define CSR_FCSR            0x003
 
+/* User Vector CSRs */
+#define CSR_VSTART          0x008
+#define CSR_VXSAT           0x009
+#define CSR_VXRM            0x00a
+#define CSR_VCSR            0x00f
+#define CSR_VL              0xc20
+#define CSR_VTYPE           0xc21
+#define CSR_VLENB           0xc22
+
 
 /* User Timers and Counters */
 #define CSR_CYCLE           0xc00
@@ -420,10 +429,10 @@ namespace cds::arch::riscv {
 #define MSTATUS_MASK (MSTATUS_SIE | MSTATUS_SPIE | MSTATUS_MIE | MSTATUS_MPIE | \
                      MSTATUS_SPP | MSTATUS_MPRV | MSTATUS_SUM | \
                      MSTATUS_MPP | MSTATUS_MXR | MSTATUS_TVM | MSTATUS_TSR | \
-                     MSTATUS_TW | MSTATUS_FS)
+                     MSTATUS_TW | MSTATUS_FS | MSTATUS_VS)
 #define SSTATUS_MASK  (MSTATUS_SIE | MSTATUS_SPIE | MSTATUS_UIE | MSTATUS_UPIE | \
                      MSTATUS_SPP | MSTATUS_FS | MSTATUS_XS | MSTATUS_SUM | \
-                     MSTATUS_MXR)
+                     MSTATUS_MXR | MSTATUS_VS)
 /* mip masks */
 #define MIP_SSIP                           (1 << EXCI_SSI)
 #define MIP_MSIP                           (1 << EXCI_MSI)
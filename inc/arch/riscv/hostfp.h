@@ -0,0 +1,141 @@
+#ifndef RISCV_HOSTFP_H
+#define RISCV_HOSTFP_H
+#include <bit>
+#include <cstdint>
+// softfloat relies on its includer for these
+#include <cassert>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+extern "C" {
+#include "fpu/softfloat.h"
+}
+
+namespace cds::arch::riscv {
+
+/**
+ * @brief softfloat rounding mode of a riscv rm field, dyn reads frm
+ */
+static inline FloatRoundMode riscv_round_mode(int rm, uint8_t frm) {
+    // riscv rm: rne, rtz, rdn, rup, rmm, -, -, dyn
+    static constexpr FloatRoundMode round_modes[8] = {
+        float_round_nearest_even, float_round_to_zero, float_round_down,
+        float_round_up, float_round_ties_away, float_round_nearest_even,
+        float_round_nearest_even, float_round_nearest_even
+    };
+    if (rm == 7) {
+        rm = frm;
+    }
+    return round_modes[rm & 7];
+}
+
+enum HostFpOp { HOST_FADD, HOST_FSUB, HOST_FMUL, HOST_FDIV };
+
+#if defined(__x86_64__)
+// load a clean mxcsr (rne, all masked, no ftz/daz), run op and read the flags back
+#define HOST_FP_OP(insn, a, b, csr) \
+    asm volatile("ldmxcsr %1\n\t" insn " %2, %0\n\tstmxcsr %1" : "+x"(a), "+m"(csr) : "x"(b))
+
+template <typename T>
+static inline T host_fp_calc(HostFpOp op, T a, T b) {
+    switch (op) {
+    case HOST_FADD: return a + b;
+    case HOST_FSUB: return a - b;
+    case HOST_FMUL: return a * b;
+    default: return a / b;
+    }
+}
+#endif
+
+/**
+ * @brief run a double op on the host fpu
+ *
+ * Only taken for rne and normal or zero operands. Results that are inf, nan,
+ * zero or near the subnormal range go to softfloat, so with normal operands
+ * the only flag left is inexact. If inexact is already set the plain host op
+ * is enough, otherwise it is read from mxcsr.
+ * @return false if the caller must fall back to softfloat
+ */
+static inline bool host_fp64(float_status* status, uint8_t frm, HostFpOp op, int rm, uint64_t src1, uint64_t src2, uint64_t& dest) {
+#if defined(__x86_64__)
+    uint32_t exp1 = (src1 >> 52) & 0x7ff;
+    uint32_t exp2 = (src2 >> 52) & 0x7ff;
+    if (!(rm == 0 || (rm == 7 && frm == 0)) ||
+        ((exp1 == 0 || exp1 == 0x7ff) && (src1 << 1) != 0) ||
+        ((exp2 == 0 || exp2 == 0x7ff) && (src2 << 1) != 0)) {
+        return false;
+    }
+    double a = std::bit_cast<double>(src1);
+    double b = std::bit_cast<double>(src2);
+    uint32_t csr = 0;
+    if (__builtin_expect(status->float_exception_flags & float_flag_inexact, 1)) {
+        a = host_fp_calc(op, a, b);
+    } else {
+        csr = 0x1f80;
+        switch (op) {
+        case HOST_FADD: HOST_FP_OP("addsd", a, b, csr); break;
+        case HOST_FSUB: HOST_FP_OP("subsd", a, b, csr); break;
+        case HOST_FMUL: HOST_FP_OP("mulsd", a, b, csr); break;
+        case HOST_FDIV: HOST_FP_OP("divsd", a, b, csr); break;
+        }
+    }
+    uint64_t res = std::bit_cast<uint64_t>(a);
+    uint32_t exp = (res >> 52) & 0x7ff;
+    // mxcsr: ie de ze oe ue pe
+    if (exp <= 1 || exp == 0x7ff || (csr & 0x1f)) {
+        return false;
+    }
+    if (csr & 0x20) {
+        status->float_exception_flags |= float_flag_inexact;
+    }
+    dest = res;
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief host_fp64 for float, dest is not nan boxed
+ */
+static inline bool host_fp32(float_status* status, uint8_t frm, HostFpOp op, int rm, uint32_t src1, uint32_t src2, uint32_t& dest) {
+#if defined(__x86_64__)
+    uint32_t exp1 = (src1 >> 23) & 0xff;
+    uint32_t exp2 = (src2 >> 23) & 0xff;
+    if (!(rm == 0 || (rm == 7 && frm == 0)) ||
+        ((exp1 == 0 || exp1 == 0xff) && (src1 << 1) != 0) ||
+        ((exp2 == 0 || exp2 == 0xff) && (src2 << 1) != 0)) {
+        return false;
+    }
+    float a = std::bit_cast<float>(src1);
+    float b = std::bit_cast<float>(src2);
+    uint32_t csr = 0;
+    if (__builtin_expect(status->float_exception_flags & float_flag_inexact, 1)) {
+        a = host_fp_calc(op, a, b);
+    } else {
+        csr = 0x1f80;
+        switch (op) {
+        case HOST_FADD: HOST_FP_OP("addss", a, b, csr); break;
+        case HOST_FSUB: HOST_FP_OP("subss", a, b, csr); break;
+        case HOST_FMUL: HOST_FP_OP("mulss", a, b, csr); break;
+        case HOST_FDIV: HOST_FP_OP("divss", a, b, csr); break;
+        }
+    }
+    uint32_t res = std::bit_cast<uint32_t>(a);
+    uint32_t exp = (res >> 23) & 0xff;
+    if (exp <= 1 || exp == 0xff || (csr & 0x1f)) {
+        return false;
+    }
+    if (csr & 0x20) {
+        status->float_exception_flags |= float_flag_inexact;
+    }
+    dest = res;
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace cds::arch::riscv
+
+#endif // RISCV_HOSTFP_H
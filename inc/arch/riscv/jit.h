@@ -0,0 +1,66 @@
+#ifndef RISCV_JIT_H
+#define RISCV_JIT_H
+#include "arch/riscv/archstate.h"
+
+namespace cds::arch::riscv {
+
+enum JitOp {
+    JIT_ADDI, JIT_SLTI, JIT_SLTIU, JIT_XORI, JIT_ORI, JIT_ANDI, JIT_ADDIW,
+    JIT_SLLI, JIT_SRLI, JIT_SRAI, JIT_SLLIW, JIT_SRLIW, JIT_SRAIW,
+    JIT_ADD, JIT_SUB, JIT_SLL, JIT_SLT, JIT_SLTU, JIT_XOR, JIT_SRL, JIT_SRA, JIT_OR, JIT_AND,
+    JIT_ADDW, JIT_SUBW, JIT_SLLW, JIT_SRLW, JIT_SRAW, JIT_MUL, JIT_MULW,
+    JIT_LUI, JIT_AUIPC,
+    JIT_LB, JIT_LH, JIT_LW, JIT_LD, JIT_LBU, JIT_LHU, JIT_LWU,
+    JIT_SB, JIT_SH, JIT_SW, JIT_SD,
+    JIT_BEQ, JIT_BNE, JIT_BLT, JIT_BGE, JIT_BLTU, JIT_BGEU,
+    JIT_JAL, JIT_JALR,
+};
+
+/**
+ * @brief a guest instruction the jit compiles, decoded from the args of its trans function
+ */
+struct JitInst {
+    JitOp op;
+    uint8_t rd;
+    uint8_t rs1;
+    uint8_t rs2;
+    uint8_t size;
+    int64_t imm;
+};
+
+/**
+ * @brief compiles blocks to x86-64 code in an executable buffer
+ */
+class JitCompiler {
+public:
+    JitCompiler(SoftTLB* tlb, const std::vector<uint8_t>& code_pages);
+    ~JitCompiler();
+    /**
+     * @brief whether the host can run the code, false on other than x86-64
+     */
+    static bool supported();
+    /**
+     * @brief compile a prefix of insts
+     *
+     * @param count instructions compiled, the code stops after them, 0 if
+     * there is no code buffer
+     * @return nullptr if nothing was compiled or the buffer is full, count is
+     * not 0 only in the latter
+     */
+    JitFunc compile(const std::vector<JitInst>& insts, uint32_t& count);
+    /**
+     * @brief drop all compiled code
+     */
+    void reset();
+
+private:
+    static constexpr uint64_t CODE_SIZE = 16 << 20;
+
+    SoftTLB* tlb;
+    const std::vector<uint8_t>& code_pages;
+    uint8_t* code = nullptr;
+    uint64_t code_used = 0;
+};
+
+} // namespace cds::arch::riscv
+#endif
@@ -3,11 +3,13 @@
 #include "arch/arch.h"
 #include "cache/cachemanager.h"
 #include "arch/riscv/archstate.h"
+#include "arch/riscv/jit.h"
 
 namespace cds::arch::riscv {
 
 class RiscvArch final : public Arch {
 public:
+    ~RiscvArch() override;
     void translateAddr(uint64_t vaddr, FETCH_TYPE type, uint64_t& paddr, uint64_t& exception) override;
     void handleException(uint64_t exception, uint64_t paddr, DecodeInfo* info) override;
     int decode(uint64_t vaddr, uint64_t paddr, DecodeInfo* info) override;
@@ -16,25 +18,72 @@ public:
     void initConfig(const std::string& config_path) override;
     void afterLoad() override;
     uint64_t updateEnv() override;
+    uint64_t run(uint64_t& pc, uint64_t n, int jit_threshold) override;
     uint64_t getStartPC() override { return 0x80000000; }
     void flushCache(uint8_t id, uint64_t addr, uint32_t asid) override;
     bool exceptionValid(uint64_t exception) override;
     constexpr uint64_t getExceptionNone() override { return EXC_NONE; }
     bool needFlush(DecodeInfo* info) override;
+    bool instCommitted() override { return !inst_pending; }
+    void save(Checkpoint* cp) override;
+    void restore(Checkpoint* cp) override;
     void irqListener(uint64_t irq) override;
     void printState() override;
 private:
     void fetch(uint64_t paddr, uint32_t* inst, bool& rvc, uint8_t* size);
     bool checkPermission(PTE& pte, bool ok, uint64_t vaddr, int type);
-    void initOps();
+    static void initOps();
+    uint32_t pendingIrqs();
+    void buildBlock(Block* block, uint64_t paddr);
+    void flushBlocks(uint64_t page_base);
+    void compileBlock(Block* block);
     void updateMMUState();
+    void markCodePage(uint64_t paddr);
+    void flushDecodePage(uint64_t paddr);
+    void flushDecodeCache();
+    void fillTLB(TLBEntry* entry, uint64_t vaddr, uint64_t paddr, FETCH_TYPE type, bool global);
+    void flushTLB(uint64_t vaddr, uint64_t asid);
+    void resetTLB(TLBEntry* entries);
 private:
+    static constexpr uint32_t DECODE_CACHE_SIZE = 1 << 16;
+    static constexpr uint32_t DECODE_CACHE_MASK = DECODE_CACHE_SIZE - 1;
+
     Memory* memory;
-    ArchEnv* env;
-    ArchState* state;
+    ArchEnv* env = nullptr;
+    ArchState* state = nullptr;
+
+    DecodeCacheEntry* decode_cache = nullptr;
+    // one byte per ram page, read by the code of the jit
+    std::vector<uint8_t> code_pages;
+    uint64_t decode_cache_hit = 0;
+    uint64_t decode_cache_miss = 0;
+
+    static constexpr uint32_t BLOCK_CACHE_SIZE = 1 << 14;
+    static constexpr uint32_t BLOCK_CACHE_MASK = BLOCK_CACHE_SIZE - 1;
+    static constexpr uint32_t BLOCK_MAX_OPS = 64;
+    Block* blocks = nullptr;
+    // increased when blocks are flushed, run stops after a store that does it
+    uint64_t block_epoch = 0;
+    DecodeInfo block_info;
+    uint64_t block_build = 0;
+    uint64_t block_inst = 0;
+    // created by the first run that compiles
+    JitCompiler* jit = nullptr;
+    uint64_t jit_block = 0;
+    uint64_t jit_inst = 0;
+
+    SoftTLB* tlb = nullptr;
+    // a superpage fills several entries, sfence.vma of one address flushes all
+    bool tlb_superpage = false;
+    uint64_t tlb_satp = 0;
+    uint64_t itlb_key = -1;
+    uint64_t dtlb_key = -1;
+    uint64_t tlb_miss = 0;
 
     int ifetch_mmu_state;
     int data_mmu_state;
+    // decoded but not yet applied by updateEnv
+    bool inst_pending = false;
 };
 
 REGISTER_CLASS(RiscvArch)
@@ -1,8 +1,17 @@
 #ifndef TRANS_H
 #define TRANS_H
 #include "arch/riscv/archstate.h"
+#include "arch/riscv/jit.h"
 
 namespace cds::arch::riscv {
 bool interpreter(DisasContext *ctx, uint32_t insn, bool rvc);
+/**
+ * @brief the BlockOpKind of a trans function stored in the decode cache
+ */
+BlockOpKind blockOpKind(bool (*trans)(void*, void*));
+/**
+ * @brief fill inst from a decode cache entry, false if the jit can not compile it
+ */
+bool jitInst(bool (*trans)(void*, void*), const uint8_t* args, JitInst& inst);
 } // namespace cds::arch::riscv
 #endif
\ No newline at end of file
@@ -64,6 +64,42 @@ public:
      * @brief remove current cache access, reset state
      */
     virtual void redirect() {}
+    /**
+     * @brief functional access without timing, allocate the line on miss
+     * 
+     * @param addr physical address
+     * @param is_write mark the line dirty
+     */
+    virtual void warm(uint64_t addr, bool is_write);
+    /**
+     * @brief functional miss of a child, warm the line for it
+     *
+     * @return whether the child gets the line dirty, an exclusive cache hands
+     * over its dirty bit together with the line
+     */
+    virtual bool childWarm(uint64_t addr) {
+        warm(addr, false);
+        return false;
+    }
+    /**
+     * @brief save tag array, replacement state is not saved
+     */
+    void save(Checkpoint* cp) override;
+    void restore(Checkpoint* cp) override;
+    /**
+     * @brief drop the line holding addr
+     * 
+     * @param dirty set when the dropped line was dirty
+     * @return whether the line was present
+     */
+    virtual bool invalidate(uint64_t addr, bool& dirty);
+    /**
+     * @brief a child replaced the line holding addr
+     */
+    virtual void childEvict(uint64_t addr, bool dirty) {}
+    /**
+     * @brief set the next level, this cache becomes one of its children
+     */
     void setParent(Cache* parent);
     void splitAddr(uint64_t addr, uint64_t& tag, uint32_t& set, uint32_t& offset);
     uint32_t getOffset(uint64_t addr);
@@ -72,7 +108,25 @@ public:
     int getLevel() { return level; }
 
 protected:
-    CacheTagv* match(uint64_t tag, uint32_t set);
+    /**
+     * @brief find the valid way holding tag
+     * 
+     * @return way index, -1 on miss
+     */
+    int match(uint64_t tag, uint32_t set);
+    /**
+     * @brief write tag into a way and mark it valid, a valid line in the way is evicted first
+     */
+    void fill(uint32_t set, int way_idx, uint64_t tag, bool dirty);
+    /**
+     * @brief a valid line leaves the cache, by default the parent is told
+     */
+    virtual void evict(uint64_t addr, bool dirty);
+    void setDirty(uint32_t set, int way_idx) { dirty_mask[set] |= 1ULL << way_idx; }
+    /**
+     * @brief drop every way of a set and make them the next victims
+     */
+    void invalidateSet(uint32_t set);
 
 protected:
     /**
@@ -102,13 +156,25 @@ protected:
     int level = 0;
     /**
      * @ingroup config
-     * @brief cache replace method
+     * @brief cache replace method, lru, plru, srrip, brrip, drrip or random
      */
     std::string replace_method = "lru";
 
     int line_byte = line_size / 8;
     Cache* parent = nullptr;
-    CacheTagv*** tagvs;
+    std::vector<Cache*> children;
+    /**
+     * @brief tags of set i start at tags + i * way_stride, way_stride is
+     * padded to 8 ways so every set begins on its own 64 byte line
+     */
+    uint64_t* tags = nullptr;
+    int way_stride;
+    /**
+     * @brief per set state, bit i is way i
+     */
+    uint64_t* valid_mask = nullptr;
+    uint64_t* dirty_mask = nullptr;
+    uint64_t* shared_mask = nullptr;
     uint32_t tag_offset;
     uint32_t index_offset;
     uint32_t set_mask;
@@ -2,31 +2,37 @@
 #define CACHEMANAGER_H
 #include "cache/cache.h"
 #include "cache/memory.h"
+#include "cache/physmap.h"
 #include "device/irqhandler.h"
 
 class CacheManager : public Base {
 public:
+    CacheManager() = default;
+    ~CacheManager();
+    /**
+     * @brief cache manager of the simulation running on this thread
+     */
     static CacheManager& getInstance() {
-        static CacheManager instance;  // C++11保证线程安全
-        return instance;
+        return *SimContext::current()->cache_manager;
     }
     CacheManager(const CacheManager&) = delete;
     CacheManager& operator=(const CacheManager&) = delete;
     void load() override;
     void afterLoad() override;
+    void save(Checkpoint* cp) override;
+    void restore(Checkpoint* cp) override;
     IrqHandler* getIrqHandler() { return irq_handler; }
     Cache* getCache(int id);
     Cache* getICache();
     Cache* getDCache();
-    Memory* memory;
+    Memory* memory = nullptr;
+    PhysMap* phys_map = nullptr;
     std::vector<Device*> devices;    
     std::map<int, Cache*> cache_map;
 private:
     int icache_id;
     int dcache_id;
 
-    CacheManager() = default;
-    ~CacheManager() = default;
     IrqHandler* irq_handler = nullptr;
 };
 
@@ -1,41 +1,62 @@
 #ifndef CACHE_DCACHE_H
 #define CACHE_DCACHE_H
-#include "cache/cache.h"
+#include "cache/mshr.h"
+#include <array>
 
+/**
+ * @brief non-blocking data cache
+ *
+ * A request is looked up in the tick after lookup accepts it. Hits answer
+ * at once, also while misses are outstanding. A miss allocates an MSHR,
+ * a later miss to the same line is merged into it. The request waits in
+ * the input latch, and lookup refuses new ones, while every MSHR or every
+ * target slot of the matching MSHR is taken.
+ */
 class DCache : public Cache {
 public:
     bool lookup(int callback_id, CacheReq* req) override;
     void afterLoad() override;
     void tick() override;
+    uint64_t nextTick() override;
+    void skip(uint64_t ticks) override;
     void load() override;
     void flush(uint64_t addr, uint32_t asid) override;
     void redirect() override;
 
 private:
     void handleIdleReq();
+    void refill(int idx, CacheTagv* tagv_i);
 
-    enum state_t {
-        IDLE,
-        LOOKUP,
-        WRITE,
-        MISS,
-        REFILL
-    };
+    /**
+     * @ingroup config
+     * @brief number of outstanding line misses
+     */
+    int mshr_num = 4;
+    /**
+     * @ingroup config
+     * @brief requests one MSHR can answer, including the one that allocated it
+     */
+    int mshr_target_num = 4;
 
-    state_t state = IDLE;
+    /**
+     * @brief ids of the requests answered by each refill
+     */
+    MSHRFile<std::array<uint16_t, 4>> mshrs;
+
+    /**
+     * @brief while mshrs.stall is set the latched request waits for a refill
+     */
     CacheReq* idle_req;
-    CacheReq* lookup_req;
-    
     bool idle_req_valid = false;
-    bool _match = false;
+    /**
+     * @brief ticks a store hit keeps the data array busy
+     */
+    int write_cycle = 0;
     bool flush_valid = false;
     int flush_num;
     int flush_set;
-    bool req_clear_wait = false;
-    uint32_t lookup_set;
-    uint64_t lookup_tag;
-    uint32_t replace_way;
-    CacheTagv* lookup_tagv;
+
+    uint64_t mshr_occupancy = 0;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -8,6 +8,7 @@ public:
     bool lookup(int callback_id, CacheReq* req) override;
     void afterLoad() override;
     void tick() override;
+    uint64_t nextTick() override;
     void load() override;
     void flush(uint64_t addr, uint32_t asid) override;
     void redirect() override;
@@ -12,6 +12,7 @@
 #include "memory_system/memory_system.h"
 #endif
 #include "device/device.h"
+#include "cache/physmap.h"
 #include "common/linklist.h"
 
 class Memory : public Cache {
@@ -21,12 +22,41 @@ public:
     void load() override;
     void afterLoad() override;
     void tick() override;
+    uint64_t nextTick() override;
+    void skip(uint64_t ticks) override;
+    /**
+     * @brief like nextTick, but the dram clock only counts with an outstanding request
+     */
+    uint64_t nextEventTick();
+    /**
+     * @brief let the devices lag behind the tick during a functional quantum
+     *
+     * The first mmio access catches them up to its tick and ends the lag,
+     * endLag catches them up at the end of the quantum. The dram model is
+     * not clocked while lagging.
+     */
+    void beginLag() { lag_tick = getTick(); }
+    void endLag() { endLag(getTick()); }
+    bool lagging() { return lag_tick != (uint64_t)-1; }
+    void warm(uint64_t addr, bool is_write) override {}
+    void save(Checkpoint* cp) override;
+    void restore(Checkpoint* cp) override;
     bool lookup(int callback_id, CacheReq* req) override;
     bool memoryRead(int callback_id, uint16_t* id, uint64_t addr, uint32_t size);
     bool memoryWrite(int callback_id, uint16_t* id, uint64_t addr, uint32_t size);
     void paddrRead(uint64_t paddr, uint32_t size, uint8_t *data, bool &mmio);
     void paddrWrite(uint64_t paddr, uint32_t size, uint8_t *data, bool &mmio);
     void setDevices(std::vector<Device *> devices);
+    void setPhysMap(PhysMap* phys_map) { this->phys_map = phys_map; }
+    uint64_t getSize() { return size; }
+    uint8_t* getRam() { return ram; }
+    /**
+     * @brief host address of paddr in guest ram
+     * @return nullptr if paddr is mmio or out of ram
+     */
+    uint8_t* getHostAddr(uint64_t paddr);
+
+    static constexpr uint64_t RAM_BASE = 0x80000000;
 
 
 
@@ -40,10 +70,10 @@ private:
 
     std::string filename;
 
-    uint8_t *ram;
+    uint8_t *ram = nullptr;
     uint64_t filesize;
 
-    CacheTagv *result;
+    CacheTagv *result = nullptr;
     /**
      * @ingroup config
      *
@@ -64,6 +94,15 @@ private:
     int dram_queue_size;
 
     std::vector<Device *> devices;
+    PhysMap* phys_map;
+    /**
+     * @brief catch the devices up to the ticks before end
+     */
+    void endLag(uint64_t end);
+    /**
+     * @brief first tick the devices have not seen while lagging, -1 if they are up to date
+     */
+    uint64_t lag_tick = -1;
     std::queue<DeviceReq *> device_idle_queue;
 #ifdef DRAMSIM
     ComplexCoDRAMsim3 *dram;
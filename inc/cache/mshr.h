@@ -0,0 +1,159 @@
+#ifndef CACHE_MSHR_H
+#define CACHE_MSHR_H
+#include "cache/cache.h"
+#include <queue>
+
+/**
+ * @brief miss status holding registers of a non-blocking cache
+ *
+ * A miss allocates an MSHR, a later miss to the same line is merged into it.
+ * The fill request of an MSHR carries its index in id[1], the refill
+ * callback of the parent hands it back to refill().
+ *
+ * @tparam T what the owner needs to answer a request
+ */
+template <typename T>
+class MSHRFile {
+public:
+    struct MSHR {
+        bool valid = false;
+        /**
+         * @brief a write was merged into the line
+         */
+        bool dirty = false;
+        uint32_t set;
+        uint64_t tag;
+        /**
+         * @brief fill request to the parent, id[1] is the index of the MSHR
+         */
+        CacheReq req;
+        /**
+         * @brief requests answered by the refill
+         */
+        std::vector<T> targets;
+    };
+
+    void init(int num, int target_num, int line_size) {
+        this->target_num = target_num;
+        mshrs.resize(num);
+        for (int i = 0; i < num; i++) {
+            mshrs[i].req.size = line_size;
+            mshrs[i].req.id[0] = 0;
+            mshrs[i].req.id[1] = i;
+            mshrs[i].targets.reserve(target_num);
+        }
+    }
+
+    /**
+     * @brief allocate or merge into an MSHR for a missed request
+     *
+     * @param addr address of the missed request
+     * @param type type of the missed request, the fill request keeps it
+     * @return false if the request has to wait for a free MSHR or target
+     */
+    bool add(uint32_t set, uint64_t tag, uint64_t addr, snoop_req_t type, const T& target, bool dirty) {
+        int free_idx = -1;
+        for (int i = 0; i < (int)mshrs.size(); i++) {
+            MSHR& mshr = mshrs[i];
+            if (!mshr.valid) {
+                free_idx = free_idx == -1 ? i : free_idx;
+            } else if (mshr.set == set && mshr.tag == tag) {
+                if ((int)mshr.targets.size() == target_num) {
+                    stall = true;
+                    full_stall++;
+                    return false;
+                }
+                mshr.targets.push_back(target);
+                mshr.dirty |= dirty;
+                merge++;
+                return true;
+            }
+        }
+        if (free_idx == -1) {
+            stall = true;
+            full_stall++;
+            return false;
+        }
+
+        MSHR& mshr = mshrs[free_idx];
+        mshr.valid = true;
+        mshr.dirty = dirty;
+        mshr.set = set;
+        mshr.tag = tag;
+        mshr.req.addr = addr;
+        mshr.req.req = type;
+        mshr.targets.clear();
+        mshr.targets.push_back(target);
+        issue_queue.push(free_idx);
+        valid_num++;
+        alloc++;
+        return true;
+    }
+
+    /**
+     * @brief send the oldest fill request the parent has not accepted yet
+     */
+    void issue(Cache* parent, uint8_t callback_id) {
+        if (issue_queue.empty()) {
+            return;
+        }
+        // the parent may refill before lookup returns, the MSHR is free again then
+        if (parent->lookup(callback_id, &mshrs[issue_queue.front()].req)) {
+            issue_queue.pop();
+        }
+    }
+
+    /**
+     * @brief free the MSHR with index idx
+     *
+     * @return the freed MSHR, its fields stay valid until the next add
+     */
+    MSHR& refill(int idx) {
+        MSHR& mshr = mshrs[idx];
+        mshr.valid = false;
+        valid_num--;
+        stall = false;
+        return mshr;
+    }
+
+    /**
+     * @brief drop the requests waiting for the refills, outstanding lines are still filled
+     */
+    void clearTargets() {
+        for (auto& mshr : mshrs) {
+            mshr.targets.clear();
+        }
+        stall = false;
+    }
+
+    void skip(uint64_t ticks) {
+        if (stall) {
+            full_stall += ticks;
+        }
+    }
+
+    bool issuing() { return !issue_queue.empty(); }
+    int validNum() { return valid_num; }
+
+    /**
+     * @brief the last add found no free MSHR or target, cleared by a refill
+     */
+    bool stall = false;
+    uint64_t alloc = 0;
+    uint64_t merge = 0;
+    /**
+     * @brief ticks a miss waited for a free MSHR or target
+     */
+    uint64_t full_stall = 0;
+
+private:
+    std::vector<MSHR> mshrs;
+    int target_num;
+    int valid_num = 0;
+    /**
+     * @brief MSHRs waiting for the parent to accept their fill request
+     */
+    std::queue<int> issue_queue;
+};
+
+#endif
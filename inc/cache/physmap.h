@@ -0,0 +1,69 @@
+#ifndef PHYSMAP_H
+#define PHYSMAP_H
+#include "common/common.h"
+#include "device/device.h"
+
+/**
+ * @brief page granular map of the 40 bit physical address space
+ *
+ * The space is split into 2MB regions. A region that belongs to ram or to
+ * a single device is resolved at the first level, a mixed region keeps a
+ * table of 4K pages. Devices are added after ram and take priority over it.
+ */
+class PhysMap {
+public:
+    PhysMap();
+    ~PhysMap();
+    void addRam(uint64_t base, uint64_t size, uint8_t* host);
+    void addDevice(Device* device);
+
+    /**
+     * @brief host address of paddr
+     * @return nullptr if paddr is not in ram
+     */
+    inline uint8_t* getHost(uint64_t paddr) {
+        PhysPage* page = getPage(paddr);
+        return page->host != nullptr ? page->host + (paddr & page->mask) : nullptr;
+    }
+
+    /**
+     * @brief device that owns paddr, nullptr if paddr is ram or unmapped
+     */
+    inline Device* getDevice(uint64_t paddr) {
+        return getPage(paddr)->device;
+    }
+
+private:
+    struct PhysPage {
+        // host address of the start of the page or region
+        uint8_t* host;
+        Device* device;
+        // offset mask of the page or region
+        uint64_t mask;
+    };
+
+    struct PhysRegion {
+        PhysPage region;
+        PhysPage* pages;
+    };
+
+    inline PhysPage* getPage(uint64_t paddr) {
+        PhysRegion* region = &regions[(paddr >> REGION_SHIFT) & (REGION_NUM - 1)];
+        if (likely(region->pages == nullptr)) {
+            return &region->region;
+        }
+        return &region->pages[(paddr >> PAGE_SHIFT) & (REGION_PAGES - 1)];
+    }
+
+    void map(uint64_t start, uint64_t end, uint8_t* host, Device* device);
+
+    static constexpr int PADDR_BITS = 40;
+    static constexpr int PAGE_SHIFT = 12;
+    static constexpr int REGION_SHIFT = 21;
+    static constexpr uint64_t REGION_NUM = 1ULL << (PADDR_BITS - REGION_SHIFT);
+    static constexpr uint64_t REGION_PAGES = 1ULL << (REGION_SHIFT - PAGE_SHIFT);
+
+    PhysRegion* regions;
+};
+
+#endif
@@ -2,6 +2,11 @@
 #define LRU_H
 #include "replace.h"
 
+/**
+ * @brief true LRU, the age of every way is a nibble of one word per set,
+ * 0 is the most recently used way. Sets of more than 16 ways keep one age
+ * byte per way instead.
+ */
 class LRUReplace : public Replace {
 public:
     void insert(int set, int id) override;
@@ -9,6 +14,9 @@ public:
     int get(int set) override;
     void setParams(int arg_num, ...) override;
 private:
+    uint64_t age(int set, int id) { return (ages[set] >> (id * 4)) & 0xf; }
+    void touch(int set, int id);
+
     /**
      * @ingroup config
      * @brief set size
@@ -19,11 +27,11 @@ private:
      * @brief way size
      */ 
     int way;
-    std::vector<std::list<int>> lru_list;
-    std::vector<std::map<int, std::list<int>::iterator>> lru_map;
+    std::vector<uint64_t> ages;
+    std::vector<uint8_t> wide_ages;
 };
 
 REGISTER_CLASS(LRUReplace)
 
 
-#endif
\ No newline at end of file
+#endif
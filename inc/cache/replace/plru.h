@@ -0,0 +1,31 @@
+#ifndef PLRU_H
+#define PLRU_H
+#include "replace.h"
+
+/**
+ * @brief tree pseudo LRU, node i of the binary tree is bit i of one word
+ * per set, a set bit sends the victim search to the right child
+ */
+class PLRUReplace : public Replace {
+public:
+    void insert(int set, int id) override;
+    void clear(int set, int id) override;
+    int get(int set) override;
+    void setParams(int arg_num, ...) override;
+private:
+    /**
+     * @ingroup config
+     * @brief set size
+     */
+    int set;
+    /**
+     * @ingroup config
+     * @brief way size, must be a power of two
+     */
+    int way;
+    std::vector<uint64_t> tree;
+};
+
+REGISTER_CLASS(PLRUReplace)
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef RANDOM_REPLACE_H
+#define RANDOM_REPLACE_H
+#include "replace.h"
+
+/**
+ * @brief random victim from a fixed seed xorshift, runs are reproducible
+ */
+class RandomReplace : public Replace {
+public:
+    void insert(int set, int id) override {}
+    void clear(int set, int id) override {}
+    int get(int set) override;
+    void setParams(int arg_num, ...) override;
+private:
+    /**
+     * @ingroup config
+     * @brief set size
+     */
+    int set;
+    /**
+     * @ingroup config
+     * @brief way size
+     */
+    int way;
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+};
+
+REGISTER_CLASS(RandomReplace)
+
+#endif
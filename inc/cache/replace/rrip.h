@@ -0,0 +1,59 @@
+#ifndef RRIP_H
+#define RRIP_H
+#include "replace.h"
+
+enum rrip_mode_t {
+    SRRIP,
+    BRRIP,
+    DRRIP
+};
+
+/**
+ * @brief re-reference interval prediction with 2 bit RRPVs, bit 0 and
+ * bit 1 of every way are kept in two words per set
+ * 
+ * SRRIP inserts at RRPV 2, BRRIP at 3 and only every 32th fill at 2.
+ * DRRIP duels SRRIP and BRRIP leader sets through a 10 bit PSEL counter,
+ * the other sets follow the leader that misses less.
+ */
+class RRIPReplace : public Replace {
+public:
+    RRIPReplace(rrip_mode_t mode = DRRIP);
+    void insert(int set, int id) override;
+    void clear(int set, int id) override;
+    int get(int set) override;
+    void setParams(int arg_num, ...) override;
+private:
+    void setRRPV(int set, int id, int rrpv);
+    bool useBRRIP(int set);
+
+    /**
+     * @ingroup config
+     * @brief set size
+     */
+    int set;
+    /**
+     * @ingroup config
+     * @brief way size
+     */
+    int way;
+    rrip_mode_t mode;
+    uint64_t way_mask;
+    std::vector<uint64_t> rrpv_lo;
+    std::vector<uint64_t> rrpv_hi;
+    /**
+     * @brief ways filled since the last clear, empty ways are taken first
+     * because a BRRIP fill at RRPV 3 would otherwise be the next victim again
+     */
+    std::vector<uint64_t> filled;
+    uint32_t bip_count = 0;
+    /**
+     * @brief a set with set % dueling_period == 0 leads for SRRIP, 1 leads for BRRIP
+     */
+    int dueling_period;
+    int psel = 512;
+};
+
+REGISTER_CLASS(RRIPReplace)
+
+#endif
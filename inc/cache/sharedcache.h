@@ -0,0 +1,109 @@
+#ifndef CACHE_SHAREDCACHE_H
+#define CACHE_SHAREDCACHE_H
+#include "cache/mshr.h"
+#include <array>
+#include <deque>
+
+enum inclusion_t {
+    INCLUSIVE,
+    EXCLUSIVE,
+    NINE
+};
+
+/**
+ * @brief unified lower level cache shared by every child that set a callback
+ *
+ * Requests of all children wait in one queue and are looked up in order,
+ * delay ticks after lookup accepted them. Hits answer the child at once,
+ * misses allocate or merge into an MSHR and are answered by the refill.
+ * The data of a line is not modelled, children report dirty lines when
+ * they replace them.
+ *
+ * - inclusive: misses allocate, a replaced line is invalidated in every child
+ * - exclusive: misses do not allocate, a hit moves the line and its dirty bit
+ *   to the child, lines replaced by the children are allocated
+ * - nine: misses allocate, children are not touched on replacement
+ */
+class SharedCache : public Cache {
+public:
+    bool lookup(int callback_id, CacheReq* req) override;
+    void afterLoad() override;
+    void tick() override;
+    uint64_t nextTick() override;
+    void skip(uint64_t ticks) override;
+    void load() override;
+    bool childWarm(uint64_t addr) override;
+    bool invalidate(uint64_t addr, bool& dirty) override;
+    void childEvict(uint64_t addr, bool dirty) override;
+
+protected:
+    void evict(uint64_t addr, bool dirty) override;
+
+private:
+    struct Target {
+        uint8_t callback_id;
+        std::array<uint16_t, 4> id;
+    };
+    struct Request {
+        uint64_t ready_tick;
+        uint64_t addr;
+        snoop_req_t req;
+        Target target;
+    };
+    /**
+     * @return false if the request has to wait for a free MSHR or target
+     */
+    bool handleReq(Request& request);
+    void refill(int idx, CacheTagv* tagv_i);
+
+protected:
+    /**
+     * @ingroup config
+     * @brief inclusion of the children, inclusive, exclusive or nine
+     */
+    std::string inclusion = "nine";
+    /**
+     * @ingroup config
+     * @brief requests waiting for the tag lookup
+     */
+    int queue_size = 16;
+    /**
+     * @ingroup config
+     * @brief number of outstanding line misses
+     */
+    int mshr_num = 16;
+    /**
+     * @ingroup config
+     * @brief requests one MSHR can answer, including the one that allocated it
+     */
+    int mshr_target_num = 4;
+
+private:
+    inclusion_t inclusion_mode;
+    /**
+     * @brief while mshrs.stall is set the head waits for a refill
+     */
+    std::deque<Request> req_queue;
+    MSHRFile<Target> mshrs;
+    /**
+     * @brief answer to the children, dirty when an exclusive cache hands over a dirty line
+     */
+    CacheTagv result;
+
+    uint64_t hit = 0;
+    uint64_t miss = 0;
+    uint64_t access = 0;
+    uint64_t eviction = 0;
+    uint64_t writeback = 0;
+    uint64_t back_invalidate = 0;
+};
+
+/**
+ * @brief shared cache with its own parameters, used as the level after a SharedCache
+ */
+class L3Cache : public SharedCache {
+public:
+    void load() override;
+};
+
+#endif
@@ -3,6 +3,9 @@
 
 #include "common/common.h"
 #include "arch/arch.h"
+#include "common/context.h"
+
+class Checkpoint;
 
 class Base {
 public:
@@ -17,17 +20,28 @@ public:
      */
     virtual void afterLoad() {}
     virtual void finalize() {}
-    static inline uint64_t getTick() { return *tick; }
-    static inline void upTick() { (*tick)++; }
-    static inline void setTick(uint64_t* tick) { Base::tick = tick; }
-    static inline void setArch(Arch* arch) { Base::arch = arch; }
-    static inline Arch* getArch() { return arch; }
-
-protected:
-    static Arch* arch;
-
-private:
-    static uint64_t* tick;
+    /**
+     * @brief write state to the current section of a checkpoint
+     */
+    virtual void save(Checkpoint* cp) {}
+    /**
+     * @brief read back the state written by @ref save
+     */
+    virtual void restore(Checkpoint* cp) {}
+    /**
+     * @brief earliest tick at which tick()/exec() may change state
+     *
+     * The current tick means busy, -1 means idle until a callback wakes it up.
+     * Ticks before it may be skipped by the main loop, see @ref skip.
+     */
+    virtual uint64_t nextTick() { return getTick(); }
+    /**
+     * @brief advance internal counters over ticks skipped by the main loop
+     */
+    virtual void skip(uint64_t ticks) {}
+    static inline uint64_t getTick() { return SimContext::current()->tick; }
+    static inline void upTick() { SimContext::current()->tick++; }
+    static inline Arch* getArch() { return SimContext::current()->arch; }
 };
 
 #endif // COMMON_BASE_H_
@@ -0,0 +1,75 @@
+#ifndef COMMON_CHECKPOINT_H_
+#define COMMON_CHECKPOINT_H_
+#include "common/common.h"
+
+/**
+ * @brief zstd compressed simulator snapshot
+ *
+ * A checkpoint is a list of named sections. The owner opens a section with
+ * @ref addSection and the component fills it in its save(). On restore the
+ * owner looks the section up with @ref findSection and the component reads
+ * it back in the same order.
+ *
+ * File layout: header, then one zstd frame with the section data followed
+ * by the section table.
+ */
+class Checkpoint {
+public:
+    /**
+     * @brief start a new section, following writes belong to it
+     */
+    void addSection(const std::string& name);
+    void write(const void* data, uint64_t size);
+    template <typename T>
+    void write(const T& data) { write(&data, sizeof(T)); }
+    /**
+     * @brief write the non-zero 4K pages of data
+     */
+    void writePages(const uint8_t* data, uint64_t size);
+    bool dump(const std::string& path);
+
+    /**
+     * @brief map and decompress a checkpoint file
+     */
+    bool open(const std::string& path);
+    /**
+     * @brief move the read position to the start of a section
+     * @return false if the checkpoint has no such section
+     */
+    bool findSection(const std::string& name);
+    void read(void* data, uint64_t size);
+    template <typename T>
+    void read(T& data) { read(&data, sizeof(T)); }
+    /**
+     * @brief restore pages written by @ref writePages, other pages are left untouched
+     */
+    void readPages(uint8_t* data, uint64_t size);
+
+    /**
+     * @brief also save cache tags and predictor tables
+     */
+    bool uarch = false;
+
+private:
+    struct Section {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t section_num;
+        uint64_t raw_size;
+    };
+
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint64_t PAGE_SIZE = 4096;
+
+    std::vector<uint8_t> buffer;
+    std::vector<std::pair<std::string, Section>> sections;
+    uint64_t read_pos = 0;
+    uint64_t read_end = 0;
+};
+
+#endif // COMMON_CHECKPOINT_H_
@@ -65,7 +65,24 @@ enum packed InstType {
     FMA = 26,
     FDIV = 27,
     FSQRT = 28,
-    TYPE_NUM = 29
+    VEC_START = 29,
+    VSET = 29,
+    VALU = 30,
+    VMUL = 31,
+    VDIV = 32,
+    VFADD = 33,
+    VFMUL = 34,
+    VFMA = 35,
+    VFDIV = 36,
+    VRED = 37,
+    VPERM = 38,
+    VLOAD = 39,
+    VSTORE = 40,
+    VEC_END = 40,
+    AES = 41,
+    SHA = 42,
+    CLMUL = 43,
+    TYPE_NUM = 44
 };
 
 enum packed InstResult {
@@ -0,0 +1,70 @@
+#ifndef COMMON_CONTEXT_H
+#define COMMON_CONTEXT_H
+
+#include <cstdint>
+#include <string>
+#include <map>
+#include <set>
+#include <memory>
+
+namespace spdlog {
+class logger;
+}
+class Arch;
+class CacheManager;
+class Stats;
+class Layer;
+struct LayerNode;
+
+/**
+ * @brief per simulation state, owned by EMU
+ *
+ * Components reach it through @ref current, which is thread local, so
+ * independent EMU instances may run on different threads of one process.
+ * Read-only data such as the guest image and the decode tables stay shared.
+ */
+class SimContext {
+public:
+    uint64_t tick = 0;
+    Arch* arch = nullptr;
+    CacheManager* cache_manager = nullptr;
+    Stats* stats = nullptr;
+    std::string log_path;
+    uint64_t log_start_tick = 0;
+    uint64_t log_end_tick = -1;
+    std::shared_ptr<spdlog::logger> stdio;
+    std::shared_ptr<spdlog::logger> serial;
+    std::shared_ptr<spdlog::logger> stat;
+    /**
+     * @brief trace loggers created by Log::init, by name
+     */
+    std::map<std::string, std::shared_ptr<spdlog::logger>> loggers;
+    /**
+     * @brief component parameters from the config, Class.name to value
+     */
+    std::map<std::string, std::string> params;
+    /**
+     * @brief params read by some component, see Params::apply
+     */
+    std::set<std::string> used_params;
+    /**
+     * @brief runtime component tree, nullptr when the tree generated by parse.py is used
+     */
+    std::shared_ptr<const Layer> layer;
+    /**
+     * @brief node of the component being loaded and the node params it has read
+     */
+    const LayerNode* layer_node = nullptr;
+    std::set<std::string> used_node_params;
+
+    static inline SimContext* current() { return current_context; }
+    /**
+     * @brief make context the one used by the calling thread
+     */
+    static inline void setCurrent(SimContext* context) { current_context = context; }
+
+private:
+    static inline constinit thread_local SimContext* current_context = nullptr;
+};
+
+#endif // COMMON_CONTEXT_H
@@ -3,12 +3,27 @@
 #include <functional>
 #include <vector>
 
+/**
+ * @brief thrown by ExitHandler::exit on threads that trap exits
+ */
+struct SimExit {
+    int code;
+};
+
 class ExitHandler {
 public:
     static void exit(int code);
     static void registerExitHandler(std::function<void(int)> handler);
+    static void clearExitHandler();
+    /**
+     * @brief exit() on the calling thread throws SimExit instead of ending the process
+     *
+     * Used when several simulations share the process, the handlers are not run.
+     */
+    static void trapExit(bool enable) { trap_exit = enable; }
 
 private:
     static std::vector<std::function<void(int)>> handlers;
+    static inline constinit thread_local bool trap_exit = false;
 };
 #endif
\ No newline at end of file
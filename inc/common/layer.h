@@ -0,0 +1,132 @@
+#ifndef COMMON_LAYER_H
+#define COMMON_LAYER_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <functional>
+#include <type_traits>
+#include "common/base.h"
+
+/**
+ * @brief a component of the runtime layer, the counterpart of a layer.xml node
+ */
+struct LayerNode {
+    std::string name;
+    std::string container;
+    std::string type;
+    int id = 0;
+    std::string parent;
+    /**
+     * @brief parameters of this instance, they take precedence over the class parameters
+     */
+    std::map<std::string, std::string> params;
+    std::vector<LayerNode> children;
+};
+
+/**
+ * @brief component tree and parameters read at runtime
+ *
+ * With parse.py --runtime the generated load() functions take the children of
+ * a component from the current LayerNode instead of layer.xml, so the tree and
+ * the parameters change without rebuilding. The document is yaml or json,
+ * parse.py writes the one of layer.xml and the params files to obj/layer.yaml:
+ *
+ *     cpu: PipelineCPU
+ *     params:
+ *       Cache:
+ *         way: 8
+ *     layer:
+ *       CacheManager:
+ *         children:
+ *           - {class: ICache, container: cache_map, type: map, id: 0, parent: memory, params: {way: 4}}
+ *
+ * params holds class parameters, same as Class.name in the config file. The
+ * roots of layer are the components created by EMU.
+ */
+class Layer {
+public:
+    std::string cpu;
+    std::map<std::string, std::string> params;
+    std::map<std::string, LayerNode> roots;
+
+    /**
+     * @brief read a .yaml, .yml or .json document
+     */
+    static std::shared_ptr<const Layer> read(const std::string& path);
+    /**
+     * @brief load a component created by EMU with the root node of its class
+     */
+    static void loadRoot(Base* obj, const std::string& name);
+    /**
+     * @brief children of the component being loaded
+     */
+    static const std::vector<LayerNode>& children();
+    /**
+     * @brief stop applying the node parameters in the current load()
+     *
+     * Without --runtime the children are generated from layer.xml and do not
+     * belong to the current node, the generated load() calls it after the
+     * parameters of the component itself are set.
+     */
+    static void leaveNode();
+
+    template <typename T>
+    static T* add(T*& member, const LayerNode& node) {
+        member = create<T>(node);
+        return member;
+    }
+
+    template <typename T>
+    static T* add(std::vector<T*>& member, const LayerNode& node) {
+        T* obj = create<T>(node);
+        member.push_back(obj);
+        return obj;
+    }
+
+    template <typename K, typename T>
+    static T* add(std::map<K, T*>& member, const LayerNode& node) {
+        T* obj = create<T>(node);
+        member[node.id] = obj;
+        return obj;
+    }
+
+    /**
+     * @brief make T creatable by name, abstract classes are skipped
+     */
+    template <typename T>
+    static void registerClass(const std::string& name) {
+        if constexpr (std::is_base_of_v<Base, T> && std::is_default_constructible_v<T> && !std::is_abstract_v<T>) {
+            creators()[name] = []() -> Base* { return new T(); };
+        }
+    }
+
+    static void error(const LayerNode& node, const std::string& msg);
+
+private:
+    template <typename T>
+    static T* create(const LayerNode& node) {
+        Base* base = construct(node);
+        T* obj = dynamic_cast<T*>(base);
+        if (obj == nullptr) {
+            delete base;
+            error(node, "does not fit container " + node.container);
+        }
+        load(obj, node);
+        return obj;
+    }
+    static Base* construct(const LayerNode& node);
+    static void load(Base* obj, const LayerNode& node);
+    static std::map<std::string, std::function<Base*()>>& creators();
+};
+
+template <typename T>
+class LayerRegister {
+public:
+    LayerRegister(const std::string& name) {
+        Layer::registerClass<T>(name);
+    }
+};
+
+#endif // COMMON_LAYER_H
@@ -5,6 +5,7 @@
 #include <spdlog/async.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/null_sink.h>
 #include "common/base.h"
 #include <iostream>
 #include <filesystem>
@@ -13,91 +14,104 @@ namespace fs = std::filesystem;
 
 class Log {
 public:
-    static uint64_t start_tick;
-    static uint64_t end_tick;
     static void initStdio(bool serial_stdio, bool log_stdio, const std::string& log_path) {
-        spdlog::init_thread_pool(65536, 2);
-        std::shared_ptr<spdlog::logger> std_logger;
+        SimContext* context = SimContext::current();
         if (log_stdio) {
-            std_logger = spdlog::stdout_color_mt("stdio");
+            context->stdio = stdoutLogger("stdio");
         } else {
-            std_logger = spdlog::basic_logger_mt<spdlog::async_factory>("stdio", fs::path(log_path) / "stdio.log");
+            context->stdio = fileLogger("stdio", fs::path(log_path) / "stdio.log");
         }
-        std_logger->set_pattern("%^[%l]%$ %v");
-        std_logger->set_level(spdlog::level::trace);
+        context->stdio->set_pattern("%^[%l]%$ %v");
 
-        std::shared_ptr<spdlog::logger> serial_logger = std_logger;
         if (serial_stdio) {
-            serial_logger = spdlog::stdout_color_mt("serial");
+            context->serial = stdoutLogger("serial");
         } else {
-            serial_logger = spdlog::basic_logger_mt<spdlog::async_factory>("serial", fs::path(log_path) / "serial.log");
+            context->serial = fileLogger("serial", fs::path(log_path) / "serial.log");
         }
-        serial_logger->set_pattern("%v");
-        serial_logger->set_level(spdlog::level::trace);
-
-        std::shared_ptr<spdlog::logger> stat_logger = spdlog::basic_logger_mt<spdlog::async_factory>("stat", fs::path(log_path) / "stat.log", true);
-        stat_logger->set_pattern("%v");
-        stat_logger->set_level(spdlog::level::trace);
-
-        spdlog::set_default_logger(std_logger);
 
+        context->stat = fileLogger("stat", fs::path(log_path) / "stat.log", true);
+    }
+    /**
+     * @brief replace all loggers with synchronous ones in a forked child
+     *
+     * The async thread pool does not survive fork(), so the child must not
+     * queue messages to it. stdio goes to log_file, stat to stat_file and
+     * the other loggers (serial, traces) are muted.
+     */
+    static void initFork(const std::string& log_file, const std::string& stat_file) {
+        SimContext* context = SimContext::current();
+        for (auto& logger : context->loggers) {
+            logger.second = nullLogger(logger.first);
+        }
+        context->serial = nullLogger("serial");
+        context->stdio = std::make_shared<spdlog::logger>("stdio", std::make_shared<spdlog::sinks::basic_file_sink_st>(log_file, true));
+        context->stdio->set_pattern("%^[%l]%$ %v");
+        context->stdio->set_level(spdlog::level::trace);
+        context->stdio->flush_on(spdlog::level::trace);
+        context->stat = std::make_shared<spdlog::logger>("stat", std::make_shared<spdlog::sinks::basic_file_sink_st>(stat_file, true));
+        context->stat->set_pattern("%v");
+        context->stat->set_level(spdlog::level::trace);
+        context->stat->flush_on(spdlog::level::trace);
     }
     static void init(const std::string& name, const std::string& log_file, bool is_stdout = false) {
         try {
-            if (is_stdout) {
-                auto logger = spdlog::stdout_color_mt(name);
-                logger->set_pattern("%v");
-                logger->set_level(spdlog::level::trace);
-            } else {
-                auto logger = spdlog::basic_logger_mt<spdlog::async_factory>(name, log_file);
-                logger->set_pattern("%v");
-                logger->set_level(spdlog::level::trace);
-            }
+            SimContext::current()->loggers[name] = is_stdout ? stdoutLogger(name) : fileLogger(name, log_file);
         } catch (const spdlog::spdlog_ex& ex) {
             std::cout << "Log initialization failed: " << ex.what() << std::endl;
         }
     }
+    /**
+     * @brief async logger writing to file
+     *
+     * Loggers are not registered in the spdlog registry, every simulation
+     * keeps its own in its SimContext. They share one thread pool.
+     */
+    static std::shared_ptr<spdlog::logger> fileLogger(const std::string& name, const std::string& file, bool truncate = false);
+    static std::shared_ptr<spdlog::logger> stdoutLogger(const std::string& name);
+    static std::shared_ptr<spdlog::logger> nullLogger(const std::string& name);
+
     template <typename... Args>
     static inline void trace(const std::string& name, spdlog::format_string_t<Args...> fmt, Args &&...args) {
-        if (Base::getTick() >= start_tick && Base::getTick() <= end_tick)
-            spdlog::get(name)->trace("[{0}] {1}", Base::getTick(), fmt::format(fmt, std::forward<Args>(args)...));
+        SimContext* context = SimContext::current();
+        if (context->tick >= context->log_start_tick && context->tick <= context->log_end_tick)
+            context->loggers[name]->trace("[{0}] {1}", Base::getTick(), fmt::format(fmt, std::forward<Args>(args)...));
     }
 
     template <typename... Args>
     static inline void info(spdlog::format_string_t<Args...> fmt, Args &&...args) {
-        spdlog::get("stdio")->info("[{0}] {1}", Base::getTick(), fmt::format(fmt, std::forward<Args>(args)...));
+        SimContext::current()->stdio->info("[{0}] {1}", Base::getTick(), fmt::format(fmt, std::forward<Args>(args)...));
     }
 
     template <typename... Args>
     static inline void warn(spdlog::format_string_t<Args...> fmt, Args &&...args) {
-        spdlog::get("stdio")->warn("[{0}] {1}", Base::getTick(), fmt::format(fmt, std::forward<Args>(args)...));
+        SimContext::current()->stdio->warn("[{0}] {1}", Base::getTick(), fmt::format(fmt, std::forward<Args>(args)...));
     }
 
     template <typename... Args>
     static inline void error(spdlog::format_string_t<Args...> fmt, Args &&...args) {
         Base::getArch()->printState();
-        spdlog::get("stdio")->error("[{0}] {1}", Base::getTick(), fmt::format(fmt, std::forward<Args>(args)...));
+        SimContext::current()->stdio->error("[{0}] {1}", Base::getTick(), fmt::format(fmt, std::forward<Args>(args)...));
     }
 
     static inline void serial(char c) {
-        spdlog::get("serial")->trace("{}", c);
+        SimContext::current()->serial->trace("{}", c);
     }
 
     template <typename... Args>
     static inline void stat(spdlog::format_string_t<Args...> fmt, Args &&...args) {
-        spdlog::get("stat")->info(fmt, std::forward<Args>(args)...);
+        SimContext::current()->stat->info(fmt, std::forward<Args>(args)...);
     }
 
     static inline void stat(const std::string& name, int value) {
-        spdlog::get("stat")->info("{}: {}", name, value);
+        SimContext::current()->stat->info("{}: {}", name, value);
     }
 
     static inline void stat(const std::string& name, uint64_t value) {
-        spdlog::get("stat")->info("{}: {}", name, value);
+        SimContext::current()->stat->info("{}: {}", name, value);
     }
 
     static inline void stat(const std::string& name, double value) {
-        spdlog::get("stat")->info("{}: {}", name, value);
+        SimContext::current()->stat->info("{}: {}", name, value);
     }
 
 };
@@ -0,0 +1,71 @@
+#ifndef COMMON_PARAMS_H
+#define COMMON_PARAMS_H
+
+#include <string>
+#include <iostream>
+#include <type_traits>
+#include <initializer_list>
+#include "common/context.h"
+#include "common/layer.h"
+#include "common/exithandler.h"
+
+/**
+ * @brief runtime overrides of the parameters generated by parse.py
+ *
+ * A parameter is written as Class.name=value in the config file, Class may
+ * also be a base class, e.g. Cache.way applies to ICache and DCache. With a
+ * runtime layer the params of the component node come first, see Layer.
+ */
+class Params {
+public:
+    /**
+     * @brief replace value with the runtime parameter of the first class that sets it
+     * @param classes the class and its base classes, most derived first
+     */
+    template <typename T>
+    static void apply(T& value, const char* name, std::initializer_list<const char*> classes) {
+        SimContext* context = SimContext::current();
+        if (context->layer_node != nullptr) {
+            auto iter = context->layer_node->params.find(name);
+            if (iter != context->layer_node->params.end()) {
+                parse(context->layer_node->name + "." + name, iter->second, value);
+                context->used_node_params.insert(iter->first);
+                return;
+            }
+        }
+        if (context->params.empty()) {
+            return;
+        }
+        for (const char* cls : classes) {
+            auto iter = context->params.find(std::string(cls) + "." + name);
+            if (iter != context->params.end()) {
+                parse(iter->first, iter->second, value);
+                context->used_params.insert(iter->first);
+                return;
+            }
+        }
+    }
+
+private:
+    template <typename T>
+    static void parse(const std::string& key, const std::string& str, T& value) {
+        try {
+            if constexpr (std::is_same_v<T, bool>) {
+                value = str == "true" || (str != "false" && std::stoll(str, nullptr, 0) != 0);
+            } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+                value = std::stoll(str, nullptr, 0);
+            } else if constexpr (std::is_integral_v<T>) {
+                value = std::stoull(str, nullptr, 0);
+            } else if constexpr (std::is_floating_point_v<T>) {
+                value = std::stod(str);
+            } else {
+                value = str;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error: invalid value " << str << " of parameter " << key << std::endl;
+            ExitHandler::exit(1);
+        }
+    }
+};
+
+#endif // COMMON_PARAMS_H
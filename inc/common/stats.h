@@ -3,6 +3,8 @@
 #include <any>
 #include <vector>
 #include <string>
+#include <map>
+#include "common/context.h"
 
 class Stats {
 public:
@@ -10,11 +12,26 @@ public:
     static void registerRatio(std::any divend, std::any divisor, const std::string& name, const std::string& description);
     static std::any getStat(const std::string& name);
     static void writeback();
+    /**
+     * @brief start a new measurement, writeback reports the change since the last reset
+     */
+    static void reset();
+    /**
+     * @brief values writeback would report, ratios with a zero divisor are NaN
+     */
+    static std::vector<std::pair<std::string, double>> collect();
 
 private:
+    template <typename T>
+    static T delta(T* value) {
+        auto iter = instance().bases.find(value);
+        return iter == instance().bases.end() ? *value : *value - std::any_cast<T>(iter->second);
+    }
+    static void setBase(const std::any& value);
+    static bool deltaValue(const std::any& value, double& result);
+
     static Stats& instance() {
-        static Stats stats;
-        return stats;
+        return *SimContext::current()->stats;
     }
     struct stat_t {
         std::any value;
@@ -29,6 +46,7 @@ private:
     };
     std::vector<stat_t> stats;
     std::vector<ratio_t> ratios;
+    std::map<const void*, std::any> bases;
 };
 
 #endif
\ No newline at end of file
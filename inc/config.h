@@ -11,7 +11,9 @@
 #include <cstdlib>
 #include <filesystem>
 #include <chrono>
+#include <thread>
 #include "common/exithandler.h"
+#include "common/context.h"
 namespace fs = std::filesystem;
 
 // Custom trim function to remove whitespace from both ends of a string
@@ -35,10 +37,44 @@ public:
     bool log_stdio = true;
     uint64_t log_start_tick = 0;
     uint64_t log_end_tick = -1;
+    std::string restore_path;
+    std::string checkpoint_path;
+    uint64_t checkpoint_tick = -1;
+    uint64_t checkpoint_inst = -1;
+    bool checkpoint_uarch = false;
+    uint64_t fastforward_inst = 0;
+    uint64_t warmup_inst = 0;
+    uint64_t bbv_interval = 0;
+    uint64_t sample_period = 0;
+    uint64_t sample_warmup = 2000;
+    uint64_t sample_size = 1000;
+    uint64_t sample_min = 30;
+    double sample_error = 0.03;
+    bool sample_fork = false;
+    bool skip_idle = true;
+    /**
+     * @brief instructions a functional cpu runs per call without ticking memory and caches, 1 ticks every cycle
+     */
+    uint64_t quantum = 1;
+    /**
+     * @brief functional cpu of fast forward and sampling, JitCPU compiles hot blocks
+     */
+    std::string fastforward_cpu = "AtomicCPU";
+    uint64_t sample_jobs = 0;
+    std::string bbv_path;
+    /**
+     * @brief yaml or json component tree and parameters, see Layer
+     */
+    std::string layer_path;
+    /**
+     * @brief component parameters, Class.name=value overrides the value generated by parse.py
+     */
+    std::map<std::string, std::string> params;
 
-    static std::string _log_path;
-
-    void setup(const std::string& config_path) {
+    /**
+     * @param overrides keys that replace the ones in config_path
+     */
+    void setup(const std::string& config_path, const std::map<std::string, std::string>& overrides = {}) {
         std::fstream config_file(config_path, std::ios::in);
         std::map<std::string, std::string> config_map;
         if (!config_file.is_open()) {
@@ -56,7 +92,18 @@ public:
                     config_map[key] = value;
             }
         }
+        for (auto& item : overrides) {
+            config_map[item.first] = item.second;
+        }
+        for (auto& item : config_map) {
+            if (item.first.find('.') != std::string::npos) {
+                params[item.first] = item.second;
+            }
+        }
 
+        if (config_map.find("layer_path") != config_map.end()) {
+            layer_path = config_map["layer_path"];
+        }
         if (config_map.find("memory_path") != config_map.end()) {
             memory_path = config_map["memory_path"];
         }
@@ -81,8 +128,6 @@ public:
             std::string latest_link = log_parent + "/latest";
             fs::remove_all(latest_link);
             fs::create_symlink(fs::canonical(fs::path(log_path)), latest_link);
-
-            _log_path = log_path;
         }
         if (config_map.find("arch_path") != config_map.end()) {
             arch_path = config_map["arch_path"];
@@ -99,10 +144,79 @@ public:
         if (config_map.find("log_end_tick") != config_map.end()) {
             log_end_tick = std::stoull(config_map["log_end_tick"]);
         }
+        if (config_map.find("restore_path") != config_map.end()) {
+            restore_path = config_map["restore_path"];
+        }
+        if (config_map.find("checkpoint_path") != config_map.end()) {
+            checkpoint_path = config_map["checkpoint_path"];
+        }
+        if (config_map.find("checkpoint_tick") != config_map.end()) {
+            checkpoint_tick = std::stoull(config_map["checkpoint_tick"]);
+        }
+        if (config_map.find("checkpoint_inst") != config_map.end()) {
+            checkpoint_inst = std::stoull(config_map["checkpoint_inst"]);
+        }
+        if (config_map.find("checkpoint_uarch") != config_map.end()) {
+            checkpoint_uarch = std::stoi(config_map["checkpoint_uarch"]) != 0;
+        }
+        if (config_map.find("fastforward_inst") != config_map.end()) {
+            fastforward_inst = std::stoull(config_map["fastforward_inst"]);
+        }
+        if (config_map.find("fastforward_cpu") != config_map.end()) {
+            fastforward_cpu = config_map["fastforward_cpu"];
+        }
+        if (config_map.find("warmup_inst") != config_map.end()) {
+            warmup_inst = std::stoull(config_map["warmup_inst"]);
+        }
+        if (config_map.find("bbv_interval") != config_map.end()) {
+            bbv_interval = std::stoull(config_map["bbv_interval"]);
+        }
+        if (config_map.find("bbv_path") != config_map.end()) {
+            bbv_path = config_map["bbv_path"];
+        }
+        if (config_map.find("sample_period") != config_map.end()) {
+            sample_period = std::stoull(config_map["sample_period"]);
+        }
+        if (config_map.find("sample_warmup") != config_map.end()) {
+            sample_warmup = std::stoull(config_map["sample_warmup"]);
+        }
+        if (config_map.find("sample_size") != config_map.end()) {
+            sample_size = std::stoull(config_map["sample_size"]);
+        }
+        if (config_map.find("sample_min") != config_map.end()) {
+            sample_min = std::stoull(config_map["sample_min"]);
+        }
+        if (config_map.find("sample_error") != config_map.end()) {
+            sample_error = std::stod(config_map["sample_error"]);
+        }
+        if (config_map.find("sample_fork") != config_map.end()) {
+            sample_fork = std::stoi(config_map["sample_fork"]) != 0;
+        }
+        if (config_map.find("sample_jobs") != config_map.end()) {
+            sample_jobs = std::stoull(config_map["sample_jobs"]);
+        }
+        if (config_map.find("skip_idle") != config_map.end()) {
+            skip_idle = std::stoi(config_map["skip_idle"]) != 0;
+        }
+        if (config_map.find("quantum") != config_map.end()) {
+            quantum = std::max(1ull, std::stoull(config_map["quantum"]));
+        }
+        if (sample_jobs == 0) {
+            sample_jobs = std::max(1u, std::thread::hardware_concurrency());
+        }
+        if (bbv_path.empty()) {
+            bbv_path = (fs::path(log_path) / "simpoint.bb").string();
+        }
+        if (checkpoint_path.empty()) {
+            checkpoint_path = (fs::path(log_path) / "checkpoint.ckpt").string();
+        }
     }
 
+    /**
+     * @brief path of filename in the log directory of the simulation running on this thread
+     */
     static std::string getLogFilePath(const std::string& filename) {
-        return (fs::path(_log_path) / fs::path(filename)).string();
+        return (fs::path(SimContext::current()->log_path) / fs::path(filename)).string();
     }
 };
 
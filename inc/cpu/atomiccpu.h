@@ -9,11 +9,24 @@ public:
     void load() override;
     void afterLoad() override;
     void exec() override;
+    uint64_t execQuantum(uint64_t n) override;
+    uint64_t getPC() override { return pc; }
+    void switchIn(uint64_t pc, uint64_t inst_count) override;
+    void setWarmCPU(CPU* warm_cpu) override { this->warm_cpu = warm_cpu; }
+    bool setProfiler(BBVProfiler* profiler) override { this->profiler = profiler; return true; }
+    void save(Checkpoint* cp) override;
+    void restore(Checkpoint* cp) override;
+
+protected:
+    // block runs before Arch::run compiles it, 0 never compiles
+    int jit_threshold = 0;
 
 private:
     uint64_t pc;
     uint64_t inst_count;
     DecodeInfo* info;
+    CPU* warm_cpu = nullptr;
+    BBVProfiler* profiler = nullptr;
 };
 
 REGISTER_CLASS(AtomicCPU)
@@ -0,0 +1,50 @@
+#ifndef CPU_BBV_H_
+#define CPU_BBV_H_
+#include "common/common.h"
+#include <unordered_map>
+
+/**
+ * @brief basic block vector profiler
+ *
+ * Counts the instructions executed in each basic block and writes one line
+ * per interval in SimPoint .bb format: "T:id:count :id:count ...".
+ * A basic block ends at a branch or at any change of control flow (trap,
+ * xret). Blocks are identified by their start pc, ids start from 1.
+ */
+class BBVProfiler {
+public:
+    BBVProfiler(const std::string& path, uint64_t interval);
+    ~BBVProfiler();
+
+    /**
+     * @brief record a committed instruction
+     *
+     * @param pc instruction pc
+     * @param next_pc pc after the instruction
+     * @param size instruction size, 0 if the instruction trapped before decode
+     * @param type instruction type
+     */
+    inline void commit(uint64_t pc, uint64_t next_pc, int size, InstType type) {
+        if (bb_size == 0) {
+            bb_start = pc;
+        }
+        bb_size++;
+        if ((type >= BRANCH_START && type <= BRANCH_END) || next_pc != pc + size) {
+            endBlock();
+        }
+    }
+
+private:
+    void endBlock();
+    void dumpInterval();
+
+    FILE* fp;
+    uint64_t interval;
+    uint64_t interval_inst = 0;
+    uint64_t bb_start = 0;
+    uint64_t bb_size = 0;
+    std::unordered_map<uint64_t, uint32_t> bb_ids;
+    std::unordered_map<uint32_t, uint64_t> bb_counts;
+};
+
+#endif // CPU_BBV_H_
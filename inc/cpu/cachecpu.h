@@ -9,6 +9,11 @@ public:
     void load() override;
     void afterLoad() override;
     void exec() override;
+    uint64_t getPC() override { return pc; }
+    void switchIn(uint64_t pc, uint64_t inst_count) override;
+    void warm(uint64_t pc, uint64_t paddr, uint64_t next_pc, DecodeInfo* info) override;
+    void save(Checkpoint* cp) override;
+    void restore(Checkpoint* cp) override;
 
 private:
     void icacheCallback(uint16_t* id, CacheTagv* tag);
@@ -2,12 +2,51 @@
 #define CPU_H
 #include "common/base.h"
 #include "arch/arch.h"
+#include "cpu/bbv.h"
 
 class CPU : public Base {
 public:
     virtual ~CPU() = default;
     virtual void load();
     virtual void exec() = 0;
+    /**
+     * @brief pc of the next instruction to execute
+     */
+    virtual uint64_t getPC() = 0;
+    /**
+     * @brief continue from pc after another cpu executed inst_count instructions
+     */
+    virtual void switchIn(uint64_t pc, uint64_t inst_count) = 0;
+    /**
+     * @brief drop in-flight work before another cpu takes over,
+     * the arch state and instret must be up to date afterwards
+     */
+    virtual void switchOut() {}
+    /**
+     * @brief train caches and predictor with an instruction committed by another cpu
+     *
+     * @param pc virtual address of the instruction
+     * @param paddr physical address of the instruction
+     * @param next_pc pc after the instruction
+     * @param info decode info of the instruction
+     */
+    virtual void warm(uint64_t pc, uint64_t paddr, uint64_t next_pc, DecodeInfo* info) {}
+    /**
+     * @brief forward every committed instruction to warm_cpu, nullptr to stop
+     */
+    virtual void setWarmCPU(CPU* warm_cpu) {}
+    /**
+     * @brief record every committed instruction in profiler, nullptr to stop
+     * @return false if the cpu does not support profiling
+     */
+    virtual bool setProfiler(BBVProfiler* profiler) { return false; }
+    /**
+     * @brief execute up to n instructions while memory and caches are not ticked, see EMU::runQuantum
+     *
+     * The quantum ends early after an mmio access, which ends Memory::lagging.
+     * @return instructions executed, 0 if the cpu must be ticked every cycle
+     */
+    virtual uint64_t execQuantum(uint64_t n) { return 0; }
 
 protected:
     int fetch_width;
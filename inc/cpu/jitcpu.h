@@ -0,0 +1,19 @@
+#ifndef CPU_JITCPU_H_
+#define CPU_JITCPU_H_
+
+#include "cpu/atomiccpu.h"
+
+/**
+ * @brief AtomicCPU whose hot blocks are compiled to host code
+ *
+ * A block is compiled after it ran jit_threshold times in Arch::run, so
+ * the cpu only differs from AtomicCPU when quantum is greater than 1.
+ */
+class JitCPU : public AtomicCPU {
+public:
+    void load() override;
+};
+
+REGISTER_CLASS(JitCPU)
+
+#endif
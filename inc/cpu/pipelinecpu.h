@@ -13,6 +13,14 @@ public:
     void load() override;
     void afterLoad() override;
     void exec() override;
+    uint64_t nextTick() override;
+    void skip(uint64_t ticks) override;
+    uint64_t getPC() override { return pc; }
+    void switchIn(uint64_t pc, uint64_t inst_count) override;
+    void switchOut() override;
+    void warm(uint64_t pc, uint64_t paddr, uint64_t next_pc, DecodeInfo* info) override;
+    void save(Checkpoint* cp) override;
+    void restore(Checkpoint* cp) override;
 
 private:
     struct Inst {
@@ -80,6 +88,20 @@ private:
     uint32_t fdiv_delay;
     uint32_t fsqrt_delay;
     uint32_t fmisc_complex_delay;
+    uint32_t valu_delay;
+    uint32_t vmul_delay;
+    uint32_t vdiv_delay;
+    uint32_t vfadd_delay;
+    uint32_t vfmul_delay;
+    uint32_t vfma_delay;
+    uint32_t vfdiv_delay;
+    uint32_t vred_delay;
+    uint32_t vperm_delay;
+    uint32_t vload_delay;
+    uint32_t vstore_delay;
+    uint32_t aes_delay;
+    uint32_t sha_delay;
+    uint32_t clmul_delay;
 
     Cache* icache;
     Cache* dcache;
@@ -120,6 +142,10 @@ private:
     
     Inst* wb_inst;
     uint64_t wb_tick = 0;
+    /**
+     * @brief ticks without a retired instruction before the cpu gives up
+     */
+    static constexpr uint64_t WB_TIMEOUT = 5000;
 
 #ifdef DB_INST
     struct  packed DBInstData {
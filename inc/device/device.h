@@ -19,6 +19,10 @@ public:
     virtual bool addRequest(DeviceReq* req) = 0;
     virtual DeviceReq* checkResponse() = 0;
     virtual bool inRange(uint64_t addr) = 0;
+    /**
+     * @brief physical address range [start, end) of the device, valid after afterLoad
+     */
+    virtual void getRange(uint64_t& start, uint64_t& end) = 0;
     virtual void read(uint64_t addr, int size, uint8_t* data) = 0;
     virtual void write(uint64_t addr, int size, uint8_t* data) = 0;
     virtual void setIrqHandler(IrqHandler* irq_handler) {this->irq_handler = irq_handler;}
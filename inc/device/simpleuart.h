@@ -6,9 +6,11 @@ class SimpleUart : public Device {
 public:
     void load() override;
     void tick() override;
+    uint64_t nextTick() override { return req_valid ? getTick() : -1; }
     bool addRequest(DeviceReq* req) override;
     DeviceReq* checkResponse() override;
     bool inRange(uint64_t addr) override;
+    void getRange(uint64_t& start, uint64_t& end) override;
     void read(uint64_t addr, int size, uint8_t* data) override;
     void write(uint64_t addr, int size, uint8_t* data) override;
 private:
@@ -8,11 +8,16 @@ public:
     void load() override;
     void afterLoad() override;
     void tick() override;
+    uint64_t nextTick() override;
+    void skip(uint64_t ticks) override;
     bool addRequest(DeviceReq* req) override;
     DeviceReq* checkResponse() override;
     bool inRange(uint64_t addr) override;
+    void getRange(uint64_t& start, uint64_t& end) override;
     void read(uint64_t addr, int size, uint8_t* data) override;
     void write(uint64_t addr, int size, uint8_t* data) override;
+    void save(Checkpoint* cp) override;
+    void restore(Checkpoint* cp) override;
     void setIrq(bool valid);
 private:
     uint64_t base_addr;
@@ -3,22 +3,128 @@
 
 #include "cpu/cpu.h"
 #include "config.h"
+#include "common/context.h"
+#include "common/stats.h"
+#include "sim_top.h"
+#include <map>
+#include <sys/types.h>
 
+/**
+ * @brief one simulation
+ *
+ * All mutable state lives in the EMU and its SimContext, independent EMU
+ * objects may run on different threads. init and run must be called on
+ * the same thread.
+ */
 class EMU {
 public:
     EMU();
     ~EMU();
-    void init(const std::string& config);
+    /**
+     * @param overrides config keys and component parameters that replace the ones in config
+     */
+    void init(const std::string& config, const std::map<std::string, std::string>& overrides = {});
     void run();
     void stop();
     void finalize();
+    /**
+     * @brief dump arch, cpu, memory and device state to path
+     */
+    bool save(const std::string& path);
+    bool restore(const std::string& path);
+
+private:
+    enum SimPhase {
+        PHASE_FUNC,         // functional, caches and predictor are cold
+        PHASE_WARM,         // functional, committed instructions warm detail_cpu
+        PHASE_DETAIL_WARM,  // detailed, not measured
+        PHASE_MEASURE,      // detailed, measured sample
+        PHASE_DETAIL        // detailed until the end
+    };
+
+    /**
+     * @brief move to the next phase when instret reaches switch_inst
+     */
+    void switchCPU();
+    /**
+     * @brief skip the ticks in which the cpu and caches wait for a callback
+     *
+     * If memory and devices are idle too, tick jumps to the earliest
+     * @ref Base::nextTick. Otherwise only memory is ticked until it wakes up
+     * a cache or the cpu.
+     * @return true if memory was already ticked for the current tick
+     */
+    bool skipIdle();
+    /**
+     * @brief let a functional cpu run the rest of a quantum after the instruction of this tick
+     *
+     * The quantum stops before the first tick at which memory or a cache
+     * has work and at the limits checked by run(), so devices raise
+     * interrupts at the same tick as without it. Devices catch up through
+     * Memory::skip at an mmio access or at the end of the quantum.
+     */
+    void runQuantum();
+    void switchTo(CPU* next);
+    /**
+     * @brief add the cpi of a measured sample, stop once the confidence interval is tight enough
+     */
+    void addSample(double cpi);
+    /**
+     * @brief fork a child that measures the sample at instret, the parent keeps warming
+     */
+    void forkSample();
+    /**
+     * @brief reap one finished sample child and add its cpi
+     * @param block wait until a child exits
+     * @return false if no child was reaped
+     */
+    bool waitSample(bool block);
 
 protected:
-    CPU* cpu;
-    Arch* arch;
+    /**
+     * @brief active cpu
+     */
+    CPU* cpu = nullptr;
+    /**
+     * @brief AtomicCPU for fast forward and sampling, nullptr if the run is detailed only
+     */
+    CPU* func_cpu = nullptr;
+    CPU* detail_cpu = nullptr;
+    /**
+     * @brief class of the detailed cpu, CPU_NAME or the cpu of the runtime layer
+     */
+    std::string cpu_name;
+    BBVProfiler* profiler = nullptr;
+    /**
+     * @brief per cycle calls to memory, caches and cpu, generated from layer.xml
+     */
+    SimTop top;
+    SimContext context;
+    Stats stats;
+    Arch* arch = nullptr;
     Config config;
-    uint64_t tick = 0;
+    uint64_t& tick = context.tick;
+    uint64_t idle_tick = 0;
     bool stopped = false;
+    bool checkpoint_pending = false;
+    SimPhase phase = PHASE_DETAIL;
+    uint64_t switch_inst = -1;
+    uint64_t sample_start = 0;
+    uint64_t sample_tick = 0;
+    uint64_t sample_inst = 0;
+    uint64_t sample_num = 0;
+    double sample_cpi = 0;
+    double sample_m2 = 0;
+    double sample_cpi_error = 0;
+    /**
+     * @brief running sample children, pid to the read end of their result pipe
+     */
+    std::map<pid_t, int> sample_children;
+    uint64_t sample_id = 0;
+    /**
+     * @brief write end of the result pipe in a sample child, -1 in the parent
+     */
+    int sample_fd = -1;
 };
 
 #endif
\ No newline at end of file
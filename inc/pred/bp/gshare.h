@@ -11,6 +11,8 @@ public:
     void predict(BranchStream* stream, void* meta) override;
     void update(bool real_taken, uint64_t pc, int size, uint64_t target, InstType type, void* meta_info, BPDBInfo* db_info) override;
     int getMetaSize() override;
+    void save(Checkpoint* cp) override;
+    void restore(Checkpoint* cp) override;
 
 private:
     struct GShareMeta {
@@ -10,6 +10,8 @@ public:
     void predict(BranchStream* stream, void* meta) override;
     void redirect(bool real_taken, uint64_t pc, int size, uint64_t target, InstType type, void* meta_info) override;
     int getMetaSize() override;
+    void save(Checkpoint* cp) override;
+    void restore(Checkpoint* cp) override;
 
 private:
     struct RASMeta {
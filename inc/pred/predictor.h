@@ -27,6 +27,17 @@ public:
     virtual int predict(uint64_t pc, DecodeInfo* info, uint64_t& next_pc, uint8_t& size, bool& taken, bool stall);
     virtual void redirect(bool real_taken, uint64_t pc, int size, uint64_t target, InstType type, int meta_idx);
     virtual void update(bool real_taken, uint64_t pc, int size, uint64_t target, InstType type, int meta_idx, uint64_t id);
+    /**
+     * @brief predict and train with a committed instruction, used for functional warming
+     * 
+     * @param pc The instruction pc.
+     * @param info The decode info.
+     * @param size The instruction size.
+     * @param target The real next pc.
+     */
+    virtual void warm(uint64_t pc, DecodeInfo* info, int size, uint64_t target);
+    void save(Checkpoint* cp) override;
+    void restore(Checkpoint* cp) override;
 
 protected:
     int retire_size;
@@ -0,0 +1,68 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+
+/**
+ * @brief runs a grid of design points as independent EMUs on worker threads
+ *
+ * The sweep file uses the syntax of the config file. config, output, jobs
+ * and pin describe the sweep, every other key overrides the base config,
+ * e.g. inst_count=1000000 or Cache.way=8. A value with commas is swept,
+ * the points are the cartesian product of all swept keys.
+ */
+class Sweep {
+public:
+    void setup(const std::string& path);
+    void run();
+    /**
+     * @brief write sweep.csv and sweep.json with the stats of every point to output
+     */
+    void write();
+
+private:
+    struct Point {
+        /**
+         * @brief value of each swept key, in the order of axes
+         */
+        std::vector<std::string> values;
+        /**
+         * @brief 0 if the simulation finished, otherwise its exit code
+         */
+        int status = -1;
+        double seconds = 0;
+        std::vector<std::pair<std::string, double>> stats;
+    };
+
+    void worker(int cpu);
+    void runPoint(size_t idx);
+
+    /**
+     * @brief base config of every point
+     */
+    std::string config_path;
+    /**
+     * @brief output directory, the logs of point N are in output/pointN
+     */
+    std::string output = "sweep";
+    /**
+     * @brief worker threads, 0 means one per cpu
+     */
+    uint64_t jobs = 0;
+    /**
+     * @brief pin each worker thread to its own cpu
+     */
+    bool pin = true;
+    std::map<std::string, std::string> fixed;
+    std::vector<std::pair<std::string, std::vector<std::string>>> axes;
+    std::vector<Point> points;
+    std::atomic<size_t> next_point = 0;
+    size_t done_points = 0;
+    std::mutex print_mutex;
+};
+
+#endif
@@ -45,6 +45,17 @@ output_fd = None
 output_null = False
 insntype = 'uint32_t'
 decode_function = 'decode'
+table_decode = False
+
+# Bits indexing the two levels of the --table-decode tables.  For 32 bit
+# insns the major opcode and funct3, then funct7.  For 16 bit insns the
+# quadrant and funct3, then the bits telling apart the CA and CB formats.
+table_keys = {
+    16: (0xe003, 0x1c60),
+    32: (0x0000707f, 0xfe000000),
+}
+# first level slots matching more patterns use the second level
+table_split = 4
 
 # An identifier for C.
 re_C_ident = '[a-zA-Z][a-zA-Z0-9_]*'
@@ -595,6 +606,37 @@ class Pattern(General):
         output(ind, 'if (', translate_prefix, '_', self.name,
                '(ctx, &u.f_', arg, ')) return true;\n')
 
+    def output_handler(self, fname):
+        """Output a function extracting the arguments and translating,
+           called through the decode table"""
+        global translate_prefix
+        ind = str_indent(4)
+        output('static bool ', fname, '(DisasContext *ctx, ',
+               insntype, ' insn)\n{\n')
+        output(ind, '/* ', self.file, ':', str(self.lineno), ' */\n')
+        output(ind, self.base.base.struct_name(), ' a;\n')
+        fmt_refs = self.base.dangling_references()
+        for r in fmt_refs:
+            if r not in self.fields:
+                error(self.lineno, f'format refers to undefined field {r}')
+        pat_refs = self.dangling_references()
+        for r in pat_refs:
+            if r not in self.base.fields:
+                error(self.lineno, f'pattern refers to undefined field {r}')
+        if pat_refs and fmt_refs:
+            error(self.lineno, ('pattern that uses fields defined in format '
+                                'cannot use format that uses fields defined '
+                                'in pattern'))
+        if fmt_refs:
+            self.output_fields(ind, lambda n: 'a.' + n)
+        output(ind, self.base.extract_name(), '(ctx, &a, insn);\n')
+        if not fmt_refs:
+            self.output_fields(ind, lambda n: 'a.' + n)
+        output(ind, 'if (', translate_prefix, '_', self.name,
+               '(ctx, &a)) return true;\n')
+        output(ind, 'return false;\n')
+        output('}\n\n')
+
     # Normal patterns do not have children.
     def build_tree(self):
         return
@@ -1493,6 +1535,157 @@ def prop_size(tree):
 # end prop_size
 
 
+def key_expr(mask):
+    """Return a C expression packing the bits of MASK in insn to an index"""
+    parts = []
+    out = 0
+    pos = 0
+    while mask >> pos:
+        if not (mask >> pos) & 1:
+            pos += 1
+            continue
+        width = 0
+        while (mask >> (pos + width)) & 1:
+            width += 1
+        field = ((1 << width) - 1) << out
+        if pos == out:
+            parts.append(f'(insn & {hex(field)})')
+        else:
+            parts.append(f'((insn >> {pos - out}) & {hex(field)})')
+        out += width
+        pos += width
+    return ' | '.join(parts)
+
+
+def key_bits(mask, index):
+    """Return the insn bits selected by INDEX of a table keyed by MASK"""
+    bits = 0
+    pos = 0
+    while index:
+        if (mask >> pos) & 1:
+            if index & 1:
+                bits |= 1 << pos
+            index >>= 1
+        pos += 1
+    return bits
+
+
+def key_match(pats, mask, bits):
+    """Return the patterns that can match an insn with BITS under MASK"""
+    return [p for p in pats
+            if (p.fixedbits & p.fixedmask & mask) == (bits & p.fixedmask & mask)]
+
+
+def output_table_decode(decode_scope):
+    """Output a two level table decoder instead of the decode tree
+
+    The first level is indexed by the major opcode and funct3, the
+    second by funct7, only for the slots matching more than table_split
+    patterns.  A slot holds a range of entries tested in file order, which
+    keeps the semantics of overlapping groups."""
+    global decode_function
+    global table_keys
+
+    key1, key2 = table_keys[insnwidth]
+    n1 = bin(key1).count('1')
+    n2 = bin(key2).count('1')
+    i4 = str_indent(4)
+
+    handlers = {}
+    for p in allpatterns:
+        fname = decode_function + '_' + p.name
+        n = 1
+        while fname in handlers.values():
+            n += 1
+            fname = f'{decode_function}_{p.name}_{n}'
+        handlers[p] = fname
+        p.output_handler(fname)
+
+    # Identical candidate lists share their entries
+    entries = []
+    starts = {}
+    def add_range(pats):
+        key = tuple(id(p) for p in pats)
+        if key not in starts:
+            starts[key] = len(entries)
+            entries.extend(pats)
+        if len(pats) > 255:
+            error(0, 'too many patterns in one decode table slot')
+        return (starts[key], len(pats), 0)
+
+    table1 = []
+    table2 = []
+    for i in range(1 << n1):
+        bits = key_bits(key1, i)
+        pats = key_match(allpatterns, key1, bits)
+        subs = None
+        if len(pats) > table_split:
+            subs = [key_match(pats, key2, key_bits(key2, j))
+                    for j in range(1 << n2)]
+            if max(len(s) for s in subs) == len(pats):
+                subs = None
+        if subs is None:
+            table1.append(add_range(pats))
+        else:
+            table1.append((len(table2), 0, 1))
+            for s in subs:
+                table2.append(add_range(s))
+    if len(entries) > 0xffff or len(table2) > 0xffff:
+        error(0, 'decode table too large')
+
+    entry_type = decode_function + '_entry'
+    range_type = decode_function + '_range'
+    output('typedef struct {\n',
+           i4, insntype, ' mask;\n',
+           i4, insntype, ' bits;\n',
+           i4, 'bool (*handler)(DisasContext *ctx, ', insntype, ' insn);\n',
+           '} ', entry_type, ';\n\n')
+    output('typedef struct {\n',
+           i4, 'uint16_t start;\n',
+           i4, 'uint8_t count;\n',
+           i4, '/* start is the first range in the second level table */\n',
+           i4, 'uint8_t sub;\n',
+           '} ', range_type, ';\n\n')
+
+    output('static constexpr ', entry_type, ' ', decode_function,
+           '_entries[] = {\n')
+    for p in entries:
+        output(i4, '{ ', whexC(p.fixedmask), ', ', whexC(p.fixedbits),
+               ', ', handlers[p], ' },\n')
+    output('};\n\n')
+
+    def output_ranges(name, ranges):
+        output('static constexpr ', range_type, ' ', name, '[] = {\n')
+        for i in range(0, len(ranges), 4):
+            output(i4, ' '.join(f'{{ {s}, {c}, {u} }},'
+                                for (s, c, u) in ranges[i:i + 4]), '\n')
+        output('};\n\n')
+
+    output(f'/* indexed by {str_match_bits(key1, key1)} */\n')
+    output_ranges(decode_function + '_table', table1)
+    output(f'/* indexed by {str_match_bits(key2, key2)} */\n')
+    output_ranges(decode_function + '_table2', table2 if table2 else [(0, 0, 0)])
+
+    output(decode_scope, 'bool ', decode_function,
+           '(DisasContext *ctx, ', insntype, ' insn)\n{\n')
+    output(i4, range_type, ' r = ', decode_function, '_table[',
+           key_expr(key1), '];\n')
+    output(i4, 'if (r.sub) {\n')
+    output(i4, i4, 'r = ', decode_function, '_table2[r.start + (',
+           key_expr(key2), ')];\n')
+    output(i4, '}\n')
+    output(i4, 'for (int i = r.start; i < r.start + r.count; i++) {\n')
+    output(i4, i4, 'const ', entry_type, ' *e = &', decode_function,
+           '_entries[i];\n')
+    output(i4, i4, 'if ((insn & e->mask) == e->bits && e->handler(ctx, insn)) {\n')
+    output(i4, i4, i4, 'return true;\n')
+    output(i4, i4, '}\n')
+    output(i4, '}\n')
+    output(i4, 'return false;\n')
+    output('}\n')
+# end output_table_decode
+
+
 def main():
     global arguments
     global formats
@@ -1511,12 +1704,13 @@ def main():
     global variablewidth
     global anyextern
     global testforerror
+    global table_decode
 
     decode_scope = 'static '
 
     long_opts = ['decode=', 'translate=', 'output=', 'insnwidth=',
                  'static-decode=', 'varinsnwidth=', 'test-for-error',
-                 'output-null']
+                 'output-null', 'table-decode']
     try:
         (opts, args) = getopt.gnu_getopt(sys.argv[1:], 'o:vw:', long_opts)
     except getopt.GetoptError as err:
@@ -1549,11 +1743,15 @@ def main():
             testforerror = True
         elif o == '--output-null':
             output_null = True
+        elif o == '--table-decode':
+            table_decode = True
         else:
             assert False, 'unhandled option'
 
     if len(args) < 1:
         error(0, 'missing input file')
+    if table_decode and (variablewidth or insnwidth not in table_keys):
+        error(0, 'table decode needs a fixed insnwidth of 16 or 32')
 
     toppat = ExcMultiPattern(0)
 
@@ -1624,6 +1822,12 @@ def main():
         f = formats[n]
         f.output_extract()
 
+    if table_decode:
+        output_table_decode(decode_scope)
+        if output_file:
+            output_fd.close()
+        exit(1 if testforerror else 0)
+
     output(decode_scope, 'bool ', decode_function,
            '(DisasContext *ctx, ', insntype, ' insn)\n{\n')
 
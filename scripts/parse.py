@@ -3,6 +3,7 @@ import os
 import argparse
 import xml.etree.ElementTree as ET
 import fnmatch
+import json
 
 def analyze_ast(filename):
     classes_info = []
@@ -153,9 +154,171 @@ def analyze_layer(filename):
     return class_hierarchy
 
 
+def write_sim_top(obj_dir, layers, name_header_map, dynamic):
+    # 生成静态类型的顶层SimTop, EMU::run每周期通过它调用memory, cache和cpu
+    # 成员都是具体类型, 调用不经过虚函数表, 也不遍历cache_map
+    caches = []
+    if "CacheManager" in layers:
+        for child in layers["CacheManager"]:
+            if child['type'] == "map" and child['container'] == "cache_map":
+                caches.append((int(child['id']), child['name']))
+    caches.sort()
+    headers = ["Memory", cpuname] + [name for _, name in caches]
+    # 缺少头文件的类无法静态组合, 回退到虚函数调用
+    if any(name not in name_header_map for name in headers):
+        dynamic = True
+
+    with open(os.path.join(obj_dir, "sim_top.h"), 'w') as f:
+        f.write("#ifndef SIM_TOP_H\n")
+        f.write("#define SIM_TOP_H\n\n")
+        f.write("#include \"cache/cachemanager.h\"\n")
+        f.write("#include \"cpu/cpu.h\"\n")
+        if not dynamic:
+            for name in dict.fromkeys(headers):
+                f.write(f"#include \"{name_header_map[name]}\"\n")
+        f.write("\n")
+        f.write("class SimTop {\n")
+        f.write("public:\n")
+        f.write("    void bind(CPU* cpu) {\n")
+        f.write("        CacheManager& manager = CacheManager::getInstance();\n")
+        if dynamic:
+            f.write("        memory = manager.memory;\n")
+            f.write("        this->cpu = cpu;\n")
+        else:
+            f.write("        memory = manager.memory;\n")
+            for id, name in caches:
+                f.write(f"        cache{id} = static_cast<{name}*>(manager.cache_map[{id}]);\n")
+            f.write(f"        this->cpu = static_cast<{cpuname}*>(cpu);\n")
+        f.write("    }\n")
+        if dynamic:
+            f.write("    inline void tickMemory() { memory->tick(); }\n")
+            f.write("    inline void tickCaches() {\n")
+            f.write("        for (auto& cache : CacheManager::getInstance().cache_map) {\n")
+            f.write("            cache.second->tick();\n")
+            f.write("        }\n")
+            f.write("    }\n")
+            f.write("    inline void exec(CPU* active) { active->exec(); }\n")
+        else:
+            f.write("    inline void tickMemory() { memory->Memory::tick(); }\n")
+            f.write("    inline void tickCaches() {\n")
+            for id, name in caches:
+                f.write(f"        cache{id}->{name}::tick();\n")
+            f.write("    }\n")
+            f.write("    inline void exec(CPU* active) {\n")
+            f.write("        if (likely(active == cpu)) {\n")
+            f.write(f"            cpu->{cpuname}::exec();\n")
+            f.write("        } else {\n")
+            f.write("            active->exec();\n")
+            f.write("        }\n")
+            f.write("    }\n")
+        f.write("\n")
+        f.write("private:\n")
+        f.write("    Memory* memory = nullptr;\n")
+        if dynamic:
+            f.write("    CPU* cpu = nullptr;\n")
+        else:
+            for id, name in caches:
+                f.write(f"    {name}* cache{id} = nullptr;\n")
+            f.write(f"    {cpuname}* cpu = nullptr;\n")
+        f.write("};\n\n")
+        f.write("#endif // SIM_TOP_H\n")
+
+def write_runtime_load(f, name, children, has_params=True):
+    # 运行时从 Layer 的当前节点创建子组件, container 和 parent 的名字来自 layer.xml
+    f.write(f"static LayerRegister<{name}> layer_reg_{name}(\"{name}\");\n\n")
+    f.write(f"void {name}::load() {{\n")
+    if has_params:
+        f.write(f"    {name}_SET_PARAMS\n")
+    containers = {}
+    for child in children:
+        if child['container'] is None:
+            continue
+        parents = containers.setdefault(child['container'], [])
+        if child['parent'] is not None and child['parent'] not in parents:
+            parents.append(child['parent'])
+    f.write("    for (const LayerNode& child : Layer::children()) {\n")
+    prefix = "if"
+    for container, parents in containers.items():
+        f.write(f"        {prefix} (child.container == \"{container}\") {{\n")
+        if parents:
+            f.write(f"            auto* obj = Layer::add({container}, child);\n")
+            parent_prefix = "if"
+            for parent in parents:
+                f.write(f"            {parent_prefix} (child.parent == \"{parent}\") {{\n")
+                f.write(f"                obj->setParent({parent});\n")
+                parent_prefix = "} else if"
+            f.write("            } else if (!child.parent.empty()) {\n")
+            f.write("                Layer::error(child, \"has unknown parent \" + child.parent);\n")
+            f.write("            }\n")
+        else:
+            f.write(f"            Layer::add({container}, child);\n")
+            f.write("            if (!child.parent.empty()) {\n")
+            f.write("                Layer::error(child, \"has unknown parent \" + child.parent);\n")
+            f.write("            }\n")
+        prefix = "} else if"
+    if containers:
+        f.write("        } else {\n")
+        f.write(f"            Layer::error(child, \"is in unknown container \" + child.container + \" of {name}\");\n")
+        f.write("        }\n")
+    else:
+        f.write(f"        Layer::error(child, \"is in unknown container \" + child.container + \" of {name}\");\n")
+    f.write("    }\n")
+    f.write("}\n")
+
+
+def yaml_value(value):
+    if type(value) == bool:
+        return str(value).lower()
+    if type(value) == str:
+        return json.dumps(value)
+    return str(value)
+
+
+def write_layer_yaml(obj_dir, layers, classes_info):
+    # 生成运行时使用的 layer.yaml, 可以复制后修改组件树和参数, 通过 layer_path 指定
+    def write_children(f, name, indent):
+        children = layers.get(name, [])
+        if not children:
+            return
+        f.write(f"{indent}children:\n")
+        for child in children:
+            if child['container'] is None:
+                continue
+            f.write(f"{indent}  - class: {child['name']}\n")
+            f.write(f"{indent}    container: {child['container']}\n")
+            if child['type'] is not None:
+                f.write(f"{indent}    type: {child['type']}\n")
+            if child['id'] is not None:
+                f.write(f"{indent}    id: {child['id']}\n")
+            if child['parent'] is not None:
+                f.write(f"{indent}    parent: {child['parent']}\n")
+            write_children(f, child['name'], indent + "    ")
+
+    with open(os.path.join(obj_dir, "layer.yaml"), 'w') as f:
+        f.write("# generated by scripts/parse.py from layer.xml and the params files\n")
+        f.write(f"cpu: {cpuname}\n")
+        f.write("params:\n")
+        for cls in classes_info:
+            attrs = [(attr, value) for attr, value in cls['attributes'].items()
+                     if attr != 'cxx_header' and type(value) in (int, float, bool, str)]
+            if not attrs:
+                continue
+            f.write(f"  {cls['name']}:\n")
+            for attr, value in attrs:
+                f.write(f"    {attr}: {yaml_value(value)}\n")
+        f.write("layer:\n")
+        for root in [cpuname, "CacheManager"]:
+            f.write(f"  {root}:\n")
+            write_children(f, root, "    ")
+
+
 def main():
     args = argparse.ArgumentParser()
     args.add_argument("--filepath", type=str, default="")
+    args.add_argument("--dynamic-top", action="store_true",
+                      help="SimTop calls every component through virtual functions")
+    args.add_argument("--runtime", action="store_true",
+                      help="load() builds the component tree from the runtime layer, see inc/common/layer.h")
     args = args.parse_args()
     current_dir = args.filepath
     obj_dir = os.path.join(current_dir, "obj")
@@ -205,12 +368,24 @@ def main():
     for cls in classes_info:
         get_inherited_attributes(cls['name'])
     
+    # 类及其父类，子类在前，用于查找运行时参数 Class.name
+    def get_class_chain(class_name):
+        chain = [class_name]
+        if class_name in class_map:
+            for base in class_map[class_name]['bases']:
+                for name in get_class_chain(base):
+                    if name not in chain:
+                        chain.append(name)
+        return chain
+
     for cls in classes_info:
         name_no_ext = cls['name']
         file_h = os.path.join(obj_dir, "params_" + name_no_ext + ".h")
+        class_chain = ", ".join(f"\"{name}\"" for name in get_class_chain(cls['name']))
         with open(file_h, 'w') as f:
             f.write(f"#ifndef PARAMS_{name_no_ext.upper()}_H\n")
             f.write(f"#define PARAMS_{name_no_ext.upper()}_H\n\n")
+            f.write("#include \"common/params.h\"\n\n")
             cls_attr = all_attributes[cls['name']]
             for attr, value in cls_attr.items():
                 if attr == 'cxx_header':
@@ -234,6 +409,8 @@ def main():
                     f.write(f"    {attr} = {{ {', '.join([str(val) for val in value])} }};\\\n")
                 else:
                     f.write(f"    {attr} = {cls['name']}_{attr};\\\n")
+                    # 配置文件中的 Class.name=value 覆盖生成的默认值
+                    f.write(f"    Params::apply({attr}, \"{attr}\", {{{class_chain}}});\\\n")
             f.write("\n")
             f.write(f"#endif // PARAMS_{name_no_ext.upper()}_H\n")
 
@@ -242,6 +419,9 @@ def main():
         f.write(f"#ifndef PARAMS_EMU_H\n")
         f.write(f"#define PARAMS_EMU_H\n\n")
         f.write(f"static constexpr std::string CPU_NAME = \"{cpuname}\";\n")
+        f.write(f"static constexpr bool RUNTIME_LAYER = {str(args.runtime).lower()};\n")
+        layer_path = os.path.join(obj_dir, "layer.yaml").replace(os.path.sep, '/') if args.runtime else ""
+        f.write(f"static constexpr const char* LAYER_PATH = \"{layer_path}\";\n")
         f.write(f"#endif // PARAMS_EMU_H\n")
     current_dir = os.path.dirname(os.path.abspath(__file__))
     project_dir = os.path.dirname(current_dir)
@@ -261,6 +441,9 @@ def main():
     name_header_map = {}
     for cls in classes_info:
         name_header_map[cls['name']] = cls['attributes']['cxx_header']
+    # 运行时组件树的类型在编译时未知, SimTop 只能使用虚函数
+    write_sim_top(obj_dir, layers, name_header_map, args.dynamic_top or args.runtime)
+    write_layer_yaml(obj_dir, layers, classes_info)
     
     for cls in classes_info:
         name_no_ext = cls['name']
@@ -271,6 +454,9 @@ def main():
         with open(file_cpp, 'w') as f:
             f.write(f"#include \"{cls['attributes']['cxx_header']}\"\n")
             f.write(f"#include \"params_{name_no_ext}.h\"\n")
+            if args.runtime:
+                write_runtime_load(f, name_no_ext, layers.pop(name_no_ext, []))
+                continue
             if name_no_ext in layers:
                 for child in layers[name_no_ext]:
                     if child['name'] in name_header_map:
@@ -278,6 +464,8 @@ def main():
             f.write(f"void {cls['name']}::load() {{\n")
             f.write(f"    {cls['name']}_SET_PARAMS\n")
             if name_no_ext in layers:
+                # 子组件来自 layer.xml, 不能使用当前节点的参数
+                f.write("    Layer::leaveNode();\n")
                 i = 0
                 for child in layers[name_no_ext]:
                     if child['container'] is not None:
@@ -312,10 +500,14 @@ def main():
         with open(file_cpp, 'w') as f:
             f.write(f"#include \"{header_path}\"\n")
             f.write(f"#include \"params_{key}.h\"\n")
+            if args.runtime:
+                write_runtime_load(f, key, value, False)
+                continue
             for child in value:
                 if child['name'] in name_header_map:
                     f.write(f"#include \"{name_header_map[child['name']]}\"\n")
             f.write(f"void {key}::load() {{\n")
+            f.write("    Layer::leaveNode();\n")
             i = 0
             for child in value:
                 if child['container'] is not None:
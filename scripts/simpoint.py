@@ -0,0 +1,301 @@
+"""SimPoint style sampled simulation.
+
+cluster: pick representative intervals from the basic block vectors written
+         by the simulator (bbv_interval=N in the config).
+run:     simulate every representative interval in detail, using
+         fastforward_inst/warmup_inst to reach it, and merge the stat.log of
+         each run into weighted whole-program numbers.
+
+Example:
+    python3 scripts/simpoint.py cluster logs/atomic/latest/simpoint.bb -o out/app
+    python3 scripts/simpoint.py run --sim build/sim --config configs/pipeline/config \\
+        --simpoints out/app.simpoints --weights out/app.weights --interval 10000000 -o out/app
+"""
+import argparse
+import math
+import os
+import random
+import subprocess
+from concurrent.futures import ThreadPoolExecutor
+
+
+def read_bbv(path):
+    vectors = []
+    sizes = []
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith('T'):
+                continue
+            vector = {}
+            for item in line[1:].split():
+                _, bb, count = item.split(':')
+                vector[int(bb)] = int(count)
+            vectors.append(vector)
+            sizes.append(sum(vector.values()))
+    return vectors, sizes
+
+
+def project(vectors, sizes, dim, seed):
+    # random projection of the normalized vectors, as SimPoint does
+    rng = random.Random(seed)
+    matrix = {}
+    points = []
+    for vector, size in zip(vectors, sizes):
+        point = [0.0] * dim
+        for bb, count in vector.items():
+            if bb not in matrix:
+                matrix[bb] = [rng.uniform(-1, 1) for _ in range(dim)]
+            row = matrix[bb]
+            freq = count / size
+            for i in range(dim):
+                point[i] += freq * row[i]
+        points.append(point)
+    return points
+
+
+def dist2(a, b):
+    return sum((x - y) * (x - y) for x, y in zip(a, b))
+
+
+def kmeans(points, k, rng, iters=100):
+    # k-means++ initialization
+    centers = [list(rng.choice(points))]
+    while len(centers) < k:
+        d = [min(dist2(p, c) for c in centers) for p in points]
+        total = sum(d)
+        if total == 0:
+            centers.append(list(rng.choice(points)))
+            continue
+        r = rng.uniform(0, total)
+        acc = 0
+        for p, w in zip(points, d):
+            acc += w
+            if acc >= r:
+                centers.append(list(p))
+                break
+    labels = [0] * len(points)
+    for _ in range(iters):
+        changed = False
+        for i, p in enumerate(points):
+            label = min(range(k), key=lambda c: dist2(p, centers[c]))
+            if label != labels[i]:
+                labels[i] = label
+                changed = True
+        dim = len(points[0])
+        sums = [[0.0] * dim for _ in range(k)]
+        nums = [0] * k
+        for p, label in zip(points, labels):
+            nums[label] += 1
+            for j in range(dim):
+                sums[label][j] += p[j]
+        for c in range(k):
+            if nums[c] != 0:
+                centers[c] = [x / nums[c] for x in sums[c]]
+        if not changed:
+            break
+    return centers, labels
+
+
+def bic(points, centers, labels):
+    # Pelleg and Moore, X-means, spherical gaussian clusters
+    r = len(points)
+    k = len(centers)
+    d = len(points[0])
+    if r <= k:
+        return float('-inf')
+    distortion = sum(dist2(p, centers[l]) for p, l in zip(points, labels))
+    variance = max(distortion / (r - k), 1e-12)
+    likelihood = 0.0
+    for c in range(k):
+        rn = labels.count(c)
+        if rn == 0:
+            continue
+        likelihood += (rn * math.log(rn) - rn * math.log(r)
+                       - rn * d / 2 * math.log(2 * math.pi * variance)
+                       - (rn - 1) * d / 2)
+    params = (k - 1) + k * d + 1
+    return likelihood - params / 2 * math.log(r)
+
+
+def cluster(args):
+    vectors, sizes = read_bbv(args.bbv)
+    if not vectors:
+        raise SystemExit(f"{args.bbv} has no interval")
+    points = project(vectors, sizes, args.dim, args.seed)
+    rng = random.Random(args.seed)
+    results = []
+    for k in range(1, min(args.maxk, len(points)) + 1):
+        best = None
+        for _ in range(args.init):
+            centers, labels = kmeans(points, k, rng)
+            distortion = sum(dist2(p, centers[l]) for p, l in zip(points, labels))
+            if best is None or distortion < best[0]:
+                best = (distortion, centers, labels)
+        results.append((bic(points, best[1], best[2]), best[1], best[2]))
+
+    # smallest k whose bic reaches the threshold of the bic range
+    scores = [r[0] for r in results if r[0] != float('-inf')]
+    low, high = (min(scores), max(scores)) if scores else (0, 0)
+    chosen = results[-1]
+    for r in results:
+        if r[0] != float('-inf') and r[0] >= low + args.threshold * (high - low):
+            chosen = r
+            break
+    _, centers, labels = chosen
+
+    total = sum(sizes)
+    simpoints = []
+    for c in range(len(centers)):
+        members = [i for i, l in enumerate(labels) if l == c]
+        if not members:
+            continue
+        rep = min(members, key=lambda i: dist2(points[i], centers[c]))
+        weight = sum(sizes[i] for i in members) / total
+        simpoints.append((rep, weight))
+    simpoints.sort()
+
+    os.makedirs(os.path.dirname(os.path.abspath(args.output)), exist_ok=True)
+    with open(args.output + ".simpoints", 'w') as f:
+        for c, (rep, _) in enumerate(simpoints):
+            f.write(f"{rep} {c}\n")
+    with open(args.output + ".weights", 'w') as f:
+        for c, (_, weight) in enumerate(simpoints):
+            f.write(f"{weight:.8f} {c}\n")
+    print(f"{len(vectors)} intervals, {len(simpoints)} simpoints")
+
+
+def read_config(path):
+    lines = []
+    with open(path) as f:
+        for line in f:
+            if '=' in line:
+                key, value = line.split('=', 1)
+                lines.append((key.strip(), value.strip()))
+    return lines
+
+
+def read_stats(path):
+    stats = {}
+    with open(path) as f:
+        for line in f:
+            fields = line.split('#', 1)[0].split()
+            if len(fields) != 2:
+                continue
+            try:
+                stats[fields[0]] = int(fields[1])
+            except ValueError:
+                try:
+                    stats[fields[0]] = float(fields[1])
+                except ValueError:
+                    pass
+    return stats
+
+
+def run_simpoint(args, base, idx):
+    start = idx * args.interval
+    warmup = min(args.warmup, start)
+    log_path = os.path.abspath(os.path.join(args.output, f"sp{idx}"))
+    overrides = {
+        'log_path': log_path,
+        'fastforward_inst': str(start),
+        'warmup_inst': str(warmup),
+        'inst_count': str(start + args.interval),
+        'end_tick': str((1 << 64) - 1),
+        'bbv_interval': '0',
+    }
+    skip = set(overrides) | {'checkpoint_tick', 'checkpoint_inst', 'restore_path'}
+    cfg = os.path.join(args.output, f"sp{idx}.cfg")
+    with open(cfg, 'w') as f:
+        for key, value in base:
+            if key not in skip:
+                f.write(f"{key}={value}\n")
+        for key, value in overrides.items():
+            f.write(f"{key}={value}\n")
+    with open(os.path.join(args.output, f"sp{idx}.out"), 'w') as out:
+        ret = subprocess.run([args.sim, cfg], stdout=out, stderr=subprocess.STDOUT).returncode
+    stat_path = os.path.join(log_path, "latest", "stat.log")
+    if ret != 0 or not os.path.exists(stat_path):
+        print(f"simpoint {idx} failed with code {ret}, see sp{idx}.out")
+        return None
+    stats = read_stats(stat_path)
+    # only the detailed cpus count instructions in stat.log
+    stats.setdefault('inst_count', args.interval)
+    return stats
+
+
+def run(args):
+    os.makedirs(args.output, exist_ok=True)
+    base = read_config(args.config)
+    with open(args.simpoints) as f:
+        intervals = {int(c): int(i) for i, c in (line.split() for line in f if line.strip())}
+    with open(args.weights) as f:
+        weights = {int(c): float(w) for w, c in (line.split() for line in f if line.strip())}
+
+    clusters = sorted(intervals)
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        results = list(pool.map(lambda c: run_simpoint(args, base, intervals[c]), clusters))
+
+    done = [(weights[c], stats) for c, stats in zip(clusters, results)
+            if stats is not None and stats.get('inst_count', 0) > 0]
+    if not done:
+        raise SystemExit("no simpoint finished")
+    total_weight = sum(w for w, _ in done)
+    if total_weight < 0.999:
+        print(f"only {total_weight:.4f} of the weight finished, results are renormalized")
+
+    # counters are merged per kilo instruction, ratios as weighted means
+    merged = {}
+    for weight, stats in done:
+        w = weight / total_weight
+        inst = stats['inst_count']
+        merged['cpi'] = merged.get('cpi', 0.0) + w * stats['tick'] / inst
+        for name, value in stats.items():
+            if name in ('tick', 'inst_count'):
+                continue
+            if isinstance(value, int):
+                key = name + "PKI"
+                merged[key] = merged.get(key, 0.0) + w * value * 1000 / inst
+            else:
+                merged[name] = merged.get(name, 0.0) + w * value
+    merged['ipc'] = 1 / merged['cpi'] if merged['cpi'] != 0 else 0.0
+
+    with open(os.path.join(args.output, "stat.log"), 'w') as f:
+        for name in ['cpi', 'ipc'] + sorted(k for k in merged if k not in ('cpi', 'ipc')):
+            f.write(f"{name:<24} {merged[name]:>14.6f}\n")
+    print(f"cpi {merged['cpi']:.6f} over {len(done)} simpoints, weighted stats in "
+          f"{os.path.join(args.output, 'stat.log')}")
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    c = sub.add_parser("cluster", help="pick simpoints from a .bb file")
+    c.add_argument("bbv", type=str)
+    c.add_argument("-o", "--output", type=str, required=True, help="output prefix")
+    c.add_argument("--maxk", type=int, default=10)
+    c.add_argument("--dim", type=int, default=15, help="random projection dimension")
+    c.add_argument("--init", type=int, default=5, help="k-means runs per k")
+    c.add_argument("--threshold", type=float, default=0.9, help="bic threshold")
+    c.add_argument("--seed", type=int, default=1)
+
+    r = sub.add_parser("run", help="simulate simpoints in detail and merge stats")
+    r.add_argument("--sim", type=str, required=True, help="simulator built with the detailed cpu")
+    r.add_argument("--config", type=str, required=True)
+    r.add_argument("--simpoints", type=str, required=True)
+    r.add_argument("--weights", type=str, required=True)
+    r.add_argument("--interval", type=int, required=True, help="bbv_interval used for profiling")
+    r.add_argument("--warmup", type=int, default=0, help="warmup_inst before each simpoint")
+    r.add_argument("-o", "--output", type=str, required=True)
+    r.add_argument("-j", "--jobs", type=int, default=os.cpu_count())
+
+    args = parser.parse_args()
+    if args.cmd == "cluster":
+        cluster(args)
+    else:
+        run(args)
+
+
+if __name__ == "__main__":
+    main()
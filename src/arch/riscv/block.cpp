@@ -0,0 +1,258 @@
+#include "arch/riscv/riscvarch.h"
+#include "arch/riscv/trans.h"
+namespace cds::arch::riscv {
+
+void RiscvArch::buildBlock(Block* block, uint64_t paddr) {
+    block->paddr = paddr;
+    block->partial = false;
+    block->chain[0] = nullptr;
+    block->chain[1] = nullptr;
+    block->ops.clear();
+    block->exec_count = 0;
+    block->compiled = false;
+    block->native = nullptr;
+    uint64_t page_end = (paddr & ~TLB_PGMASK) + (1ULL << TLB_PGSHFT);
+    uint64_t op_paddr = paddr;
+    block_build++;
+    while (block->ops.size() < BLOCK_MAX_OPS) {
+        // ops are taken from the decode cache, instructions not decoded yet
+        // run on the generic path first and the block is built again
+        DecodeCacheEntry* entry = &decode_cache[(op_paddr >> 1) & DECODE_CACHE_MASK];
+        if (entry->paddr != op_paddr) {
+            block->partial = true;
+            break;
+        }
+        BlockOpKind kind = blockOpKind(entry->trans);
+        if (kind == BLOCK_OP_NONE || op_paddr + entry->inst_size > page_end) {
+            break;
+        }
+        BlockOp& op = block->ops.emplace_back();
+        op.trans = entry->trans;
+        op.kind = kind;
+        op.inst_size = entry->inst_size;
+        memcpy(op.args, entry->args, DECODE_CACHE_ARGS);
+        op_paddr += entry->inst_size;
+        if (kind == BLOCK_OP_BRANCH || kind == BLOCK_OP_JUMP) {
+            block->size = op_paddr - paddr;
+            return;
+        }
+    }
+    block->size = op_paddr - paddr;
+    BlockOp& end = block->ops.emplace_back();
+    end.trans = nullptr;
+    end.kind = BLOCK_OP_END;
+    end.inst_size = 0;
+}
+
+void RiscvArch::flushBlocks(uint64_t page_base) {
+    // blocks of one page occupy a contiguous window of the block cache
+    uint32_t idx = (page_base >> 1) & BLOCK_CACHE_MASK;
+    for (uint32_t i = 0; i < (1 << (TLB_PGSHFT - 1)); i++) {
+        if ((blocks[idx + i].paddr & ~TLB_PGMASK) == page_base) {
+            blocks[idx + i].paddr = -1;
+        }
+    }
+    block_epoch++;
+}
+
+void RiscvArch::compileBlock(Block* block) {
+    block->compiled = true;
+    if (!JitCompiler::supported()) {
+        return;
+    }
+    if (jit == nullptr) {
+        jit = new JitCompiler(tlb, code_pages);
+    }
+    // compile up to the first op the jit can not handle, the rest is interpreted
+    std::vector<JitInst> insts;
+    for (BlockOp& op : block->ops) {
+        JitInst inst;
+        if (op.kind == BLOCK_OP_END || !jitInst(op.trans, op.args, inst)) {
+            break;
+        }
+        inst.size = op.inst_size;
+        insts.push_back(inst);
+    }
+    uint32_t count;
+    block->native = jit->compile(insts, count);
+    if (block->native == nullptr && count != 0) {
+        // the code buffer is full, drop all compiled blocks
+        jit->reset();
+        for (uint32_t i = 0; i < BLOCK_CACHE_SIZE; i++) {
+            blocks[i].exec_count = 0;
+            blocks[i].compiled = false;
+            blocks[i].native = nullptr;
+        }
+        block->compiled = true;
+        block->native = jit->compile(insts, count);
+    }
+    if (block->native != nullptr) {
+        jit_block++;
+    }
+}
+
+uint64_t RiscvArch::run(uint64_t& pc, uint64_t n, int jit_threshold) {
+#if defined(LOG_PC) || defined(LOG_INST) || defined(DIFFTEST)
+    return 0;
+#else
+    static const void* const handlers[] = {
+        nullptr, &&op_reg, &&op_load, &&op_store, &&op_branch, &&op_jump, &&op_end
+    };
+    // blocks hold no csr or system instruction, so mip, mie, mstatus and
+    // priv only change after a device access, which ends the run
+    if (unlikely(inst_pending || pendingIrqs() != 0)) {
+        return 0;
+    }
+    DecodeInfo* info = &block_info;
+    env->info = info;
+    uint64_t count = 0;
+    uint64_t epoch = block_epoch;
+    uint64_t next_pc = pc;
+    uint64_t page_vaddr = -1;
+    uint64_t page_paddr = 0;
+    Block* block = nullptr;
+    Block* next;
+    BlockOp* op;
+    int exit = 0;
+    uint64_t paddr;
+    TLBEntry* entry;
+
+#define DISPATCH() do { \
+    if (unlikely(count == n)) goto out; \
+    env->pc = pc; \
+    info->inst_size = op->inst_size; \
+    info->exception = EXC_NONE; \
+    goto *op->handler; \
+} while (0)
+
+#define COMMIT() do { \
+    pc += op->inst_size; \
+    count++; \
+    (*tick)++; \
+    (*instret)++; \
+} while (0)
+
+#define WRITE_DST0() do { \
+    *(uint64_t*)((uint8_t*)state + info->dst_idx[0]) = info->dst_data[0]; \
+    state->gpr[0] = 0; \
+} while (0)
+
+next_block:
+    pc = next_pc;
+    if (unlikely(count == n)) {
+        goto out;
+    }
+    // stay in the page of the last block without a tlb lookup
+    if ((pc & ~TLB_PGMASK) != page_vaddr) {
+        entry = &tlb->itlb[(pc >> TLB_PGSHFT) & TLB_MASK];
+        if (unlikely(!tlb_hit(tlb, entry, entry->tag_read, pc))) {
+            goto out;
+        }
+        page_vaddr = pc & ~TLB_PGMASK;
+        page_paddr = entry->paddr;
+    }
+    paddr = page_paddr | (pc & TLB_PGMASK);
+    next = block != nullptr ? block->chain[exit] : nullptr;
+    if (next == nullptr || next->paddr != paddr || next->partial) {
+        next = &blocks[(paddr >> 1) & BLOCK_CACHE_MASK];
+        if (next->paddr != paddr || next->partial) {
+            buildBlock(next, paddr);
+            for (BlockOp& block_op : next->ops) {
+                block_op.handler = handlers[block_op.kind];
+            }
+        }
+        if (block != nullptr) {
+            block->chain[exit] = next;
+        }
+    }
+    block = next;
+    op = block->ops.data();
+    if (jit_threshold != 0 && !block->compiled && ++block->exec_count >= (uint32_t)jit_threshold) {
+        compileBlock(block);
+    }
+    if (block->native != nullptr && n - count >= block->ops.size()) {
+        uint64_t executed;
+        next_pc = block->native(state, pc, &executed);
+        count += executed;
+        (*tick) += executed;
+        (*instret) += executed;
+        jit_inst += executed;
+        if (executed == block->ops.size()) {
+            // the branch or jump ending the block ran
+            exit = next_pc == pc + block->size ? 1 : 0;
+            goto next_block;
+        }
+        pc = next_pc;
+        op += executed;
+    }
+    DISPATCH();
+
+op_reg:
+    op->trans(env, op->args);
+    WRITE_DST0();
+    COMMIT();
+    op++;
+    DISPATCH();
+
+op_load:
+    op->trans(env, op->args);
+    if (unlikely(info->exception != EXC_NONE)) {
+        goto out;
+    }
+    WRITE_DST0();
+    COMMIT();
+    if (unlikely(!memory->lagging())) {
+        goto out;
+    }
+    op++;
+    DISPATCH();
+
+op_store:
+    op->trans(env, op->args);
+    if (unlikely(info->exception != EXC_NONE)) {
+        goto out;
+    }
+    paddrWrite(info->dst_data[2], info->dst_idx[2], FETCH_TYPE::SFETCH, (uint8_t*)&info->dst_data[1]);
+    COMMIT();
+    // the store hit code and the blocks may be stale
+    if (unlikely(!memory->lagging() || block_epoch != epoch)) {
+        goto out;
+    }
+    op++;
+    DISPATCH();
+
+op_branch:
+    op->trans(env, op->args);
+    exit = info->dst_data[1] ? 0 : 1;
+    next_pc = info->dst_data[1] ? info->dst_data[2] : pc + op->inst_size;
+    COMMIT();
+    goto next_block;
+
+op_jump:
+    op->trans(env, op->args);
+    WRITE_DST0();
+    exit = 0;
+    next_pc = info->dst_data[2];
+    COMMIT();
+    goto next_block;
+
+op_end:
+    // the next instruction can not run in a block
+    if (op == block->ops.data()) {
+        goto out;
+    }
+    exit = 1;
+    next_pc = pc;
+    goto next_block;
+
+#undef DISPATCH
+#undef COMMIT
+#undef WRITE_DST0
+
+out:
+    block_inst += count;
+    return count;
+#endif
+}
+
+} // namespace cds::arch::riscv
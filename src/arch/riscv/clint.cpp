@@ -1,6 +1,7 @@
 #include "arch/riscv/clint.h"
 #include "arch/riscv/archstate.h"
 #include "device/irqhandler.h"
+#include "common/checkpoint.h"
 
 #define MSIP_OFFSET 0x0000
 #define MTIME_OFFSET 0xbff8
@@ -27,6 +28,21 @@ void Clint::tick() {
     }
 }
 
+uint64_t Clint::nextTick() {
+    if (req != nullptr) {
+        return getTick();
+    }
+    if (mtime < mtimecmp) {
+        // the tick that makes mtime reach mtimecmp raises the irq
+        return irqValid ? getTick() : getTick() + mtimecmp - mtime - 1;
+    }
+    return irqValid ? -1 : getTick();
+}
+
+void Clint::skip(uint64_t ticks) {
+    mtime += ticks;
+}
+
 bool Clint::addRequest(DeviceReq* req) {
     if (this->req != nullptr) {
         return false;
@@ -48,6 +64,11 @@ bool Clint::inRange(uint64_t addr) {
     return addr >= base_addr && addr < end_addr;
 }
 
+void Clint::getRange(uint64_t& start, uint64_t& end) {
+    start = base_addr;
+    end = end_addr;
+}
+
 void Clint::read(uint64_t addr, int size, uint8_t* data) {
     uint64_t offset = addr - base_addr;
     if (offset == MSIP_OFFSET) {
@@ -70,3 +91,17 @@ void Clint::write(uint64_t addr, int size, uint8_t* data) {
         mtimecmp = *(uint64_t*)data;
     }
 }
+
+void Clint::save(Checkpoint* cp) {
+    cp->write(msip);
+    cp->write(mtime);
+    cp->write(mtimecmp);
+    cp->write(irqValid);
+}
+
+void Clint::restore(Checkpoint* cp) {
+    cp->read(msip);
+    cp->read(mtime);
+    cp->read(mtimecmp);
+    cp->read(irqValid);
+}
@@ -1,9 +1,17 @@
 #include "common/common.h"
 #include "arch/riscv/trans.h"
 #include "arch/riscv/csrdefines.h"
+#include "arch/riscv/hostfp.h"
+#include "arch/riscv/crypto.h"
 #include "common/log.h"
 #include <stdio.h>
 #include <bit>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 namespace cds::arch::riscv {
 
@@ -31,8 +39,13 @@ EX_SH(12)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
 #endif
-static inline void cpu_put_ic(ArchEnv *env, bool (*trans_func)(void*, void*), void* arg, uint32_t insn) {
-
+template <typename T>
+static inline void cpu_put_ic(ArchEnv *env, bool (*trans_func)(void*, void*), T* arg, uint32_t insn) {
+    static_assert(sizeof(T) <= DECODE_CACHE_ARGS, "decode cache args too small");
+    if (env->ic != nullptr) {
+        env->ic->trans = trans_func;
+        memcpy(env->ic->args, arg, sizeof(T));
+    }
 }
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic pop
@@ -133,36 +146,58 @@ static uint64_t gen_pc_plus_diff(DisasContext* ctx, uint64_t diff) {
     return ctx->pc + diff;
 }
 
-static int8_t ld_b(DisasContext* ctx, uint64_t va) {
-    uint64_t ha;
-    uint64_t exception = EXC_NONE;
-    ctx->arch->translateAddr(va, FETCH_TYPE::LFETCH, ha, exception);
-    if (unlikely(ctx->arch->exceptionValid(exception))) {
-        ctx->info->exception = EXC_LPF;
-        return 0;
+// tlb hit on a ram page reads guest memory through the host pointer,
+// otherwise fall back to translateAddr, which walks and refills the tlb
+template <typename T>
+static inline T ld_mem(DisasContext* ctx, uint64_t va) {
+    T data;
+    TLBEntry* entry = &ctx->tlb->dtlb[(va >> TLB_PGSHFT) & TLB_MASK];
+    if (likely(tlb_hit(ctx->tlb, entry, entry->tag_read, va) && entry->host != nullptr)) {
+        memcpy(&data, entry->host + (va & TLB_PGMASK), sizeof(T));
+    } else {
+        uint64_t ha;
+        uint64_t exception = EXC_NONE;
+        ctx->arch->translateAddr(va, FETCH_TYPE::LFETCH, ha, exception);
+        if (unlikely(ctx->arch->exceptionValid(exception))) {
+            ctx->info->exception = EXC_LPF;
+            return 0;
+        }
+        ctx->arch->paddrRead(ha, sizeof(T), FETCH_TYPE::LFETCH, (uint8_t*)&data);
     }
-    uint8_t data;
-    ctx->arch->paddrRead(ha, 1, FETCH_TYPE::LFETCH, &data);
-    ctx->info->dst_idx[2] = 1;
+    ctx->info->dst_idx[2] = sizeof(T);
     return data;
 }
 
+// stores are committed in updateEnv, only the physical address is recorded here
+template <typename T>
+static inline bool st_mem(DisasContext* ctx, uint64_t va) {
+    uint64_t ha;
+    TLBEntry* entry = &ctx->tlb->dtlb[(va >> TLB_PGSHFT) & TLB_MASK];
+    if (likely(tlb_hit(ctx->tlb, entry, entry->tag_write, va))) {
+        ha = entry->paddr | (va & TLB_PGMASK);
+    } else {
+        uint64_t exception = EXC_NONE;
+        ctx->arch->translateAddr(va, FETCH_TYPE::SFETCH, ha, exception);
+        if (unlikely(ctx->arch->exceptionValid(exception))) {
+            ctx->info->exception = EXC_SPF;
+            return false;
+        }
+    }
+    ctx->info->dst_idx[2] = sizeof(T);
+    ctx->info->dst_data[2] = ha;
+    return true;
+}
+
+static int8_t ld_b(DisasContext* ctx, uint64_t va) {
+    return ld_mem<uint8_t>(ctx, va);
+}
+
 static int16_t ld_h(DisasContext* ctx, uint64_t va) {
     if (unlikely(va & 0x1)) {
         ctx->info->exception = EXC_LAM;
         return 0;
     }
-    uint64_t ha;
-    uint64_t exception = EXC_NONE;
-    ctx->arch->translateAddr(va, FETCH_TYPE::LFETCH, ha, exception);
-    if (unlikely(ctx->arch->exceptionValid(exception))) {
-        ctx->info->exception = EXC_LPF;
-        return 0;
-    }
-    uint16_t data;
-    ctx->arch->paddrRead(ha, 2, FETCH_TYPE::LFETCH, (uint8_t*)&data);
-    ctx->info->dst_idx[2] = 2;
-    return data;
+    return ld_mem<uint16_t>(ctx, va);
 }
 
 static int32_t ld_w(DisasContext* ctx, uint64_t va) {
@@ -170,17 +205,7 @@ static int32_t ld_w(DisasContext* ctx, uint64_t va) {
         ctx->info->exception = EXC_LAM;
         return 0;
     }
-    uint64_t ha;
-    uint64_t exception = EXC_NONE;
-    ctx->arch->translateAddr(va, FETCH_TYPE::LFETCH, ha, exception);
-    if (unlikely(ctx->arch->exceptionValid(exception))) {
-        ctx->info->exception = EXC_LPF;
-        return 0;
-    }
-    uint32_t data;
-    ctx->arch->paddrRead(ha, 4, FETCH_TYPE::LFETCH, (uint8_t*)&data);
-    ctx->info->dst_idx[2] = 4;
-    return data;
+    return ld_mem<uint32_t>(ctx, va);
 }
 
 static int64_t ld_d(DisasContext* ctx, uint64_t va) {
@@ -188,30 +213,11 @@ static int64_t ld_d(DisasContext* ctx, uint64_t va) {
         ctx->info->exception = EXC_LAM;
         return 0;
     }
-    uint64_t ha;
-    uint64_t exception = EXC_NONE;
-    ctx->arch->translateAddr(va, FETCH_TYPE::LFETCH, ha, exception);
-    if (unlikely(ctx->arch->exceptionValid(exception))) {
-        ctx->info->exception = EXC_LPF;
-        return 0;
-    }
-    uint64_t data;
-    ctx->arch->paddrRead(ha, 8, FETCH_TYPE::LFETCH, (uint8_t*)&data);
-    ctx->info->dst_idx[2] = 8;
-    return data;
+    return ld_mem<uint64_t>(ctx, va);
 }
 
 static bool st_b(DisasContext* ctx, uint64_t va, int8_t data) {
-    uint64_t ha;
-    uint64_t exception = EXC_NONE;
-    ctx->arch->translateAddr(va, FETCH_TYPE::SFETCH, ha, exception);
-    if (unlikely(ctx->arch->exceptionValid(exception))) {
-        ctx->info->exception = EXC_SPF;
-        return false;
-    }
-    ctx->info->dst_idx[2] = 1;
-    ctx->info->dst_data[2] = ha;
-    return true;
+    return st_mem<uint8_t>(ctx, va);
 }
 
 static bool st_h(DisasContext* ctx, uint64_t va, int16_t data) {
@@ -219,16 +225,7 @@ static bool st_h(DisasContext* ctx, uint64_t va, int16_t data) {
         ctx->info->exception = EXC_SAM;
         return false;
     }
-    uint64_t ha;
-    uint64_t exception = EXC_NONE;
-    ctx->arch->translateAddr(va, FETCH_TYPE::SFETCH, ha, exception);
-    if (unlikely(ctx->arch->exceptionValid(exception))) {
-        ctx->info->exception = EXC_SPF;
-        return false;
-    }
-    ctx->info->dst_idx[2] = 2;
-    ctx->info->dst_data[2] = ha;
-    return true;
+    return st_mem<uint16_t>(ctx, va);
 }
 
 static bool st_w(DisasContext* ctx, uint64_t va, int32_t data) {
@@ -236,16 +233,7 @@ static bool st_w(DisasContext* ctx, uint64_t va, int32_t data) {
         ctx->info->exception = EXC_SAM;
         return false;
     }
-    uint64_t ha;
-    uint64_t exception = EXC_NONE;
-    ctx->arch->translateAddr(va, FETCH_TYPE::SFETCH, ha, exception);
-    if (unlikely(ctx->arch->exceptionValid(exception))) {
-        ctx->info->exception = EXC_SPF;
-        return false;
-    }
-    ctx->info->dst_idx[2] = 4;
-    ctx->info->dst_data[2] = ha;
-    return true;
+    return st_mem<uint32_t>(ctx, va);
 }
 
 static bool st_d(DisasContext* ctx, uint64_t va, int64_t data) {
@@ -253,16 +241,7 @@ static bool st_d(DisasContext* ctx, uint64_t va, int64_t data) {
         ctx->info->exception = EXC_SAM;
         return false;
     }
-    uint64_t ha;
-    uint64_t exception = EXC_NONE;
-    ctx->arch->translateAddr(va, FETCH_TYPE::SFETCH, ha, exception);
-    if (unlikely(ctx->arch->exceptionValid(exception))) {
-        ctx->info->exception = EXC_SPF;
-        return false;
-    }
-    ctx->info->dst_idx[2] = 8;
-    ctx->info->dst_data[2] = ha;
-    return true;
+    return st_mem<uint64_t>(ctx, va);
 }
 
 #define REQUIRE_FPU do { \
@@ -648,7 +627,7 @@ static bool trans_orc_b(DisasContext *ctx, arg_orc_b *a) {
 static bool trans_pack(DisasContext *ctx, arg_pack *a) {
     uint64_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
     uint64_t src2 = get_gpr_64(ctx, a->rs2, EXT_NONE);
-    uint64_t dest = ((src2 & 0xFFFF) << 16) | (src1 & 0xFFFF);
+    uint64_t dest = ((src2 & 0xFFFFFFFF) << 32) | (src1 & 0xFFFFFFFF);
     SET_GPR_64
     SET_SRC2_DST
     ctx->info->type = INT;
@@ -657,7 +636,7 @@ static bool trans_pack(DisasContext *ctx, arg_pack *a) {
 static bool trans_packh(DisasContext *ctx, arg_packh *a) {
     uint64_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
     uint64_t src2 = get_gpr_64(ctx, a->rs2, EXT_NONE);
-    uint64_t dest = (((src2 >> 8) & 0xFF) << 16) | ((src1 >> 8) & 0xFF);
+    uint64_t dest = ((src2 & 0xFF) << 8) | (src1 & 0xFF);
     SET_GPR_64
     SET_SRC2_DST
     ctx->info->type = INT;
@@ -666,8 +645,8 @@ static bool trans_packh(DisasContext *ctx, arg_packh *a) {
 static bool trans_packw(DisasContext *ctx, arg_packw *a) {
     uint64_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
     uint64_t src2 = get_gpr_64(ctx, a->rs2, EXT_NONE);
-    uint64_t dest = ((src2 & 0xFFFFFFFF) << 32) | (src1 & 0xFFFFFFFF);
-    SET_GPR_64
+    uint32_t dest = ((src2 & 0xFFFF) << 16) | (src1 & 0xFFFF);
+    SET_GPR_32
     SET_SRC2_DST
     ctx->info->type = INT;
     return true;
@@ -748,17 +727,231 @@ static bool trans_rorw(DisasContext *ctx, arg_rorw *a) {
 }
 
 //aes
-static bool trans_aes32dsi(DisasContext *ctx, arg_aes32dsi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_aes32dsmi(DisasContext *ctx, arg_aes32dsmi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_aes32esi(DisasContext *ctx, arg_aes32esi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_aes32esmi(DisasContext *ctx, arg_aes32esmi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_aes64ds(DisasContext *ctx, arg_aes64ds *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_aes64dsm(DisasContext *ctx, arg_aes64dsm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_aes64es(DisasContext *ctx, arg_aes64es *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_aes64esm(DisasContext *ctx, arg_aes64esm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_aes64im(DisasContext *ctx, arg_aes64im *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_aes64ks1i(DisasContext *ctx, arg_aes64ks1i *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_aes64ks2(DisasContext *ctx, arg_aes64ks2 *a) {__NOT_IMPLEMENTED_EXIT__}
+// aes-ni and pclmulqdq are not implied by -mavx2, check them at runtime
+#if defined(__x86_64__)
+static const bool host_aes = (__builtin_cpu_init(), __builtin_cpu_supports("aes"));
+static const bool host_pclmul = __builtin_cpu_supports("pclmul");
+
+__attribute__((target("aes")))
+static uint64_t aes64_round_host(uint64_t rs1, uint64_t rs2, bool enc, bool mix) {
+    __m128i state = _mm_set_epi64x(rs2, rs1);
+    __m128i zero = _mm_setzero_si128();
+    if (enc) {
+        state = mix ? _mm_aesenc_si128(state, zero) : _mm_aesenclast_si128(state, zero);
+    } else {
+        state = mix ? _mm_aesdec_si128(state, zero) : _mm_aesdeclast_si128(state, zero);
+    }
+    return _mm_cvtsi128_si64(state);
+}
+
+__attribute__((target("aes")))
+static uint64_t aes64_im_host(uint64_t rs1) {
+    return _mm_cvtsi128_si64(_mm_aesimc_si128(_mm_cvtsi64_si128(rs1)));
+}
+
+// every column holds word, so ShiftRows leaves the state alone
+__attribute__((target("aes")))
+static uint32_t aes_subword_host(uint32_t word) {
+    __m128i state = _mm_set1_epi32(word);
+    return _mm_cvtsi128_si32(_mm_aesenclast_si128(state, _mm_setzero_si128()));
+}
+
+__attribute__((target("pclmul")))
+static uint64_t clmul_host(uint64_t x, uint64_t y, uint64_t& hi) {
+    __m128i res = _mm_clmulepi64_si128(_mm_cvtsi64_si128(x), _mm_cvtsi64_si128(y), 0);
+    hi = _mm_extract_epi64(res, 1);
+    return _mm_cvtsi128_si64(res);
+}
+#endif
+
+static const uint8_t aes_sbox[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
+};
+
+static const uint8_t aes_inv_sbox[256] = {
+    0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
+    0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87, 0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
+    0x54, 0x7b, 0x94, 0x32, 0xa6, 0xc2, 0x23, 0x3d, 0xee, 0x4c, 0x95, 0x0b, 0x42, 0xfa, 0xc3, 0x4e,
+    0x08, 0x2e, 0xa1, 0x66, 0x28, 0xd9, 0x24, 0xb2, 0x76, 0x5b, 0xa2, 0x49, 0x6d, 0x8b, 0xd1, 0x25,
+    0x72, 0xf8, 0xf6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xd4, 0xa4, 0x5c, 0xcc, 0x5d, 0x65, 0xb6, 0x92,
+    0x6c, 0x70, 0x48, 0x50, 0xfd, 0xed, 0xb9, 0xda, 0x5e, 0x15, 0x46, 0x57, 0xa7, 0x8d, 0x9d, 0x84,
+    0x90, 0xd8, 0xab, 0x00, 0x8c, 0xbc, 0xd3, 0x0a, 0xf7, 0xe4, 0x58, 0x05, 0xb8, 0xb3, 0x45, 0x06,
+    0xd0, 0x2c, 0x1e, 0x8f, 0xca, 0x3f, 0x0f, 0x02, 0xc1, 0xaf, 0xbd, 0x03, 0x01, 0x13, 0x8a, 0x6b,
+    0x3a, 0x91, 0x11, 0x41, 0x4f, 0x67, 0xdc, 0xea, 0x97, 0xf2, 0xcf, 0xce, 0xf0, 0xb4, 0xe6, 0x73,
+    0x96, 0xac, 0x74, 0x22, 0xe7, 0xad, 0x35, 0x85, 0xe2, 0xf9, 0x37, 0xe8, 0x1c, 0x75, 0xdf, 0x6e,
+    0x47, 0xf1, 0x1a, 0x71, 0x1d, 0x29, 0xc5, 0x89, 0x6f, 0xb7, 0x62, 0x0e, 0xaa, 0x18, 0xbe, 0x1b,
+    0xfc, 0x56, 0x3e, 0x4b, 0xc6, 0xd2, 0x79, 0x20, 0x9a, 0xdb, 0xc0, 0xfe, 0x78, 0xcd, 0x5a, 0xf4,
+    0x1f, 0xdd, 0xa8, 0x33, 0x88, 0x07, 0xc7, 0x31, 0xb1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xec, 0x5f,
+    0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d, 0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
+    0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0, 0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
+    0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d
+};
+
+static inline uint8_t aes_xtime(uint8_t x) {
+    return (x << 1) ^ ((x & 0x80) ? 0x1b : 0);
+}
+
+static inline uint8_t aes_gfmul(uint8_t x, uint8_t y) {
+    uint8_t res = 0;
+    for (; y != 0; y >>= 1) {
+        if (y & 1) {
+            res ^= x;
+        }
+        x = aes_xtime(x);
+    }
+    return res;
+}
+
+static inline uint32_t aes_mixcolumn(uint32_t col, bool inv) {
+    uint8_t s[4], d[4];
+    memcpy(s, &col, 4);
+    for (int i = 0; i < 4; i++) {
+        if (inv) {
+            d[i] = aes_gfmul(s[i], 14) ^ aes_gfmul(s[(i + 1) & 3], 11) ^
+                   aes_gfmul(s[(i + 2) & 3], 13) ^ aes_gfmul(s[(i + 3) & 3], 9);
+        } else {
+            d[i] = aes_xtime(s[i]) ^ aes_xtime(s[(i + 1) & 3]) ^ s[(i + 1) & 3] ^
+                   s[(i + 2) & 3] ^ s[(i + 3) & 3];
+        }
+    }
+    memcpy(&col, d, 4);
+    return col;
+}
+
+static inline uint32_t aes_subword(uint32_t word) {
+#if defined(__x86_64__)
+    if (host_aes) {
+        return aes_subword_host(word);
+    }
+#endif
+    return aes_sbox[word & 0xff] | (aes_sbox[(word >> 8) & 0xff] << 8) |
+           (aes_sbox[(word >> 16) & 0xff] << 16) | ((uint32_t)aes_sbox[word >> 24] << 24);
+}
+
+/**
+ * @brief the low half of one aes round on the state {rs2, rs1}
+ *
+ * (inv)ShiftRows and (inv)SubBytes, then (inv)MixColumns if mix is set.
+ * aesenc/aesdec do the same steps, the round key is zero.
+ */
+static inline uint64_t aes64_round(uint64_t rs1, uint64_t rs2, bool enc, bool mix) {
+#if defined(__x86_64__)
+    if (host_aes) {
+        return aes64_round_host(rs1, rs2, enc, mix);
+    }
+#endif
+    uint8_t s[16], d[8];
+    memcpy(s, &rs1, 8);
+    memcpy(s + 8, &rs2, 8);
+    for (int c = 0; c < 2; c++) {
+        for (int r = 0; r < 4; r++) {
+            uint8_t x = s[((enc ? c + r : c - r + 4) & 3) * 4 + r];
+            d[c * 4 + r] = enc ? aes_sbox[x] : aes_inv_sbox[x];
+        }
+    }
+    uint32_t col[2];
+    memcpy(col, d, 8);
+    if (mix) {
+        col[0] = aes_mixcolumn(col[0], !enc);
+        col[1] = aes_mixcolumn(col[1], !enc);
+    }
+    uint64_t res;
+    memcpy(&res, col, 8);
+    return res;
+}
+
+#define GEN_AES64(name, enc, mix) \
+static bool trans_##name(DisasContext *ctx, arg_##name *a) { \
+    uint64_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE); \
+    uint64_t src2 = get_gpr_64(ctx, a->rs2, EXT_NONE); \
+    uint64_t dest = aes64_round(src1, src2, enc, mix); \
+    SET_GPR_64 \
+    SET_SRC2_DST \
+    ctx->info->type = AES; \
+    return true; \
+}
+
+GEN_AES64(aes64es, true, false)
+GEN_AES64(aes64esm, true, true)
+GEN_AES64(aes64ds, false, false)
+GEN_AES64(aes64dsm, false, true)
+
+// RV32 only encodings, reserved on rv64
+static inline bool gen_rv32_only(DisasContext *ctx) {
+    ctx->info->exception = EXC_II;
+    ctx->info->exc_data = ctx->info->inst;
+    return true;
+}
+
+static bool trans_aes32dsi(DisasContext *ctx, arg_aes32dsi *a) {return gen_rv32_only(ctx);}
+static bool trans_aes32dsmi(DisasContext *ctx, arg_aes32dsmi *a) {return gen_rv32_only(ctx);}
+static bool trans_aes32esi(DisasContext *ctx, arg_aes32esi *a) {return gen_rv32_only(ctx);}
+static bool trans_aes32esmi(DisasContext *ctx, arg_aes32esmi *a) {return gen_rv32_only(ctx);}
+static bool trans_aes64im(DisasContext *ctx, arg_aes64im *a) {
+    uint64_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
+    uint64_t dest;
+#if defined(__x86_64__)
+    if (host_aes) {
+        dest = aes64_im_host(src1);
+    } else
+#endif
+    {
+        dest = aes_mixcolumn(src1, true) | ((uint64_t)aes_mixcolumn(src1 >> 32, true) << 32);
+    }
+    SET_GPR_64
+    SET_SRC1_DST
+    ctx->info->type = AES;
+    return true;
+}
+static bool trans_aes64ks1i(DisasContext *ctx, arg_aes64ks1i *a) {
+    static const uint8_t rcon[] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36};
+    if (a->imm > 0xa) {
+        ctx->info->exception = EXC_II;
+        ctx->info->exc_data = ctx->info->inst;
+        return true;
+    }
+    uint64_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
+    uint32_t word = src1 >> 32;
+    // round 10 is only used for the last aes-256 half key, no rotate and no rcon
+    if (a->imm != 0xa) {
+        word = std::rotr(word, 8);
+    }
+    word = aes_subword(word);
+    if (a->imm != 0xa) {
+        word ^= rcon[a->imm];
+    }
+    uint64_t dest = ((uint64_t)word << 32) | word;
+    SET_GPR_64
+    SET_SRC1_DST
+    ctx->info->type = AES;
+    return true;
+}
+static bool trans_aes64ks2(DisasContext *ctx, arg_aes64ks2 *a) {
+    uint64_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
+    uint64_t src2 = get_gpr_64(ctx, a->rs2, EXT_NONE);
+    uint32_t w0 = (src1 >> 32) ^ (uint32_t)src2;
+    uint32_t w1 = w0 ^ (src2 >> 32);
+    uint64_t dest = ((uint64_t)w1 << 32) | w0;
+    SET_GPR_64
+    SET_SRC2_DST
+    ctx->info->type = AES;
+    return true;
+}
 static bool trans_amoadd_b(DisasContext *ctx, arg_amoadd_b *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_amoadd_h(DisasContext *ctx, arg_amoadd_h *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_amoadd_w(DisasContext *ctx, arg_amoadd_w *a) {
@@ -1136,9 +1329,54 @@ static bool trans_cbo_clean(DisasContext *ctx, arg_cbo_clean *a) {__NOT_IMPLEMEN
 static bool trans_cbo_flush(DisasContext *ctx, arg_cbo_flush *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_cbo_inval(DisasContext *ctx, arg_cbo_inval *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_cbo_zero(DisasContext *ctx, arg_cbo_zero *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_clmul(DisasContext *ctx, arg_clmul *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_clmulh(DisasContext *ctx, arg_clmulh *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_clmulr(DisasContext *ctx, arg_clmulr *a) {__NOT_IMPLEMENTED_EXIT__}
+// 128 bit carry-less product of x and y, returns the low half
+static inline uint64_t clmul64(uint64_t x, uint64_t y, uint64_t& hi) {
+#if defined(__x86_64__)
+    if (host_pclmul) {
+        return clmul_host(x, y, hi);
+    }
+#endif
+    uint64_t lo = x & -(y & 1);
+    hi = 0;
+    for (int i = 1; i < 64; i++) {
+        if ((y >> i) & 1) {
+            lo ^= x << i;
+            hi ^= x >> (64 - i);
+        }
+    }
+    return lo;
+}
+static bool trans_clmul(DisasContext *ctx, arg_clmul *a) {
+    uint64_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
+    uint64_t src2 = get_gpr_64(ctx, a->rs2, EXT_NONE);
+    uint64_t hi;
+    uint64_t dest = clmul64(src1, src2, hi);
+    SET_GPR_64
+    SET_SRC2_DST
+    ctx->info->type = CLMUL;
+    return true;
+}
+static bool trans_clmulh(DisasContext *ctx, arg_clmulh *a) {
+    uint64_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
+    uint64_t src2 = get_gpr_64(ctx, a->rs2, EXT_NONE);
+    uint64_t dest;
+    clmul64(src1, src2, dest);
+    SET_GPR_64
+    SET_SRC2_DST
+    ctx->info->type = CLMUL;
+    return true;
+}
+static bool trans_clmulr(DisasContext *ctx, arg_clmulr *a) {
+    uint64_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
+    uint64_t src2 = get_gpr_64(ctx, a->rs2, EXT_NONE);
+    uint64_t hi;
+    uint64_t lo = clmul64(src1, src2, hi);
+    uint64_t dest = (hi << 1) | (lo >> 63);
+    SET_GPR_64
+    SET_SRC2_DST
+    ctx->info->type = CLMUL;
+    return true;
+}
 static bool trans_clz(DisasContext *ctx, arg_clz *a) {
     uint64_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
     uint64_t dest = std::countl_zero(src1);
@@ -1305,8 +1543,34 @@ static inline uint64_t get_fpr_64(DisasContext *ctx, int rs1) {
     return ctx->state->fpr[rs1];
 }
 static inline void setrm(DisasContext *ctx, int rm) {
-    ctx->state->fp_status.float_rounding_mode = (FloatRoundMode)rm;
+    ctx->state->fp_status.float_rounding_mode = riscv_round_mode(rm, ctx->state->frm);
+}
+
+/**
+ * @brief run a double op on the host fpu, see host_fp64
+ * @return false if the caller must fall back to softfloat
+ */
+static inline bool host_float64(DisasContext *ctx, HostFpOp op, int rm, uint64_t src1, uint64_t src2, TCGv& dest) {
+    uint64_t res;
+    if (!host_fp64(&ctx->state->fp_status, ctx->state->frm, op, rm, src1, src2, res)) {
+        return false;
+    }
+    dest = res;
+    return true;
+}
+
+/**
+ * @brief host_float64 for float, unboxed operands are nan and fall back
+ */
+static inline bool host_float32(DisasContext *ctx, HostFpOp op, int rm, uint32_t src1, uint32_t src2, TCGv& dest) {
+    uint32_t res;
+    if (!host_fp32(&ctx->state->fp_status, ctx->state->frm, op, rm, src1, src2, res)) {
+        return false;
+    }
+    dest = nanbox_s(res);
+    return true;
 }
+
 static bool trans_fclass_d(DisasContext *ctx, arg_fclass_d *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_fclass_h(DisasContext *ctx, arg_fclass_h *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_fclass_s(DisasContext *ctx, arg_fclass_s *a) {__NOT_IMPLEMENTED_EXIT__}
@@ -1500,8 +1764,11 @@ static bool trans_fadd_d(DisasContext *ctx, arg_fadd_d *a) {
     REQUIRE_FPU
     TCGv src1 = get_fpr_64(ctx, a->rs1);
     TCGv src2 = get_fpr_64(ctx, a->rs2);
-    setrm(ctx, a->rm);
-    TCGv dest = float64_add(src1, src2, &ctx->state->fp_status);
+    TCGv dest;
+    if (!host_float64(ctx, HOST_FADD, a->rm, src1, src2, dest)) {
+        setrm(ctx, a->rm);
+        dest = float64_add(src1, src2, &ctx->state->fp_status);
+    }
     SET_FPR_64
     SET_SRC2F_DSTF
     ctx->info->type = FADD;
@@ -1512,8 +1779,11 @@ static bool trans_fadd_s(DisasContext *ctx, arg_fadd_s *a) {
     REQUIRE_FPU
     TCGv src1 = check_nanbox_s(ctx, get_fpr_64(ctx, a->rs1));
     TCGv src2 = check_nanbox_s(ctx, get_fpr_64(ctx, a->rs2));
-    setrm(ctx, a->rm);
-    TCGv dest = nanbox_s(float32_add(src1, src2, &ctx->state->fp_status));
+    TCGv dest;
+    if (!host_float32(ctx, HOST_FADD, a->rm, src1, src2, dest)) {
+        setrm(ctx, a->rm);
+        dest = nanbox_s(float32_add(src1, src2, &ctx->state->fp_status));
+    }
     SET_FPR_64
     SET_SRC2F_DSTF
     ctx->info->type = FADD;
@@ -1523,8 +1793,11 @@ static bool trans_fsub_d(DisasContext *ctx, arg_fsub_d *a) {
     REQUIRE_FPU
     TCGv src1 = get_fpr_64(ctx, a->rs1);
     TCGv src2 = get_fpr_64(ctx, a->rs2);
-    setrm(ctx, a->rm);
-    TCGv dest = float64_sub(src1, src2, &ctx->state->fp_status);
+    TCGv dest;
+    if (!host_float64(ctx, HOST_FSUB, a->rm, src1, src2, dest)) {
+        setrm(ctx, a->rm);
+        dest = float64_sub(src1, src2, &ctx->state->fp_status);
+    }
     SET_FPR_64
     SET_SRC2F_DSTF
     ctx->info->type = FADD;
@@ -1535,8 +1808,11 @@ static bool trans_fsub_s(DisasContext *ctx, arg_fsub_s *a) {
     REQUIRE_FPU
     TCGv src1 = check_nanbox_s(ctx, get_fpr_64(ctx, a->rs1));
     TCGv src2 = check_nanbox_s(ctx, get_fpr_64(ctx, a->rs2));
-    setrm(ctx, a->rm);
-    TCGv dest = nanbox_s(float32_sub(src1, src2, &ctx->state->fp_status));
+    TCGv dest;
+    if (!host_float32(ctx, HOST_FSUB, a->rm, src1, src2, dest)) {
+        setrm(ctx, a->rm);
+        dest = nanbox_s(float32_sub(src1, src2, &ctx->state->fp_status));
+    }
     SET_FPR_64
     SET_SRC2F_DSTF
     ctx->info->type = FADD;
@@ -1546,8 +1822,11 @@ static bool trans_fmul_d(DisasContext *ctx, arg_fmul_d *a) {
     REQUIRE_FPU
     TCGv src1 = get_fpr_64(ctx, a->rs1);
     TCGv src2 = get_fpr_64(ctx, a->rs2);
-    setrm(ctx, a->rm);
-    TCGv dest = float64_mul(src1, src2, &ctx->state->fp_status);
+    TCGv dest;
+    if (!host_float64(ctx, HOST_FMUL, a->rm, src1, src2, dest)) {
+        setrm(ctx, a->rm);
+        dest = float64_mul(src1, src2, &ctx->state->fp_status);
+    }
     SET_FPR_64
     SET_SRC2F_DSTF
     ctx->info->type = FMUL;
@@ -1558,8 +1837,11 @@ static bool trans_fmul_s(DisasContext *ctx, arg_fmul_s *a) {
     REQUIRE_FPU
     TCGv src1 = check_nanbox_s(ctx, get_fpr_64(ctx, a->rs1));
     TCGv src2 = check_nanbox_s(ctx, get_fpr_64(ctx, a->rs2));
-    setrm(ctx, a->rm);
-    TCGv dest = nanbox_s(float32_mul(src1, src2, &ctx->state->fp_status));
+    TCGv dest;
+    if (!host_float32(ctx, HOST_FMUL, a->rm, src1, src2, dest)) {
+        setrm(ctx, a->rm);
+        dest = nanbox_s(float32_mul(src1, src2, &ctx->state->fp_status));
+    }
     SET_FPR_64
     SET_SRC2F_DSTF
     ctx->info->type = FMUL;
@@ -1569,8 +1851,11 @@ static bool trans_fdiv_d(DisasContext *ctx, arg_fdiv_d *a) {
     REQUIRE_FPU
     TCGv src1 = get_fpr_64(ctx, a->rs1);
     TCGv src2 = get_fpr_64(ctx, a->rs2);
-    setrm(ctx, a->rm);
-    TCGv dest = float64_div(src1, src2, &ctx->state->fp_status);
+    TCGv dest;
+    if (!host_float64(ctx, HOST_FDIV, a->rm, src1, src2, dest)) {
+        setrm(ctx, a->rm);
+        dest = float64_div(src1, src2, &ctx->state->fp_status);
+    }
     SET_FPR_64
     SET_SRC2F_DSTF
     ctx->info->type = FDIV;
@@ -1581,8 +1866,11 @@ static bool trans_fdiv_s(DisasContext *ctx, arg_fdiv_s *a) {
     REQUIRE_FPU
     TCGv src1 = check_nanbox_s(ctx, get_fpr_64(ctx, a->rs1));
     TCGv src2 = check_nanbox_s(ctx, get_fpr_64(ctx, a->rs2));
-    setrm(ctx, a->rm);
-    TCGv dest = nanbox_s(float32_div(src1, src2, &ctx->state->fp_status));
+    TCGv dest;
+    if (!host_float32(ctx, HOST_FDIV, a->rm, src1, src2, dest)) {
+        setrm(ctx, a->rm);
+        dest = nanbox_s(float32_div(src1, src2, &ctx->state->fp_status));
+    }
     SET_FPR_64
     SET_SRC2F_DSTF
     ctx->info->type = FDIV;
@@ -2294,20 +2582,42 @@ static bool trans_sh3add_uw(DisasContext *ctx, arg_sh3add_uw *a) {
     ctx->info->type = INT;
     return true;
 }
-static bool trans_sha256sig0(DisasContext *ctx, arg_sha256sig0 *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_sha256sig1(DisasContext *ctx, arg_sha256sig1 *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_sha256sum0(DisasContext *ctx, arg_sha256sum0 *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_sha256sum1(DisasContext *ctx, arg_sha256sum1 *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_sha512sig0(DisasContext *ctx, arg_sha512sig0 *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_sha512sig0h(DisasContext *ctx, arg_sha512sig0h *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_sha512sig0l(DisasContext *ctx, arg_sha512sig0l *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_sha512sig1(DisasContext *ctx, arg_sha512sig1 *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_sha512sig1h(DisasContext *ctx, arg_sha512sig1h *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_sha512sig1l(DisasContext *ctx, arg_sha512sig1l *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_sha512sum0(DisasContext *ctx, arg_sha512sum0 *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_sha512sum0r(DisasContext *ctx, arg_sha512sum0r *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_sha512sum1(DisasContext *ctx, arg_sha512sum1 *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_sha512sum1r(DisasContext *ctx, arg_sha512sum1r *a) {__NOT_IMPLEMENTED_EXIT__}
+// sha-ni only has whole message schedule and round steps, a single sigma is
+// a few rotates and the compiler emits rorx for them
+#define GEN_SHA256(name, r1, r2, s3) \
+static bool trans_##name(DisasContext *ctx, arg_##name *a) { \
+    uint32_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE); \
+    uint32_t dest = std::rotr(src1, r1) ^ std::rotr(src1, r2) ^ s3; \
+    SET_GPR_32 \
+    SET_SRC1_DST \
+    ctx->info->type = SHA; \
+    return true; \
+}
+
+#define GEN_SHA512(name, r1, r2, s3) \
+static bool trans_##name(DisasContext *ctx, arg_##name *a) { \
+    uint64_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE); \
+    uint64_t dest = std::rotr(src1, r1) ^ std::rotr(src1, r2) ^ s3; \
+    SET_GPR_64 \
+    SET_SRC1_DST \
+    ctx->info->type = SHA; \
+    return true; \
+}
+
+GEN_SHA256(sha256sig0, 7, 18, (src1 >> 3))
+GEN_SHA256(sha256sig1, 17, 19, (src1 >> 10))
+GEN_SHA256(sha256sum0, 2, 13, std::rotr(src1, 22))
+GEN_SHA256(sha256sum1, 6, 11, std::rotr(src1, 25))
+GEN_SHA512(sha512sig0, 1, 8, (src1 >> 7))
+GEN_SHA512(sha512sig1, 19, 61, (src1 >> 6))
+GEN_SHA512(sha512sum0, 28, 34, std::rotr(src1, 39))
+GEN_SHA512(sha512sum1, 14, 18, std::rotr(src1, 41))
+static bool trans_sha512sig0h(DisasContext *ctx, arg_sha512sig0h *a) {return gen_rv32_only(ctx);}
+static bool trans_sha512sig0l(DisasContext *ctx, arg_sha512sig0l *a) {return gen_rv32_only(ctx);}
+static bool trans_sha512sig1h(DisasContext *ctx, arg_sha512sig1h *a) {return gen_rv32_only(ctx);}
+static bool trans_sha512sig1l(DisasContext *ctx, arg_sha512sig1l *a) {return gen_rv32_only(ctx);}
+static bool trans_sha512sum0r(DisasContext *ctx, arg_sha512sum0r *a) {return gen_rv32_only(ctx);}
+static bool trans_sha512sum1r(DisasContext *ctx, arg_sha512sum1r *a) {return gen_rv32_only(ctx);}
 static bool trans_sinval_vma(DisasContext *ctx, arg_sinval_vma *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_sll(DisasContext *ctx, arg_sll *a) {
     uint64_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
@@ -2394,16 +2704,48 @@ static bool trans_sltiu(DisasContext *ctx, arg_sltiu *a) {
     ctx->info->type = INT;
     return true;
 }
-static bool trans_sm3p0(DisasContext *ctx, arg_sm3p0 *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_sm3p1(DisasContext *ctx, arg_sm3p1 *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_sm4ed(DisasContext *ctx, arg_sm4ed *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_sm4ks(DisasContext *ctx, arg_sm4ks *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_sm3p0(DisasContext *ctx, arg_sm3p0 *a) {
+    uint32_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
+    uint32_t dest = src1 ^ std::rotl(src1, 9) ^ std::rotl(src1, 17);
+    SET_GPR_32
+    SET_SRC1_DST
+    ctx->info->type = SHA;
+    return true;
+}
+static bool trans_sm3p1(DisasContext *ctx, arg_sm3p1 *a) {
+    uint32_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
+    uint32_t dest = src1 ^ std::rotl(src1, 15) ^ std::rotl(src1, 23);
+    SET_GPR_32
+    SET_SRC1_DST
+    ctx->info->type = SHA;
+    return true;
+}
+
+// shamt is the byte select already scaled to a bit offset
+static bool trans_sm4ed(DisasContext *ctx, arg_sm4ed *a) {
+    uint32_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
+    uint32_t src2 = get_gpr_64(ctx, a->rs2, EXT_NONE);
+    uint32_t dest = sm4ed(src1, src2, a->shamt);
+    SET_GPR_32
+    SET_SRC2_DST
+    ctx->info->type = AES;
+    return true;
+}
+static bool trans_sm4ks(DisasContext *ctx, arg_sm4ks *a) {
+    uint32_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
+    uint32_t src2 = get_gpr_64(ctx, a->rs2, EXT_NONE);
+    uint32_t dest = sm4ks(src1, src2, a->shamt);
+    SET_GPR_32
+    SET_SRC2_DST
+    ctx->info->type = AES;
+    return true;
+}
 static bool trans_ssamoswap_d(DisasContext *ctx, arg_ssamoswap_d *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_ssamoswap_w(DisasContext *ctx, arg_ssamoswap_w *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_sspopchk(DisasContext *ctx, arg_sspopchk *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_sspush(DisasContext *ctx, arg_sspush *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_ssrdp(DisasContext *ctx, arg_ssrdp *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_unzip(DisasContext *ctx, arg_unzip *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_unzip(DisasContext *ctx, arg_unzip *a) {return gen_rv32_only(ctx);}
 static bool trans_uret(DisasContext *ctx, arg_uret *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_pause(DisasContext *ctx, arg_pause *a) {ctx->info->type=INT; return true;}
 static bool trans_sret(DisasContext *ctx, arg_sret *a) {
@@ -2456,417 +2798,2157 @@ static bool trans_sfence_vma(DisasContext *ctx, arg_sfence_vma *a) {
 static bool trans_sfence_vm(DisasContext *ctx, arg_sfence_vm *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_sfence_w_inval(DisasContext *ctx, arg_sfence_w_inval *a) {__NOT_IMPLEMENTED_EXIT__}
 
-static bool trans_vaaddu_vv(DisasContext *ctx, arg_vaaddu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vaaddu_vx(DisasContext *ctx, arg_vaaddu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vaadd_vv(DisasContext *ctx, arg_vaadd_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vaadd_vx(DisasContext *ctx, arg_vaadd_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vadc_vim(DisasContext *ctx, arg_vadc_vim *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vadc_vvm(DisasContext *ctx, arg_vadc_vvm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vadc_vxm(DisasContext *ctx, arg_vadc_vxm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vadd_vi(DisasContext *ctx, arg_vadd_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vadd_vv(DisasContext *ctx, arg_vadd_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vadd_vx(DisasContext *ctx, arg_vadd_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vaesdf_vs(DisasContext *ctx, arg_vaesdf_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vaesdf_vv(DisasContext *ctx, arg_vaesdf_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vaesdm_vs(DisasContext *ctx, arg_vaesdm_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vaesdm_vv(DisasContext *ctx, arg_vaesdm_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vaesef_vs(DisasContext *ctx, arg_vaesef_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vaesef_vv(DisasContext *ctx, arg_vaesef_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vaesem_vs(DisasContext *ctx, arg_vaesem_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vaesem_vv(DisasContext *ctx, arg_vaesem_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vaeskf1_vi(DisasContext *ctx, arg_vaeskf1_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vaeskf2_vi(DisasContext *ctx, arg_vaeskf2_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vaesz_vs(DisasContext *ctx, arg_vaesz_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vandn_vv(DisasContext *ctx, arg_vandn_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vandn_vx(DisasContext *ctx, arg_vandn_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vand_vi(DisasContext *ctx, arg_vand_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vand_vv(DisasContext *ctx, arg_vand_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vand_vx(DisasContext *ctx, arg_vand_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vasubu_vv(DisasContext *ctx, arg_vasubu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vasubu_vx(DisasContext *ctx, arg_vasubu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vasub_vv(DisasContext *ctx, arg_vasub_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vasub_vx(DisasContext *ctx, arg_vasub_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vbrev8_v(DisasContext *ctx, arg_vbrev8_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vbrev_v(DisasContext *ctx, arg_vbrev_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vclmulh_vv(DisasContext *ctx, arg_vclmulh_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vclmulh_vx(DisasContext *ctx, arg_vclmulh_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vclmul_vv(DisasContext *ctx, arg_vclmul_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vclmul_vx(DisasContext *ctx, arg_vclmul_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vclz_v(DisasContext *ctx, arg_vclz_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vcompress_vm(DisasContext *ctx, arg_vcompress_vm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vcpop_m(DisasContext *ctx, arg_vcpop_m *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vcpop_v(DisasContext *ctx, arg_vcpop_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vctz_v(DisasContext *ctx, arg_vctz_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vdivu_vv(DisasContext *ctx, arg_vdivu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vdivu_vx(DisasContext *ctx, arg_vdivu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vdiv_vv(DisasContext *ctx, arg_vdiv_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vdiv_vx(DisasContext *ctx, arg_vdiv_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfadd_vf(DisasContext *ctx, arg_vfadd_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfadd_vv(DisasContext *ctx, arg_vfadd_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfclass_v(DisasContext *ctx, arg_vfclass_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfcvt_f_xu_v(DisasContext *ctx, arg_vfcvt_f_xu_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfcvt_f_x_v(DisasContext *ctx, arg_vfcvt_f_x_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfcvt_rtz_x_f_v(DisasContext *ctx, arg_vfcvt_rtz_x_f_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfcvt_rtz_xu_f_v(DisasContext *ctx, arg_vfcvt_rtz_xu_f_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfcvt_x_f_v(DisasContext *ctx, arg_vfcvt_x_f_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfcvt_xu_f_v(DisasContext *ctx, arg_vfcvt_xu_f_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfdiv_vf(DisasContext *ctx, arg_vfdiv_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfdiv_vv(DisasContext *ctx, arg_vfdiv_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfirst_m(DisasContext *ctx, arg_vfirst_m *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmacc_vf(DisasContext *ctx, arg_vfmacc_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmacc_vv(DisasContext *ctx, arg_vfmacc_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmadd_vf(DisasContext *ctx, arg_vfmadd_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmadd_vv(DisasContext *ctx, arg_vfmadd_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmax_vf(DisasContext *ctx, arg_vfmax_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmax_vv(DisasContext *ctx, arg_vfmax_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmerge_vfm(DisasContext *ctx, arg_vfmerge_vfm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmin_vf(DisasContext *ctx, arg_vfmin_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmin_vv(DisasContext *ctx, arg_vfmin_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmsac_vf(DisasContext *ctx, arg_vfmsac_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmsac_vv(DisasContext *ctx, arg_vfmsac_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmsub_vf(DisasContext *ctx, arg_vfmsub_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmsub_vv(DisasContext *ctx, arg_vfmsub_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmul_vf(DisasContext *ctx, arg_vfmul_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmul_vv(DisasContext *ctx, arg_vfmul_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmv_f_s(DisasContext *ctx, arg_vfmv_f_s *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmv_s_f(DisasContext *ctx, arg_vfmv_s_f *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfmv_v_f(DisasContext *ctx, arg_vfmv_v_f *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfncvtbf16_f_f_w(DisasContext *ctx, arg_vfncvtbf16_f_f_w *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfncvt_f_f_w(DisasContext *ctx, arg_vfncvt_f_f_w *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfncvt_f_xu_w(DisasContext *ctx, arg_vfncvt_f_xu_w *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfncvt_f_x_w(DisasContext *ctx, arg_vfncvt_f_x_w *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfncvt_rod_f_f_w(DisasContext *ctx, arg_vfncvt_rod_f_f_w *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfncvt_rtz_x_f_w(DisasContext *ctx, arg_vfncvt_rtz_x_f_w *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfncvt_rtz_xu_f_w(DisasContext *ctx, arg_vfncvt_rtz_xu_f_w *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfncvt_x_f_w(DisasContext *ctx, arg_vfncvt_x_f_w *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfncvt_xu_f_w(DisasContext *ctx, arg_vfncvt_xu_f_w *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfnmacc_vf(DisasContext *ctx, arg_vfnmacc_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfnmacc_vv(DisasContext *ctx, arg_vfnmacc_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfnmadd_vf(DisasContext *ctx, arg_vfnmadd_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfnmadd_vv(DisasContext *ctx, arg_vfnmadd_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfnmsac_vf(DisasContext *ctx, arg_vfnmsac_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfnmsac_vv(DisasContext *ctx, arg_vfnmsac_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfnmsub_vf(DisasContext *ctx, arg_vfnmsub_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfnmsub_vv(DisasContext *ctx, arg_vfnmsub_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfrdiv_vf(DisasContext *ctx, arg_vfrdiv_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfrec7_v(DisasContext *ctx, arg_vfrec7_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfredmax_vs(DisasContext *ctx, arg_vfredmax_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfredmin_vs(DisasContext *ctx, arg_vfredmin_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfredosum_vs(DisasContext *ctx, arg_vfredosum_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfredusum_vs(DisasContext *ctx, arg_vfredusum_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfrsqrt7_v(DisasContext *ctx, arg_vfrsqrt7_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfrsub_vf(DisasContext *ctx, arg_vfrsub_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfsgnjn_vf(DisasContext *ctx, arg_vfsgnjn_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfsgnjn_vv(DisasContext *ctx, arg_vfsgnjn_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfsgnj_vf(DisasContext *ctx, arg_vfsgnj_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfsgnj_vv(DisasContext *ctx, arg_vfsgnj_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfsgnjx_vf(DisasContext *ctx, arg_vfsgnjx_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfsgnjx_vv(DisasContext *ctx, arg_vfsgnjx_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfslide1down_vf(DisasContext *ctx, arg_vfslide1down_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfslide1up_vf(DisasContext *ctx, arg_vfslide1up_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfsqrt_v(DisasContext *ctx, arg_vfsqrt_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfsub_vf(DisasContext *ctx, arg_vfsub_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfsub_vv(DisasContext *ctx, arg_vfsub_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwadd_vf(DisasContext *ctx, arg_vfwadd_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwadd_vv(DisasContext *ctx, arg_vfwadd_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwadd_wf(DisasContext *ctx, arg_vfwadd_wf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwadd_wv(DisasContext *ctx, arg_vfwadd_wv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwcvtbf16_f_f_v(DisasContext *ctx, arg_vfwcvtbf16_f_f_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwcvt_f_f_v(DisasContext *ctx, arg_vfwcvt_f_f_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwcvt_f_xu_v(DisasContext *ctx, arg_vfwcvt_f_xu_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwcvt_f_x_v(DisasContext *ctx, arg_vfwcvt_f_x_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwcvt_rtz_x_f_v(DisasContext *ctx, arg_vfwcvt_rtz_x_f_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwcvt_rtz_xu_f_v(DisasContext *ctx, arg_vfwcvt_rtz_xu_f_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwcvt_x_f_v(DisasContext *ctx, arg_vfwcvt_x_f_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwcvt_xu_f_v(DisasContext *ctx, arg_vfwcvt_xu_f_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwmaccbf16_vf(DisasContext *ctx, arg_vfwmaccbf16_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwmaccbf16_vv(DisasContext *ctx, arg_vfwmaccbf16_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwmacc_vf(DisasContext *ctx, arg_vfwmacc_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwmacc_vv(DisasContext *ctx, arg_vfwmacc_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwmsac_vf(DisasContext *ctx, arg_vfwmsac_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwmsac_vv(DisasContext *ctx, arg_vfwmsac_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwmul_vf(DisasContext *ctx, arg_vfwmul_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwmul_vv(DisasContext *ctx, arg_vfwmul_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwnmacc_vf(DisasContext *ctx, arg_vfwnmacc_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwnmacc_vv(DisasContext *ctx, arg_vfwnmacc_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwnmsac_vf(DisasContext *ctx, arg_vfwnmsac_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwnmsac_vv(DisasContext *ctx, arg_vfwnmsac_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwredosum_vs(DisasContext *ctx, arg_vfwredosum_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwredusum_vs(DisasContext *ctx, arg_vfwredusum_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwsub_vf(DisasContext *ctx, arg_vfwsub_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwsub_vv(DisasContext *ctx, arg_vfwsub_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwsub_wf(DisasContext *ctx, arg_vfwsub_wf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vfwsub_wv(DisasContext *ctx, arg_vfwsub_wv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vghsh_vv(DisasContext *ctx, arg_vghsh_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vgmul_vv(DisasContext *ctx, arg_vgmul_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vid_v(DisasContext *ctx, arg_vid_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_viota_m(DisasContext *ctx, arg_viota_m *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vl1re16_v(DisasContext *ctx, arg_vl1re16_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vl1re32_v(DisasContext *ctx, arg_vl1re32_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vl1re64_v(DisasContext *ctx, arg_vl1re64_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vl1re8_v(DisasContext *ctx, arg_vl1re8_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vl2re16_v(DisasContext *ctx, arg_vl2re16_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vl2re32_v(DisasContext *ctx, arg_vl2re32_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vl2re64_v(DisasContext *ctx, arg_vl2re64_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vl2re8_v(DisasContext *ctx, arg_vl2re8_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vl4re16_v(DisasContext *ctx, arg_vl4re16_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vl4re32_v(DisasContext *ctx, arg_vl4re32_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vl4re64_v(DisasContext *ctx, arg_vl4re64_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vl4re8_v(DisasContext *ctx, arg_vl4re8_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vl8re16_v(DisasContext *ctx, arg_vl8re16_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vl8re32_v(DisasContext *ctx, arg_vl8re32_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vl8re64_v(DisasContext *ctx, arg_vl8re64_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vl8re8_v(DisasContext *ctx, arg_vl8re8_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vle16ff_v(DisasContext *ctx, arg_vle16ff_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vle16_v(DisasContext *ctx, arg_vle16_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vle32ff_v(DisasContext *ctx, arg_vle32ff_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vle32_v(DisasContext *ctx, arg_vle32_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vle64ff_v(DisasContext *ctx, arg_vle64ff_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vle64_v(DisasContext *ctx, arg_vle64_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vle8ff_v(DisasContext *ctx, arg_vle8ff_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vle8_v(DisasContext *ctx, arg_vle8_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vlm_v(DisasContext *ctx, arg_vlm_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vlse16_v(DisasContext *ctx, arg_vlse16_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vlse32_v(DisasContext *ctx, arg_vlse32_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vlse64_v(DisasContext *ctx, arg_vlse64_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vlse8_v(DisasContext *ctx, arg_vlse8_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vlxei16_v(DisasContext *ctx, arg_vlxei16_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vlxei32_v(DisasContext *ctx, arg_vlxei32_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vlxei64_v(DisasContext *ctx, arg_vlxei64_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vlxei8_v(DisasContext *ctx, arg_vlxei8_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmacc_vv(DisasContext *ctx, arg_vmacc_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmacc_vx(DisasContext *ctx, arg_vmacc_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmadc_vim(DisasContext *ctx, arg_vmadc_vim *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmadc_vvm(DisasContext *ctx, arg_vmadc_vvm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmadc_vxm(DisasContext *ctx, arg_vmadc_vxm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmadd_vv(DisasContext *ctx, arg_vmadd_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmadd_vx(DisasContext *ctx, arg_vmadd_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmand_mm(DisasContext *ctx, arg_vmand_mm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmandn_mm(DisasContext *ctx, arg_vmandn_mm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmaxu_vv(DisasContext *ctx, arg_vmaxu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmaxu_vx(DisasContext *ctx, arg_vmaxu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmax_vv(DisasContext *ctx, arg_vmax_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmax_vx(DisasContext *ctx, arg_vmax_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmerge_vim(DisasContext *ctx, arg_vmerge_vim *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmerge_vvm(DisasContext *ctx, arg_vmerge_vvm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmerge_vxm(DisasContext *ctx, arg_vmerge_vxm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmfeq_vf(DisasContext *ctx, arg_vmfeq_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmfeq_vv(DisasContext *ctx, arg_vmfeq_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmfge_vf(DisasContext *ctx, arg_vmfge_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmfgt_vf(DisasContext *ctx, arg_vmfgt_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmfle_vf(DisasContext *ctx, arg_vmfle_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmfle_vv(DisasContext *ctx, arg_vmfle_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmflt_vf(DisasContext *ctx, arg_vmflt_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmflt_vv(DisasContext *ctx, arg_vmflt_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmfne_vf(DisasContext *ctx, arg_vmfne_vf *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmfne_vv(DisasContext *ctx, arg_vmfne_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vminu_vv(DisasContext *ctx, arg_vminu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vminu_vx(DisasContext *ctx, arg_vminu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmin_vv(DisasContext *ctx, arg_vmin_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmin_vx(DisasContext *ctx, arg_vmin_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmnand_mm(DisasContext *ctx, arg_vmnand_mm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmnor_mm(DisasContext *ctx, arg_vmnor_mm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmor_mm(DisasContext *ctx, arg_vmor_mm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmorn_mm(DisasContext *ctx, arg_vmorn_mm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsbc_vvm(DisasContext *ctx, arg_vmsbc_vvm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsbc_vxm(DisasContext *ctx, arg_vmsbc_vxm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsbf_m(DisasContext *ctx, arg_vmsbf_m *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmseq_vi(DisasContext *ctx, arg_vmseq_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmseq_vv(DisasContext *ctx, arg_vmseq_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmseq_vx(DisasContext *ctx, arg_vmseq_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsgtu_vi(DisasContext *ctx, arg_vmsgtu_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsgtu_vx(DisasContext *ctx, arg_vmsgtu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsgt_vi(DisasContext *ctx, arg_vmsgt_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsgt_vx(DisasContext *ctx, arg_vmsgt_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsif_m(DisasContext *ctx, arg_vmsif_m *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsleu_vi(DisasContext *ctx, arg_vmsleu_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsleu_vv(DisasContext *ctx, arg_vmsleu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsleu_vx(DisasContext *ctx, arg_vmsleu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsle_vi(DisasContext *ctx, arg_vmsle_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsle_vv(DisasContext *ctx, arg_vmsle_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsle_vx(DisasContext *ctx, arg_vmsle_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsltu_vv(DisasContext *ctx, arg_vmsltu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsltu_vx(DisasContext *ctx, arg_vmsltu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmslt_vv(DisasContext *ctx, arg_vmslt_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmslt_vx(DisasContext *ctx, arg_vmslt_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsne_vi(DisasContext *ctx, arg_vmsne_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsne_vv(DisasContext *ctx, arg_vmsne_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsne_vx(DisasContext *ctx, arg_vmsne_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmsof_m(DisasContext *ctx, arg_vmsof_m *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmulhsu_vv(DisasContext *ctx, arg_vmulhsu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmulhsu_vx(DisasContext *ctx, arg_vmulhsu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmulhu_vv(DisasContext *ctx, arg_vmulhu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmulhu_vx(DisasContext *ctx, arg_vmulhu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmulh_vv(DisasContext *ctx, arg_vmulh_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmulh_vx(DisasContext *ctx, arg_vmulh_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmul_vv(DisasContext *ctx, arg_vmul_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmul_vx(DisasContext *ctx, arg_vmul_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmv1r_v(DisasContext *ctx, arg_vmv1r_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmv2r_v(DisasContext *ctx, arg_vmv2r_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmv4r_v(DisasContext *ctx, arg_vmv4r_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmv8r_v(DisasContext *ctx, arg_vmv8r_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmv_s_x(DisasContext *ctx, arg_vmv_s_x *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmv_v_i(DisasContext *ctx, arg_vmv_v_i *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmv_v_v(DisasContext *ctx, arg_vmv_v_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmv_v_x(DisasContext *ctx, arg_vmv_v_x *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmv_x_s(DisasContext *ctx, arg_vmv_x_s *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmxnor_mm(DisasContext *ctx, arg_vmxnor_mm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vmxor_mm(DisasContext *ctx, arg_vmxor_mm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vnclipu_wi(DisasContext *ctx, arg_vnclipu_wi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vnclipu_wv(DisasContext *ctx, arg_vnclipu_wv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vnclipu_wx(DisasContext *ctx, arg_vnclipu_wx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vnclip_wi(DisasContext *ctx, arg_vnclip_wi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vnclip_wv(DisasContext *ctx, arg_vnclip_wv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vnclip_wx(DisasContext *ctx, arg_vnclip_wx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vnmsac_vv(DisasContext *ctx, arg_vnmsac_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vnmsac_vx(DisasContext *ctx, arg_vnmsac_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vnmsub_vv(DisasContext *ctx, arg_vnmsub_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vnmsub_vx(DisasContext *ctx, arg_vnmsub_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vnsra_wi(DisasContext *ctx, arg_vnsra_wi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vnsra_wv(DisasContext *ctx, arg_vnsra_wv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vnsra_wx(DisasContext *ctx, arg_vnsra_wx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vnsrl_wi(DisasContext *ctx, arg_vnsrl_wi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vnsrl_wv(DisasContext *ctx, arg_vnsrl_wv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vnsrl_wx(DisasContext *ctx, arg_vnsrl_wx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vor_vi(DisasContext *ctx, arg_vor_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vor_vv(DisasContext *ctx, arg_vor_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vor_vx(DisasContext *ctx, arg_vor_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vredand_vs(DisasContext *ctx, arg_vredand_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vredmaxu_vs(DisasContext *ctx, arg_vredmaxu_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vredmax_vs(DisasContext *ctx, arg_vredmax_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vredminu_vs(DisasContext *ctx, arg_vredminu_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vredmin_vs(DisasContext *ctx, arg_vredmin_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vredor_vs(DisasContext *ctx, arg_vredor_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vredsum_vs(DisasContext *ctx, arg_vredsum_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vredxor_vs(DisasContext *ctx, arg_vredxor_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vremu_vv(DisasContext *ctx, arg_vremu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vremu_vx(DisasContext *ctx, arg_vremu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vrem_vv(DisasContext *ctx, arg_vrem_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vrem_vx(DisasContext *ctx, arg_vrem_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vrev8_v(DisasContext *ctx, arg_vrev8_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vrgatherei16_vv(DisasContext *ctx, arg_vrgatherei16_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vrgather_vi(DisasContext *ctx, arg_vrgather_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vrgather_vv(DisasContext *ctx, arg_vrgather_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vrgather_vx(DisasContext *ctx, arg_vrgather_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vrol_vv(DisasContext *ctx, arg_vrol_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vrol_vx(DisasContext *ctx, arg_vrol_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vror_vi(DisasContext *ctx, arg_vror_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vror_vv(DisasContext *ctx, arg_vror_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vror_vx(DisasContext *ctx, arg_vror_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vrsub_vi(DisasContext *ctx, arg_vrsub_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vrsub_vx(DisasContext *ctx, arg_vrsub_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vs1r_v(DisasContext *ctx, arg_vs1r_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vs2r_v(DisasContext *ctx, arg_vs2r_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vs4r_v(DisasContext *ctx, arg_vs4r_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vs8r_v(DisasContext *ctx, arg_vs8r_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsaddu_vi(DisasContext *ctx, arg_vsaddu_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsaddu_vv(DisasContext *ctx, arg_vsaddu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsaddu_vx(DisasContext *ctx, arg_vsaddu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsadd_vi(DisasContext *ctx, arg_vsadd_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsadd_vv(DisasContext *ctx, arg_vsadd_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsadd_vx(DisasContext *ctx, arg_vsadd_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsbc_vvm(DisasContext *ctx, arg_vsbc_vvm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsbc_vxm(DisasContext *ctx, arg_vsbc_vxm *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vse16_v(DisasContext *ctx, arg_vse16_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vse32_v(DisasContext *ctx, arg_vse32_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vse64_v(DisasContext *ctx, arg_vse64_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vse8_v(DisasContext *ctx, arg_vse8_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsetivli(DisasContext *ctx, arg_vsetivli *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsetvl(DisasContext *ctx, arg_vsetvl *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsetvli(DisasContext *ctx, arg_vsetvli *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsext_vf2(DisasContext *ctx, arg_vsext_vf2 *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsext_vf4(DisasContext *ctx, arg_vsext_vf4 *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsext_vf8(DisasContext *ctx, arg_vsext_vf8 *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsha2ch_vv(DisasContext *ctx, arg_vsha2ch_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsha2cl_vv(DisasContext *ctx, arg_vsha2cl_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsha2ms_vv(DisasContext *ctx, arg_vsha2ms_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vslide1down_vx(DisasContext *ctx, arg_vslide1down_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vslide1up_vx(DisasContext *ctx, arg_vslide1up_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vslidedown_vi(DisasContext *ctx, arg_vslidedown_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vslidedown_vx(DisasContext *ctx, arg_vslidedown_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vslideup_vi(DisasContext *ctx, arg_vslideup_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vslideup_vx(DisasContext *ctx, arg_vslideup_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsll_vi(DisasContext *ctx, arg_vsll_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsll_vv(DisasContext *ctx, arg_vsll_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsll_vx(DisasContext *ctx, arg_vsll_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsm3c_vi(DisasContext *ctx, arg_vsm3c_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsm3me_vv(DisasContext *ctx, arg_vsm3me_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsm4k_vi(DisasContext *ctx, arg_vsm4k_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsm4r_vs(DisasContext *ctx, arg_vsm4r_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsm4r_vv(DisasContext *ctx, arg_vsm4r_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsmul_vv(DisasContext *ctx, arg_vsmul_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsmul_vx(DisasContext *ctx, arg_vsmul_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsm_v(DisasContext *ctx, arg_vsm_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsra_vi(DisasContext *ctx, arg_vsra_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsra_vv(DisasContext *ctx, arg_vsra_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsra_vx(DisasContext *ctx, arg_vsra_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsrl_vi(DisasContext *ctx, arg_vsrl_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsrl_vv(DisasContext *ctx, arg_vsrl_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsrl_vx(DisasContext *ctx, arg_vsrl_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsse16_v(DisasContext *ctx, arg_vsse16_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsse32_v(DisasContext *ctx, arg_vsse32_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsse64_v(DisasContext *ctx, arg_vsse64_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsse8_v(DisasContext *ctx, arg_vsse8_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vssra_vi(DisasContext *ctx, arg_vssra_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vssra_vv(DisasContext *ctx, arg_vssra_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vssra_vx(DisasContext *ctx, arg_vssra_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vssrl_vi(DisasContext *ctx, arg_vssrl_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vssrl_vv(DisasContext *ctx, arg_vssrl_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vssrl_vx(DisasContext *ctx, arg_vssrl_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vssubu_vv(DisasContext *ctx, arg_vssubu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vssubu_vx(DisasContext *ctx, arg_vssubu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vssub_vv(DisasContext *ctx, arg_vssub_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vssub_vx(DisasContext *ctx, arg_vssub_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsub_vv(DisasContext *ctx, arg_vsub_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsub_vx(DisasContext *ctx, arg_vsub_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsxei16_v(DisasContext *ctx, arg_vsxei16_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsxei32_v(DisasContext *ctx, arg_vsxei32_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsxei64_v(DisasContext *ctx, arg_vsxei64_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vsxei8_v(DisasContext *ctx, arg_vsxei8_v *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwaddu_vv(DisasContext *ctx, arg_vwaddu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwaddu_vx(DisasContext *ctx, arg_vwaddu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwaddu_wv(DisasContext *ctx, arg_vwaddu_wv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwaddu_wx(DisasContext *ctx, arg_vwaddu_wx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwadd_vv(DisasContext *ctx, arg_vwadd_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwadd_vx(DisasContext *ctx, arg_vwadd_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwadd_wv(DisasContext *ctx, arg_vwadd_wv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwadd_wx(DisasContext *ctx, arg_vwadd_wx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwmaccsu_vv(DisasContext *ctx, arg_vwmaccsu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwmaccsu_vx(DisasContext *ctx, arg_vwmaccsu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwmaccus_vx(DisasContext *ctx, arg_vwmaccus_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwmaccu_vv(DisasContext *ctx, arg_vwmaccu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwmaccu_vx(DisasContext *ctx, arg_vwmaccu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwmacc_vv(DisasContext *ctx, arg_vwmacc_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwmacc_vx(DisasContext *ctx, arg_vwmacc_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwmulsu_vv(DisasContext *ctx, arg_vwmulsu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwmulsu_vx(DisasContext *ctx, arg_vwmulsu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwmulu_vv(DisasContext *ctx, arg_vwmulu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwmulu_vx(DisasContext *ctx, arg_vwmulu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwmul_vv(DisasContext *ctx, arg_vwmul_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwmul_vx(DisasContext *ctx, arg_vwmul_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwredsumu_vs(DisasContext *ctx, arg_vwredsumu_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwredsum_vs(DisasContext *ctx, arg_vwredsum_vs *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwsll_vi(DisasContext *ctx, arg_vwsll_vi *a) {__NOT_IMPLEMENTED_EXIT__}
+/*
+ * vector, VLEN is fixed by archstate.h. A trans function never writes the
+ * vector registers, it builds the result in ctx->vdest and updateEnv applies
+ * it, so a faulting instruction changes nothing and restarts from vstart.
+ * Inactive and tail elements are always undisturbed.
+ */
+#define REQUIRE_VS do { \
+    if (!(ctx->state->mstatus & MSTATUS_VS)) { \
+        ctx->info->exception = EXC_II; \
+        return true; \
+    } \
+    ctx->state->mstatus |= MSTATUS_VS; \
+} while (0);
+
+#define REQUIRE_VECTOR do { \
+    if (!(ctx->state->mstatus & MSTATUS_VS) || (int64_t)ctx->state->vtype < 0) { \
+        ctx->info->exception = EXC_II; \
+        return true; \
+    } \
+    ctx->state->mstatus |= MSTATUS_VS; \
+} while (0);
+
+// reserved encodings, like a misaligned register group, are illegal
+#define VEC_CHECK(cond) do { \
+    if (unlikely(!(cond))) { \
+        ctx->info->exception = EXC_II; \
+        return true; \
+    } \
+} while (0);
+
+enum VecForm { VEC_VV, VEC_VX, VEC_VI, VEC_VIU };
+
+// log2 of the element bytes, 0 for e8 to 3 for e64
+static inline int vec_sew(DisasContext *ctx) {
+    return (ctx->state->vtype >> 3) & 7;
+}
+
+// log2 of lmul, -3 for mf8 to 3 for m8
+static inline int vec_lmul(DisasContext *ctx) {
+    return (((int)ctx->state->vtype & 7) ^ 4) - 4;
+}
+
+static inline uint32_t vec_vlmax(int sew, int lmul) {
+    return lmul >= 0 ? (VLENB >> sew) << lmul : (VLENB >> sew) >> -lmul;
+}
+
+// registers of a group, a fractional group takes one
+static inline int vec_nregs(int lmul) {
+    return lmul > 0 ? 1 << lmul : 1;
+}
+
+static inline bool vec_aligned(int reg, int lmul) {
+    return (reg & (vec_nregs(lmul) - 1)) == 0;
+}
+
+// a masked instruction may only write v0 when its result is a mask
+static inline bool vec_check_vd(int vd, int vm, int lmul) {
+    return vec_aligned(vd, lmul) && (vm || vd != 0);
+}
+
+static inline bool vec_overlap(int r1, int n1, int r2, int n2) {
+    return r1 < r2 + n2 && r2 < r1 + n1;
+}
+
+static inline bool vec_bit(const uint8_t *m, uint32_t i) {
+    return (m[i >> 3] >> (i & 7)) & 1;
+}
+
+static inline void vec_set_bit(uint8_t *m, uint32_t i, bool v) {
+    m[i >> 3] = (m[i >> 3] & ~(1 << (i & 7))) | (v << (i & 7));
+}
+
+static inline bool vec_mask(DisasContext *ctx, uint32_t i) {
+    return vec_bit(ctx->state->vreg[0], i);
+}
+
+static inline uint64_t vec_scalar(DisasContext *ctx, int form, int rs1) {
+    switch (form) {
+    case VEC_VX: return ctx->state->gpr[rs1];
+    case VEC_VI: return (int64_t)((uint64_t)rs1 << 59) >> 59;
+    default: return rs1;
+    }
+}
+
+/**
+ * @brief start the result of registers vd to vd + nregs - 1 from their old value
+ */
+static inline uint8_t* vec_dest(DisasContext *ctx, int vd, int nregs) {
+    VecDest *dest = ctx->vdest;
+    dest->vd = vd;
+    dest->nregs = nregs;
+    dest->nstores = 0;
+    memcpy(dest->data, ctx->state->vreg[vd], nregs * VLENB);
+    return dest->data;
+}
+
+static inline void vec_no_dest(DisasContext *ctx) {
+    ctx->vdest->nregs = 0;
+    ctx->vdest->nstores = 0;
+}
+
+static inline void vec_set_gpr(DisasContext *ctx, int rd, uint64_t data) {
+    ctx->info->dst_idx[0] = rd * 8;
+    ctx->info->dst_mask[0] = 0xffffffffffffffff;
+    ctx->info->dst_data[0] = data;
+    ctx->info->dst_reg = rd;
+}
+
+// fixed point saturation sets vxsat
+static inline void vec_set_sat(DisasContext *ctx) {
+    ctx->info->dst_idx[1] = ARCH_VXSAT;
+    ctx->info->dst_mask[1] = 0xffffffffffffffff;
+    ctx->info->dst_data[1] = 1;
+}
+
+// f called with i of the active elements of the body
+template <typename F>
+static inline void vec_loop(DisasContext *ctx, int vm, F f) {
+    uint32_t vl = ctx->state->vl;
+    for (uint32_t i = ctx->state->vstart; i < vl; i++) {
+        if (vm || vec_mask(ctx, i)) {
+            f(i);
+        }
+    }
+}
+
+// element types of each sew
+struct VecSigned {
+    typedef int8_t e8;
+    typedef int16_t e16;
+    typedef int32_t e32;
+    typedef int64_t e64;
+};
+
+struct VecUnsigned {
+    typedef uint8_t e8;
+    typedef uint16_t e16;
+    typedef uint32_t e32;
+    typedef uint64_t e64;
+};
+
+// f called with std::type_identity of the element type of sew
+template <typename S, typename F>
+static inline void vec_dispatch(int sew, F f) {
+    switch (sew) {
+    case 0: f(std::type_identity<typename S::e8>()); break;
+    case 1: f(std::type_identity<typename S::e16>()); break;
+    case 2: f(std::type_identity<typename S::e32>()); break;
+    default: f(std::type_identity<typename S::e64>()); break;
+    }
+}
+
+// f called with the unsigned types of sew and 2 * sew, sew is at most e32
+template <typename F>
+static inline void vec_dispatch_w(int sew, F f) {
+    switch (sew) {
+    case 0: f(std::type_identity<uint8_t>(), std::type_identity<uint16_t>()); break;
+    case 1: f(std::type_identity<uint16_t>(), std::type_identity<uint32_t>()); break;
+    default: f(std::type_identity<uint32_t>(), std::type_identity<uint64_t>()); break;
+    }
+}
+
+/* vsetvl */
+
+static bool do_vsetvl(DisasContext *ctx, int rd, int rs1, uint64_t avl, uint64_t vtype) {
+    REQUIRE_VS
+    int sew = (vtype >> 3) & 7;
+    int lmul = (((int)vtype & 7) ^ 4) - 4;
+    uint64_t vl;
+    if ((vtype >> 8) != 0 || sew > 3 || lmul == -4 || (lmul < 0 && sew > 3 + lmul)) {
+        vtype = 1ULL << 63;
+        vl = 0;
+    } else {
+        uint32_t vlmax = vec_vlmax(sew, lmul);
+        if (rs1 != 0) {
+            vl = avl < vlmax ? avl : vlmax;
+        } else if (rd != 0) {
+            vl = vlmax;
+        } else {
+            vl = ctx->state->vl < vlmax ? ctx->state->vl : vlmax;
+        }
+    }
+    vec_no_dest(ctx);
+    vec_set_gpr(ctx, rd, vl);
+    ctx->info->dst_idx[1] = ARCH_VL;
+    ctx->info->dst_mask[1] = 0xffffffffffffffff;
+    ctx->info->dst_data[1] = vl;
+    ctx->info->dst_idx[2] = ARCH_VTYPE;
+    ctx->info->dst_mask[2] = 0xffffffffffffffff;
+    ctx->info->dst_data[2] = vtype;
+    ctx->info->type = VSET;
+    return true;
+}
+
+static bool trans_vsetvl(DisasContext *ctx, arg_vsetvl *a) {
+    SET_SRC2_DST
+    return do_vsetvl(ctx, a->rd, a->rs1, ctx->state->gpr[a->rs1], ctx->state->gpr[a->rs2]);
+}
+
+static bool trans_vsetvli(DisasContext *ctx, arg_vsetvli *a) {
+    SET_SRC1_DST
+    return do_vsetvl(ctx, a->rd, a->rs1, ctx->state->gpr[a->rs1], a->zimm);
+}
+
+static bool trans_vsetivli(DisasContext *ctx, arg_vsetivli *a) {
+    SET_SRC0_DST
+    // the avl is an immediate, it is used even when it is zero
+    return do_vsetvl(ctx, a->rd, 1, a->rs1, a->zimm);
+}
+
+/* vector load and store */
+
+// host pointer of [va, va + size) when it is in one ram page hitting the dtlb
+static inline uint8_t* vec_host(DisasContext *ctx, uint64_t va, uint32_t size) {
+    if (((va ^ (va + size - 1)) >> TLB_PGSHFT) != 0) {
+        return nullptr;
+    }
+    TLBEntry *entry = &ctx->tlb->dtlb[(va >> TLB_PGSHFT) & TLB_MASK];
+    if (tlb_hit(ctx->tlb, entry, entry->tag_read, va) && entry->host != nullptr) {
+        return entry->host + (va & TLB_PGMASK);
+    }
+    return nullptr;
+}
+
+template <typename T>
+static inline bool vec_ld(DisasContext *ctx, uint64_t va, T &data) {
+    if (unlikely(va & (sizeof(T) - 1))) {
+        ctx->info->exception = EXC_LAM;
+    } else {
+        data = ld_mem<T>(ctx, va);
+    }
+    if (unlikely(ctx->info->exception != EXC_NONE)) {
+        ctx->info->exc_data = va;
+        return false;
+    }
+    return true;
+}
+
+// physical address of a store of size bytes at va, all in one page
+static inline bool vec_st_paddr(DisasContext *ctx, uint64_t va, uint32_t align, uint64_t &pa) {
+    if (unlikely(va & (align - 1))) {
+        ctx->info->exception = EXC_SAM;
+        ctx->info->exc_data = va;
+        return false;
+    }
+    TLBEntry *entry = &ctx->tlb->dtlb[(va >> TLB_PGSHFT) & TLB_MASK];
+    if (likely(tlb_hit(ctx->tlb, entry, entry->tag_write, va))) {
+        pa = entry->paddr | (va & TLB_PGMASK);
+        return true;
+    }
+    uint64_t exception = EXC_NONE;
+    ctx->arch->translateAddr(va, FETCH_TYPE::SFETCH, pa, exception);
+    if (unlikely(ctx->arch->exceptionValid(exception))) {
+        ctx->info->exception = EXC_SPF;
+        ctx->info->exc_data = va;
+        return false;
+    }
+    return true;
+}
+
+static inline void vec_store_add(VecDest *dest, uint64_t pa, const uint8_t *src, uint32_t size) {
+    uint16_t offset = 0;
+    if (dest->nstores != 0) {
+        VecStore &last = dest->stores[dest->nstores - 1];
+        offset = last.offset + last.size;
+    }
+    VecStore &store = dest->stores[dest->nstores++];
+    store.paddr = pa;
+    store.offset = offset;
+    store.size = size;
+    memcpy(dest->data + offset, src, size);
+}
+
+/**
+ * @brief load nf fields of evl elements, field f of element i is at addr(i) + f * sizeof(T)
+ *
+ * Field f goes to the group at vd + f * nregs. contiguous means nf is 1 and
+ * addr(i) is addr(0) + i * sizeof(T), so an unmasked load in one page is a
+ * single copy. With first_fault a fault after element 0 trims vl instead.
+ */
+template <typename T, typename A>
+static void vec_load(DisasContext *ctx, int vd, int vm, int nf, int nregs, uint32_t evl, bool contiguous, bool first_fault, A addr) {
+    uint8_t *d = vec_dest(ctx, vd, nf * nregs);
+    uint32_t vstart = ctx->state->vstart;
+    if (contiguous && vm && vstart < evl) {
+        uint64_t va = addr(vstart);
+        uint32_t size = (evl - vstart) * sizeof(T);
+        uint8_t *host = (va & (sizeof(T) - 1)) == 0 ? vec_host(ctx, va, size) : nullptr;
+        if (host != nullptr) {
+            memcpy(d + vstart * sizeof(T), host, size);
+            return;
+        }
+    }
+    for (uint32_t i = vstart; i < evl; i++) {
+        if (!vm && !vec_mask(ctx, i)) {
+            continue;
+        }
+        for (int f = 0; f < nf; f++) {
+            T data = 0;
+            if (unlikely(!vec_ld<T>(ctx, addr(i) + f * sizeof(T), data))) {
+                if (first_fault && i != 0) {
+                    ctx->info->exception = EXC_NONE;
+                    ctx->info->dst_idx[1] = ARCH_VL;
+                    ctx->info->dst_mask[1] = 0xffffffffffffffff;
+                    ctx->info->dst_data[1] = i;
+                }
+                return;
+            }
+            ((T*)(d + f * nregs * VLENB))[i] = data;
+        }
+    }
+}
+
+/**
+ * @brief store with the same layout as vec_load, only the physical addresses are recorded
+ */
+template <typename T, typename A>
+static void vec_store(DisasContext *ctx, int vs3, int vm, int nf, int nregs, uint32_t evl, bool contiguous, A addr) {
+    VecDest *dest = ctx->vdest;
+    const uint8_t *s = ctx->state->vreg[vs3];
+    uint32_t vstart = ctx->state->vstart;
+    uint64_t pa;
+    vec_no_dest(ctx);
+    if (contiguous && vm && vstart < evl) {
+        uint64_t va = addr(vstart);
+        uint32_t size = (evl - vstart) * sizeof(T);
+        if (((va ^ (va + size - 1)) >> TLB_PGSHFT) == 0) {
+            if (vec_st_paddr(ctx, va, sizeof(T), pa)) {
+                vec_store_add(dest, pa, s + vstart * sizeof(T), size);
+            }
+            return;
+        }
+    }
+    for (uint32_t i = vstart; i < evl; i++) {
+        if (!vm && !vec_mask(ctx, i)) {
+            continue;
+        }
+        for (int f = 0; f < nf; f++) {
+            if (unlikely(!vec_st_paddr(ctx, addr(i) + f * sizeof(T), sizeof(T), pa))) {
+                dest->nstores = 0;
+                return;
+            }
+            vec_store_add(dest, pa, s + f * nregs * VLENB + i * sizeof(T), sizeof(T));
+        }
+    }
+}
+
+// unit stride and strided, stride 0 is unit stride
+template <typename T>
+static bool vec_ldst(DisasContext *ctx, int vd, int vm, int rs1, int nf, bool strided, int64_t stride, bool store, bool first_fault) {
+    REQUIRE_VECTOR
+    int emul = vec_lmul(ctx) + std::countr_zero(sizeof(T)) - vec_sew(ctx);
+    VEC_CHECK(emul >= -3 && emul <= 3)
+    int nregs = vec_nregs(emul);
+    VEC_CHECK(vec_aligned(vd, emul) && nf * nregs <= 8 && vd + nf * nregs <= 32 && (store || vm || vd != 0))
+    uint64_t base = ctx->state->gpr[rs1];
+    if (!strided) {
+        stride = nf * sizeof(T);
+    }
+    auto addr = [=](uint32_t i) { return base + i * stride; };
+    bool contiguous = !strided && nf == 1;
+    if (store) {
+        vec_store<T>(ctx, vd, vm, nf, nregs, ctx->state->vl, contiguous, addr);
+        ctx->info->type = VSTORE;
+    } else {
+        vec_load<T>(ctx, vd, vm, nf, nregs, ctx->state->vl, contiguous, first_fault, addr);
+        ctx->info->type = VLOAD;
+    }
+    ctx->info->src_reg[0] = rs1;
+    return true;
+}
+
+// data elements have sew, index elements have the width of I
+template <typename I>
+static bool vec_ldst_index(DisasContext *ctx, arg_rnfvm *a, bool store) {
+    REQUIRE_VECTOR
+    int sew = vec_sew(ctx), lmul = vec_lmul(ctx);
+    int iemul = lmul + std::countr_zero(sizeof(I)) - sew;
+    VEC_CHECK(iemul >= -3 && iemul <= 3 && vec_aligned(a->rs2, iemul))
+    int nregs = vec_nregs(lmul);
+    VEC_CHECK(vec_aligned(a->rd, lmul) && a->nf * nregs <= 8 && a->rd + a->nf * nregs <= 32 && (store || a->vm || a->rd != 0))
+    uint64_t base = ctx->state->gpr[a->rs1];
+    const I *index = (const I*)ctx->state->vreg[a->rs2];
+    auto addr = [=](uint32_t i) { return base + (uint64_t)index[i]; };
+    vec_dispatch<VecUnsigned>(sew, [&](auto t) {
+        using T = typename decltype(t)::type;
+        if (store) {
+            vec_store<T>(ctx, a->rd, a->vm, a->nf, nregs, ctx->state->vl, false, addr);
+        } else {
+            vec_load<T>(ctx, a->rd, a->vm, a->nf, nregs, ctx->state->vl, false, false, addr);
+        }
+    });
+    ctx->info->type = store ? VSTORE : VLOAD;
+    ctx->info->src_reg[0] = a->rs1;
+    return true;
+}
+
+// whole register load and store ignore vtype and vl
+template <typename T>
+static bool vec_ldst_whole(DisasContext *ctx, int vd, int rs1, int nregs, bool store) {
+    REQUIRE_VS
+    VEC_CHECK((vd & (nregs - 1)) == 0)
+    uint64_t base = ctx->state->gpr[rs1];
+    auto addr = [=](uint32_t i) { return base + i * sizeof(T); };
+    uint32_t evl = nregs * VLENB / sizeof(T);
+    if (store) {
+        vec_store<T>(ctx, vd, 1, 1, nregs, evl, true, addr);
+        ctx->info->type = VSTORE;
+    } else {
+        vec_load<T>(ctx, vd, 1, 1, nregs, evl, true, false, addr);
+        ctx->info->type = VLOAD;
+    }
+    ctx->info->src_reg[0] = rs1;
+    return true;
+}
+
+#define GEN_VEC_LDST(bits) \
+static bool trans_vle##bits##_v(DisasContext *ctx, arg_vle##bits##_v *a) { \
+    return vec_ldst<uint##bits##_t>(ctx, a->rd, a->vm, a->rs1, a->nf, false, 0, false, false); \
+} \
+static bool trans_vle##bits##ff_v(DisasContext *ctx, arg_vle##bits##ff_v *a) { \
+    return vec_ldst<uint##bits##_t>(ctx, a->rd, a->vm, a->rs1, a->nf, false, 0, false, true); \
+} \
+static bool trans_vse##bits##_v(DisasContext *ctx, arg_vse##bits##_v *a) { \
+    return vec_ldst<uint##bits##_t>(ctx, a->rd, a->vm, a->rs1, a->nf, false, 0, true, false); \
+} \
+static bool trans_vlse##bits##_v(DisasContext *ctx, arg_vlse##bits##_v *a) { \
+    return vec_ldst<uint##bits##_t>(ctx, a->rd, a->vm, a->rs1, a->nf, true, ctx->state->gpr[a->rs2], false, false); \
+} \
+static bool trans_vsse##bits##_v(DisasContext *ctx, arg_vsse##bits##_v *a) { \
+    return vec_ldst<uint##bits##_t>(ctx, a->rd, a->vm, a->rs1, a->nf, true, ctx->state->gpr[a->rs2], true, false); \
+} \
+static bool trans_vlxei##bits##_v(DisasContext *ctx, arg_vlxei##bits##_v *a) { \
+    return vec_ldst_index<uint##bits##_t>(ctx, a, false); \
+} \
+static bool trans_vsxei##bits##_v(DisasContext *ctx, arg_vsxei##bits##_v *a) { \
+    return vec_ldst_index<uint##bits##_t>(ctx, a, true); \
+} \
+static bool trans_vl1re##bits##_v(DisasContext *ctx, arg_vl1re##bits##_v *a) { \
+    return vec_ldst_whole<uint##bits##_t>(ctx, a->rd, a->rs1, 1, false); \
+} \
+static bool trans_vl2re##bits##_v(DisasContext *ctx, arg_vl2re##bits##_v *a) { \
+    return vec_ldst_whole<uint##bits##_t>(ctx, a->rd, a->rs1, 2, false); \
+} \
+static bool trans_vl4re##bits##_v(DisasContext *ctx, arg_vl4re##bits##_v *a) { \
+    return vec_ldst_whole<uint##bits##_t>(ctx, a->rd, a->rs1, 4, false); \
+} \
+static bool trans_vl8re##bits##_v(DisasContext *ctx, arg_vl8re##bits##_v *a) { \
+    return vec_ldst_whole<uint##bits##_t>(ctx, a->rd, a->rs1, 8, false); \
+}
+
+GEN_VEC_LDST(8)
+GEN_VEC_LDST(16)
+GEN_VEC_LDST(32)
+GEN_VEC_LDST(64)
+
+static bool trans_vs1r_v(DisasContext *ctx, arg_vs1r_v *a) {
+    return vec_ldst_whole<uint8_t>(ctx, a->rd, a->rs1, 1, true);
+}
+static bool trans_vs2r_v(DisasContext *ctx, arg_vs2r_v *a) {
+    return vec_ldst_whole<uint8_t>(ctx, a->rd, a->rs1, 2, true);
+}
+static bool trans_vs4r_v(DisasContext *ctx, arg_vs4r_v *a) {
+    return vec_ldst_whole<uint8_t>(ctx, a->rd, a->rs1, 4, true);
+}
+static bool trans_vs8r_v(DisasContext *ctx, arg_vs8r_v *a) {
+    return vec_ldst_whole<uint8_t>(ctx, a->rd, a->rs1, 8, true);
+}
+
+// mask load and store, evl is vl bytes rounded up
+static bool vec_ldst_mask(DisasContext *ctx, arg_r2 *a, bool store) {
+    REQUIRE_VECTOR
+    uint64_t base = ctx->state->gpr[a->rs1];
+    auto addr = [=](uint32_t i) { return base + i; };
+    uint32_t evl = (ctx->state->vl + 7) / 8;
+    if (store) {
+        vec_store<uint8_t>(ctx, a->rd, 1, 1, 1, evl, true, addr);
+        ctx->info->type = VSTORE;
+    } else {
+        vec_load<uint8_t>(ctx, a->rd, 1, 1, 1, evl, true, false, addr);
+        ctx->info->type = VLOAD;
+    }
+    ctx->info->src_reg[0] = a->rs1;
+    return true;
+}
+
+static bool trans_vlm_v(DisasContext *ctx, arg_vlm_v *a) {
+    return vec_ldst_mask(ctx, a, false);
+}
+static bool trans_vsm_v(DisasContext *ctx, arg_vsm_v *a) {
+    return vec_ldst_mask(ctx, a, true);
+}
+
+/* vector integer */
+
+template <typename T>
+struct VecReg {
+    typedef T type __attribute__((vector_size(VLENB)));
+};
+
+/**
+ * @brief vd[i] = op(vs2[i], src1[i], vd[i]) on whole registers
+ *
+ * op gets gcc vectors of a register so it compiles to simd code. A register
+ * partly outside the body or masked is merged element by element. src1 is
+ * s1, or scalar when s1 is nullptr.
+ */
+template <typename T, typename F>
+static inline void vec_kernel(DisasContext *ctx, int vm, T *d, const T *s2, const T *s1, T scalar, int nregs, F op) {
+    typedef typename VecReg<T>::type V;
+    constexpr uint32_t N = VLENB / sizeof(T);
+    uint32_t vstart = ctx->state->vstart;
+    uint32_t vl = ctx->state->vl;
+    for (int r = 0; r < nregs; r++) {
+        uint32_t lo = r * N;
+        if (lo + N <= vstart || lo >= vl) {
+            continue;
+        }
+        V x, y, z;
+        memcpy(&x, s2 + lo, VLENB);
+        if (s1 != nullptr) {
+            memcpy(&y, s1 + lo, VLENB);
+        } else {
+            y = V{} + scalar;
+        }
+        memcpy(&z, d + lo, VLENB);
+        V res = op(x, y, z);
+        if (vm && lo >= vstart && lo + N <= vl) {
+            memcpy(d + lo, &res, VLENB);
+        } else {
+            for (uint32_t j = 0; j < N; j++) {
+                uint32_t i = lo + j;
+                if (i >= vstart && i < vl && (vm || vec_mask(ctx, i))) {
+                    d[i] = res[j];
+                }
+            }
+        }
+    }
+}
+
+// single width integer op, vd = op(vs2, vs1 / x[rs1] / imm, vd)
+template <typename S, typename F>
+static bool vec_opi(DisasContext *ctx, arg_rmrr *a, int form, InstType type, F op) {
+    REQUIRE_VECTOR
+    int lmul = vec_lmul(ctx);
+    VEC_CHECK(vec_check_vd(a->rd, a->vm, lmul) && vec_aligned(a->rs2, lmul) &&
+              (form != VEC_VV || vec_aligned(a->rs1, lmul)))
+    int nregs = vec_nregs(lmul);
+    uint8_t *d = vec_dest(ctx, a->rd, nregs);
+    uint64_t scalar = vec_scalar(ctx, form, a->rs1);
+    vec_dispatch<S>(vec_sew(ctx), [&](auto t) {
+        using T = typename decltype(t)::type;
+        vec_kernel<T>(ctx, a->vm, (T*)d, (const T*)ctx->state->vreg[a->rs2],
+                      form == VEC_VV ? (const T*)ctx->state->vreg[a->rs1] : nullptr, (T)scalar, nregs, op);
+    });
+    ctx->info->type = type;
+    return true;
+}
+
+// single width op without a simd form, op(ctx, vs2[i], src1, vd[i])
+template <typename S, typename F>
+static bool vec_opi_elem(DisasContext *ctx, arg_rmrr *a, int form, InstType type, F op) {
+    REQUIRE_VECTOR
+    int lmul = vec_lmul(ctx);
+    VEC_CHECK(vec_check_vd(a->rd, a->vm, lmul) && vec_aligned(a->rs2, lmul) &&
+              (form != VEC_VV || vec_aligned(a->rs1, lmul)))
+    uint8_t *d = vec_dest(ctx, a->rd, vec_nregs(lmul));
+    uint64_t scalar = vec_scalar(ctx, form, a->rs1);
+    vec_dispatch<S>(vec_sew(ctx), [&](auto t) {
+        using T = typename decltype(t)::type;
+        T *dt = (T*)d;
+        const T *s2 = (const T*)ctx->state->vreg[a->rs2];
+        const T *s1 = (const T*)ctx->state->vreg[a->rs1];
+        vec_loop(ctx, a->vm, [&](uint32_t i) {
+            dt[i] = op(ctx, s2[i], form == VEC_VV ? s1[i] : (T)scalar, dt[i]);
+        });
+    });
+    ctx->info->type = type;
+    return true;
+}
+
+// compare, vd.mask[i] = op(vs2[i], src1[i])
+template <typename S, typename F>
+static bool vec_opi_cmp(DisasContext *ctx, arg_rmrr *a, int form, F op) {
+    REQUIRE_VECTOR
+    int lmul = vec_lmul(ctx);
+    VEC_CHECK(vec_aligned(a->rs2, lmul) && (form != VEC_VV || vec_aligned(a->rs1, lmul)))
+    uint8_t *d = vec_dest(ctx, a->rd, 1);
+    uint64_t scalar = vec_scalar(ctx, form, a->rs1);
+    vec_dispatch<S>(vec_sew(ctx), [&](auto t) {
+        using T = typename decltype(t)::type;
+        typedef typename VecReg<T>::type V;
+        constexpr uint32_t N = VLENB / sizeof(T);
+        const T *s2 = (const T*)ctx->state->vreg[a->rs2];
+        const T *s1 = (const T*)ctx->state->vreg[a->rs1];
+        uint32_t vstart = ctx->state->vstart;
+        uint32_t vl = ctx->state->vl;
+        for (uint32_t lo = vstart / N * N; lo < vl; lo += N) {
+            V x, y;
+            memcpy(&x, s2 + lo, VLENB);
+            if (form == VEC_VV) {
+                memcpy(&y, s1 + lo, VLENB);
+            } else {
+                y = V{} + (T)scalar;
+            }
+            auto res = op(x, y);
+            for (uint32_t j = 0; j < N; j++) {
+                uint32_t i = lo + j;
+                if (i >= vstart && i < vl && (a->vm || vec_mask(ctx, i))) {
+                    vec_set_bit(d, i, res[j] != 0);
+                }
+            }
+        }
+    });
+    ctx->info->type = VALU;
+    return true;
+}
+
+#define GEN_OPI(name, form, S, type, expr) \
+static bool trans_##name(DisasContext *ctx, arg_##name *a) { \
+    return vec_opi<S>(ctx, a, form, type, [](auto x, auto y, auto d) { return expr; }); \
+}
+
+#define GEN_OPI_ELEM(name, form, S, type, expr) \
+static bool trans_##name(DisasContext *ctx, arg_##name *a) { \
+    return vec_opi_elem<S>(ctx, a, form, type, [](DisasContext *ctx, auto x, auto y, auto d) { \
+        return (decltype(x))(expr); \
+    }); \
+}
+
+#define GEN_OPI_CMP(name, form, S, expr) \
+static bool trans_##name(DisasContext *ctx, arg_##name *a) { \
+    return vec_opi_cmp<S>(ctx, a, form, [](auto x, auto y) { return expr; }); \
+}
+
+#define GEN_OPI_VV_VX(name, S, type, expr) \
+GEN_OPI(name##_vv, VEC_VV, S, type, expr) \
+GEN_OPI(name##_vx, VEC_VX, S, type, expr)
+
+#define GEN_OPI_VV_VX_VI(name, S, type, expr) \
+GEN_OPI_VV_VX(name, S, type, expr) \
+GEN_OPI(name##_vi, VEC_VI, S, type, expr)
+
+#define GEN_OPI_SHIFT(name, S, expr) \
+GEN_OPI(name##_vv, VEC_VV, S, VALU, expr) \
+GEN_OPI(name##_vx, VEC_VX, S, VALU, expr) \
+GEN_OPI(name##_vi, VEC_VIU, S, VALU, expr)
+
+#define GEN_OPI_ELEM_VV_VX(name, S, type, expr) \
+GEN_OPI_ELEM(name##_vv, VEC_VV, S, type, expr) \
+GEN_OPI_ELEM(name##_vx, VEC_VX, S, type, expr)
+
+// shift amount, the low log2(sew) bits of y
+#define VEC_SHAMT(x, y) ((y) & (sizeof((x)[0]) * 8 - 1))
+
+GEN_OPI_VV_VX_VI(vadd, VecUnsigned, VALU, x + y)
+GEN_OPI_VV_VX(vsub, VecUnsigned, VALU, x - y)
+GEN_OPI(vrsub_vx, VEC_VX, VecUnsigned, VALU, y - x)
+GEN_OPI(vrsub_vi, VEC_VI, VecUnsigned, VALU, y - x)
+GEN_OPI_VV_VX_VI(vand, VecUnsigned, VALU, x & y)
+GEN_OPI_VV_VX_VI(vor, VecUnsigned, VALU, x | y)
+GEN_OPI_VV_VX_VI(vxor, VecUnsigned, VALU, x ^ y)
+GEN_OPI_SHIFT(vsll, VecUnsigned, x << VEC_SHAMT(x, y))
+GEN_OPI_SHIFT(vsrl, VecUnsigned, x >> VEC_SHAMT(x, y))
+GEN_OPI_SHIFT(vsra, VecSigned, x >> VEC_SHAMT(x, y))
+GEN_OPI_VV_VX(vminu, VecUnsigned, VALU, x < y ? x : y)
+GEN_OPI_VV_VX(vmin, VecSigned, VALU, x < y ? x : y)
+GEN_OPI_VV_VX(vmaxu, VecUnsigned, VALU, x > y ? x : y)
+GEN_OPI_VV_VX(vmax, VecSigned, VALU, x > y ? x : y)
+GEN_OPI_VV_VX(vmul, VecUnsigned, VMUL, x * y)
+GEN_OPI_VV_VX(vmacc, VecUnsigned, VMUL, y * x + d)
+GEN_OPI_VV_VX(vnmsac, VecUnsigned, VMUL, d - y * x)
+GEN_OPI_VV_VX(vmadd, VecUnsigned, VMUL, y * d + x)
+GEN_OPI_VV_VX(vnmsub, VecUnsigned, VMUL, x - y * d)
+
+GEN_OPI_CMP(vmseq_vv, VEC_VV, VecUnsigned, x == y)
+GEN_OPI_CMP(vmseq_vx, VEC_VX, VecUnsigned, x == y)
+GEN_OPI_CMP(vmseq_vi, VEC_VI, VecUnsigned, x == y)
+GEN_OPI_CMP(vmsne_vv, VEC_VV, VecUnsigned, x != y)
+GEN_OPI_CMP(vmsne_vx, VEC_VX, VecUnsigned, x != y)
+GEN_OPI_CMP(vmsne_vi, VEC_VI, VecUnsigned, x != y)
+GEN_OPI_CMP(vmsltu_vv, VEC_VV, VecUnsigned, x < y)
+GEN_OPI_CMP(vmsltu_vx, VEC_VX, VecUnsigned, x < y)
+GEN_OPI_CMP(vmslt_vv, VEC_VV, VecSigned, x < y)
+GEN_OPI_CMP(vmslt_vx, VEC_VX, VecSigned, x < y)
+GEN_OPI_CMP(vmsleu_vv, VEC_VV, VecUnsigned, x <= y)
+GEN_OPI_CMP(vmsleu_vx, VEC_VX, VecUnsigned, x <= y)
+GEN_OPI_CMP(vmsleu_vi, VEC_VI, VecUnsigned, x <= y)
+GEN_OPI_CMP(vmsle_vv, VEC_VV, VecSigned, x <= y)
+GEN_OPI_CMP(vmsle_vx, VEC_VX, VecSigned, x <= y)
+GEN_OPI_CMP(vmsle_vi, VEC_VI, VecSigned, x <= y)
+GEN_OPI_CMP(vmsgtu_vx, VEC_VX, VecUnsigned, x > y)
+GEN_OPI_CMP(vmsgtu_vi, VEC_VI, VecUnsigned, x > y)
+GEN_OPI_CMP(vmsgt_vx, VEC_VX, VecSigned, x > y)
+GEN_OPI_CMP(vmsgt_vi, VEC_VI, VecSigned, x > y)
+
+template <typename T>
+static inline T vec_div(T x, T y) {
+    if (y == 0) {
+        return (T)-1;
+    }
+    if (std::is_signed_v<T> && x == std::numeric_limits<T>::min() && y == (T)-1) {
+        return x;
+    }
+    return x / y;
+}
+
+template <typename T>
+static inline T vec_rem(T x, T y) {
+    if (y == 0) {
+        return x;
+    }
+    if (std::is_signed_v<T> && y == (T)-1) {
+        return 0;
+    }
+    return x % y;
+}
+
+template <typename T>
+static inline T vec_mulh(T x, T y) {
+    if constexpr (sizeof(T) == 8) {
+        typedef std::conditional_t<std::is_signed_v<T>, __int128, unsigned __int128> W;
+        return (W)x * y >> 64;
+    } else {
+        typedef std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t> W;
+        return (W)x * y >> (sizeof(T) * 8);
+    }
+}
+
+// x signed, y unsigned
+template <typename T>
+static inline T vec_mulhsu(T x, T y) {
+    typedef std::make_unsigned_t<T> U;
+    if constexpr (sizeof(T) == 8) {
+        return (__int128)x * (__int128)(U)y >> 64;
+    } else {
+        return (int64_t)x * (int64_t)(U)y >> (sizeof(T) * 8);
+    }
+}
+
+GEN_OPI_ELEM_VV_VX(vdivu, VecUnsigned, VDIV, vec_div(x, y))
+GEN_OPI_ELEM_VV_VX(vdiv, VecSigned, VDIV, vec_div(x, y))
+GEN_OPI_ELEM_VV_VX(vremu, VecUnsigned, VDIV, vec_rem(x, y))
+GEN_OPI_ELEM_VV_VX(vrem, VecSigned, VDIV, vec_rem(x, y))
+GEN_OPI_ELEM_VV_VX(vmulhu, VecUnsigned, VMUL, vec_mulh(x, y))
+GEN_OPI_ELEM_VV_VX(vmulh, VecSigned, VMUL, vec_mulh(x, y))
+GEN_OPI_ELEM_VV_VX(vmulhsu, VecSigned, VMUL, vec_mulhsu(x, y))
+
+/* fixed point */
+
+// v >> d rounded by vxrm
+template <typename W>
+static inline W vec_roundoff(DisasContext *ctx, W v, int d) {
+    if (d == 0) {
+        return v;
+    }
+    W r;
+    switch (ctx->state->vxrm & 3) {
+    case 0: // rnu
+        r = (v >> (d - 1)) & 1;
+        break;
+    case 1: // rne
+        r = ((v >> (d - 1)) & 1) & ((d > 1 && (v & (((W)1 << (d - 1)) - 1)) != 0) | ((v >> d) & 1));
+        break;
+    case 2: // rdn
+        r = 0;
+        break;
+    default: // rod
+        r = !((v >> d) & 1) & ((v & (((W)1 << d) - 1)) != 0);
+        break;
+    }
+    return (v >> d) + r;
+}
+
+template <typename T>
+static inline T vec_sadd(DisasContext *ctx, T x, T y) {
+    T r;
+    if (__builtin_add_overflow(x, y, &r)) {
+        vec_set_sat(ctx);
+        return std::is_signed_v<T> && x < 0 ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+    }
+    return r;
+}
+
+template <typename T>
+static inline T vec_ssub(DisasContext *ctx, T x, T y) {
+    T r;
+    if (__builtin_sub_overflow(x, y, &r)) {
+        vec_set_sat(ctx);
+        return std::is_signed_v<T> && x >= 0 ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
+    }
+    return r;
+}
+
+// signed fractional multiply, only min * min overflows
+template <typename T>
+static inline T vec_smul(DisasContext *ctx, T x, T y) {
+    __int128 r = vec_roundoff(ctx, (__int128)x * y, sizeof(T) * 8 - 1);
+    if (r > std::numeric_limits<T>::max()) {
+        vec_set_sat(ctx);
+        return std::numeric_limits<T>::max();
+    }
+    return r;
+}
+
+GEN_OPI_ELEM_VV_VX(vsaddu, VecUnsigned, VALU, vec_sadd(ctx, x, y))
+GEN_OPI_ELEM(vsaddu_vi, VEC_VI, VecUnsigned, VALU, vec_sadd(ctx, x, y))
+GEN_OPI_ELEM_VV_VX(vsadd, VecSigned, VALU, vec_sadd(ctx, x, y))
+GEN_OPI_ELEM(vsadd_vi, VEC_VI, VecSigned, VALU, vec_sadd(ctx, x, y))
+GEN_OPI_ELEM_VV_VX(vssubu, VecUnsigned, VALU, vec_ssub(ctx, x, y))
+GEN_OPI_ELEM_VV_VX(vssub, VecSigned, VALU, vec_ssub(ctx, x, y))
+GEN_OPI_ELEM_VV_VX(vaaddu, VecUnsigned, VALU, vec_roundoff(ctx, (__int128)x + y, 1))
+GEN_OPI_ELEM_VV_VX(vaadd, VecSigned, VALU, vec_roundoff(ctx, (__int128)x + y, 1))
+GEN_OPI_ELEM_VV_VX(vasubu, VecUnsigned, VALU, vec_roundoff(ctx, (__int128)x - y, 1))
+GEN_OPI_ELEM_VV_VX(vasub, VecSigned, VALU, vec_roundoff(ctx, (__int128)x - y, 1))
+GEN_OPI_ELEM_VV_VX(vsmul, VecSigned, VMUL, vec_smul(ctx, x, y))
+GEN_OPI_ELEM_VV_VX(vssrl, VecUnsigned, VALU, vec_roundoff(ctx, (__int128)x, y & (sizeof(x) * 8 - 1)))
+GEN_OPI_ELEM(vssrl_vi, VEC_VIU, VecUnsigned, VALU, vec_roundoff(ctx, (__int128)x, y & (sizeof(x) * 8 - 1)))
+GEN_OPI_ELEM_VV_VX(vssra, VecSigned, VALU, vec_roundoff(ctx, (__int128)x, y & (sizeof(x) * 8 - 1)))
+GEN_OPI_ELEM(vssra_vi, VEC_VIU, VecSigned, VALU, vec_roundoff(ctx, (__int128)x, y & (sizeof(x) * 8 - 1)))
+
+/* carry and merge, they use v0 as an operand and run on every element of the body */
+
+// vd[i] = op(vs2[i], src1, v0[i])
+template <typename F>
+static bool vec_opi_carry(DisasContext *ctx, arg_rmrr *a, int form, F op) {
+    REQUIRE_VECTOR
+    int lmul = vec_lmul(ctx);
+    VEC_CHECK(vec_check_vd(a->rd, 0, lmul) && vec_aligned(a->rs2, lmul) &&
+              (form != VEC_VV || vec_aligned(a->rs1, lmul)))
+    uint8_t *d = vec_dest(ctx, a->rd, vec_nregs(lmul));
+    uint64_t scalar = vec_scalar(ctx, form, a->rs1);
+    vec_dispatch<VecUnsigned>(vec_sew(ctx), [&](auto t) {
+        using T = typename decltype(t)::type;
+        const T *s2 = (const T*)ctx->state->vreg[a->rs2];
+        const T *s1 = (const T*)ctx->state->vreg[a->rs1];
+        vec_loop(ctx, 1, [&](uint32_t i) {
+            ((T*)d)[i] = op(s2[i], form == VEC_VV ? s1[i] : (T)scalar, (T)vec_mask(ctx, i));
+        });
+    });
+    ctx->info->type = VALU;
+    return true;
+}
+
+// vd.mask[i] = op(vs2[i], src1, carry), the carry in is v0[i] when vm is 0
+template <typename F>
+static bool vec_opi_carry_out(DisasContext *ctx, arg_rmrr *a, int form, F op) {
+    REQUIRE_VECTOR
+    int lmul = vec_lmul(ctx);
+    VEC_CHECK(vec_aligned(a->rs2, lmul) && (form != VEC_VV || vec_aligned(a->rs1, lmul)))
+    uint8_t *d = vec_dest(ctx, a->rd, 1);
+    uint64_t scalar = vec_scalar(ctx, form, a->rs1);
+    vec_dispatch<VecUnsigned>(vec_sew(ctx), [&](auto t) {
+        using T = typename decltype(t)::type;
+        const T *s2 = (const T*)ctx->state->vreg[a->rs2];
+        const T *s1 = (const T*)ctx->state->vreg[a->rs1];
+        vec_loop(ctx, 1, [&](uint32_t i) {
+            bool c = !a->vm && vec_mask(ctx, i);
+            vec_set_bit(d, i, op(s2[i], form == VEC_VV ? s1[i] : (T)scalar, c));
+        });
+    });
+    ctx->info->type = VALU;
+    return true;
+}
+
+#define GEN_OPI_CARRY(name, form, expr) \
+static bool trans_##name(DisasContext *ctx, arg_##name *a) { \
+    return vec_opi_carry(ctx, a, form, [](auto x, auto y, auto c) { return (decltype(x))(expr); }); \
+}
+
+#define GEN_OPI_CARRY_OUT(name, form, expr) \
+static bool trans_##name(DisasContext *ctx, arg_##name *a) { \
+    return vec_opi_carry_out(ctx, a, form, [](auto x, auto y, bool c) -> bool { return expr; }); \
+}
+
+GEN_OPI_CARRY(vmerge_vvm, VEC_VV, c ? y : x)
+GEN_OPI_CARRY(vmerge_vxm, VEC_VX, c ? y : x)
+GEN_OPI_CARRY(vmerge_vim, VEC_VI, c ? y : x)
+GEN_OPI_CARRY(vadc_vvm, VEC_VV, x + y + c)
+GEN_OPI_CARRY(vadc_vxm, VEC_VX, x + y + c)
+GEN_OPI_CARRY(vadc_vim, VEC_VI, x + y + c)
+GEN_OPI_CARRY(vsbc_vvm, VEC_VV, x - y - c)
+GEN_OPI_CARRY(vsbc_vxm, VEC_VX, x - y - c)
+GEN_OPI_CARRY_OUT(vmadc_vvm, VEC_VV, (decltype(x))(x + y + c) < x || (c && (decltype(x))(x + y + c) == x))
+GEN_OPI_CARRY_OUT(vmadc_vxm, VEC_VX, (decltype(x))(x + y + c) < x || (c && (decltype(x))(x + y + c) == x))
+GEN_OPI_CARRY_OUT(vmadc_vim, VEC_VI, (decltype(x))(x + y + c) < x || (c && (decltype(x))(x + y + c) == x))
+GEN_OPI_CARRY_OUT(vmsbc_vvm, VEC_VV, x < y || (c && x == y))
+GEN_OPI_CARRY_OUT(vmsbc_vxm, VEC_VX, x < y || (c && x == y))
+
+// vmv.v.* copies src1 to every element of the body
+static bool vec_mv(DisasContext *ctx, arg_r2 *a, int form) {
+    REQUIRE_VECTOR
+    int lmul = vec_lmul(ctx);
+    VEC_CHECK(vec_aligned(a->rd, lmul) && (form != VEC_VV || vec_aligned(a->rs1, lmul)))
+    int nregs = vec_nregs(lmul);
+    uint8_t *d = vec_dest(ctx, a->rd, nregs);
+    uint64_t scalar = vec_scalar(ctx, form, a->rs1);
+    vec_dispatch<VecUnsigned>(vec_sew(ctx), [&](auto t) {
+        using T = typename decltype(t)::type;
+        vec_kernel<T>(ctx, 1, (T*)d, (const T*)d, form == VEC_VV ? (const T*)ctx->state->vreg[a->rs1] : nullptr,
+                      (T)scalar, nregs, [](auto x, auto y, auto z) { return y; });
+    });
+    ctx->info->type = VALU;
+    return true;
+}
+
+static bool trans_vmv_v_v(DisasContext *ctx, arg_vmv_v_v *a) {
+    return vec_mv(ctx, a, VEC_VV);
+}
+static bool trans_vmv_v_x(DisasContext *ctx, arg_vmv_v_x *a) {
+    return vec_mv(ctx, a, VEC_VX);
+}
+static bool trans_vmv_v_i(DisasContext *ctx, arg_vmv_v_i *a) {
+    return vec_mv(ctx, a, VEC_VI);
+}
+
+/* widening and narrowing integer */
+
+/**
+ * @brief widening op, vd (2 * sew) = op(vs2, src1, vd) with both operands extended to 2 * sew
+ *
+ * S2 and S1 tell whether vs2 and src1 are sign extended, vs2 already has
+ * 2 * sew when wide. op works on the unsigned 2 * sew type.
+ */
+template <bool S2, bool S1, typename F>
+static bool vec_opw(DisasContext *ctx, arg_rmrr *a, int form, bool wide, InstType type, F op) {
+    REQUIRE_VECTOR
+    int sew = vec_sew(ctx), lmul = vec_lmul(ctx);
+    VEC_CHECK(sew < 3 && lmul < 3 && vec_check_vd(a->rd, a->vm, lmul + 1) &&
+              vec_aligned(a->rs2, wide ? lmul + 1 : lmul) && (form != VEC_VV || vec_aligned(a->rs1, lmul)))
+    uint8_t *d = vec_dest(ctx, a->rd, vec_nregs(lmul + 1));
+    uint64_t scalar = vec_scalar(ctx, form, a->rs1);
+    vec_dispatch_w(sew, [&](auto n, auto w) {
+        using N = typename decltype(n)::type;
+        using W = typename decltype(w)::type;
+        typedef std::conditional_t<S2, std::make_signed_t<N>, N> N2;
+        typedef std::conditional_t<S1, std::make_signed_t<N>, N> N1;
+        const uint8_t *s2 = ctx->state->vreg[a->rs2];
+        const N *s1 = (const N*)ctx->state->vreg[a->rs1];
+        vec_loop(ctx, a->vm, [&](uint32_t i) {
+            W x = wide ? ((const W*)s2)[i] : (W)(N2)((const N*)s2)[i];
+            W y = (W)(N1)(form == VEC_VV ? s1[i] : (N)scalar);
+            ((W*)d)[i] = op(x, y, ((W*)d)[i]);
+        });
+    });
+    ctx->info->type = type;
+    return true;
+}
+
+#define GEN_OPW(name, form, S2, S1, wide, type, expr) \
+static bool trans_##name(DisasContext *ctx, arg_##name *a) { \
+    return vec_opw<S2, S1>(ctx, a, form, wide, type, [](auto x, auto y, auto d) { return (decltype(x))(expr); }); \
+}
+
+#define GEN_OPW_ADD(name, S, expr) \
+GEN_OPW(name##_vv, VEC_VV, S, S, false, VALU, expr) \
+GEN_OPW(name##_vx, VEC_VX, S, S, false, VALU, expr) \
+GEN_OPW(name##_wv, VEC_VV, S, S, true, VALU, expr) \
+GEN_OPW(name##_wx, VEC_VX, S, S, true, VALU, expr)
+
+GEN_OPW_ADD(vwaddu, false, x + y)
+GEN_OPW_ADD(vwadd, true, x + y)
+GEN_OPW_ADD(vwsubu, false, x - y)
+GEN_OPW_ADD(vwsub, true, x - y)
+GEN_OPW(vwmulu_vv, VEC_VV, false, false, false, VMUL, x * y)
+GEN_OPW(vwmulu_vx, VEC_VX, false, false, false, VMUL, x * y)
+GEN_OPW(vwmul_vv, VEC_VV, true, true, false, VMUL, x * y)
+GEN_OPW(vwmul_vx, VEC_VX, true, true, false, VMUL, x * y)
+GEN_OPW(vwmulsu_vv, VEC_VV, true, false, false, VMUL, x * y)
+GEN_OPW(vwmulsu_vx, VEC_VX, true, false, false, VMUL, x * y)
+GEN_OPW(vwmaccu_vv, VEC_VV, false, false, false, VMUL, y * x + d)
+GEN_OPW(vwmaccu_vx, VEC_VX, false, false, false, VMUL, y * x + d)
+GEN_OPW(vwmacc_vv, VEC_VV, true, true, false, VMUL, y * x + d)
+GEN_OPW(vwmacc_vx, VEC_VX, true, true, false, VMUL, y * x + d)
+GEN_OPW(vwmaccsu_vv, VEC_VV, false, true, false, VMUL, y * x + d)
+GEN_OPW(vwmaccsu_vx, VEC_VX, false, true, false, VMUL, y * x + d)
+GEN_OPW(vwmaccus_vx, VEC_VX, true, false, false, VMUL, y * x + d)
+
+/**
+ * @brief narrowing op, vd (sew) = op(ctx, vs2 (2 * sew), shift) with shift the low log2(2 * sew) bits of src1
+ */
+template <bool S, typename F>
+static bool vec_opn(DisasContext *ctx, arg_rmrr *a, int form, F op) {
+    REQUIRE_VECTOR
+    int sew = vec_sew(ctx), lmul = vec_lmul(ctx);
+    VEC_CHECK(sew < 3 && lmul < 3 && vec_check_vd(a->rd, a->vm, lmul) &&
+              vec_aligned(a->rs2, lmul + 1) && (form != VEC_VV || vec_aligned(a->rs1, lmul)))
+    uint8_t *d = vec_dest(ctx, a->rd, vec_nregs(lmul));
+    uint64_t scalar = vec_scalar(ctx, form, a->rs1);
+    vec_dispatch_w(sew, [&](auto n, auto w) {
+        using N = typename decltype(n)::type;
+        using W = typename decltype(w)::type;
+        typedef std::conditional_t<S, std::make_signed_t<W>, W> WS;
+        typedef std::conditional_t<S, std::make_signed_t<N>, N> NS;
+        const W *s2 = (const W*)ctx->state->vreg[a->rs2];
+        const N *s1 = (const N*)ctx->state->vreg[a->rs1];
+        vec_loop(ctx, a->vm, [&](uint32_t i) {
+            int shift = (form == VEC_VV ? s1[i] : scalar) & (sizeof(W) * 8 - 1);
+            ((N*)d)[i] = op(ctx, (WS)s2[i], shift, NS());
+        });
+    });
+    ctx->info->type = VALU;
+    return true;
+}
+
+// clip the rounded x to the range of N
+template <typename N>
+static inline N vec_clip(DisasContext *ctx, __int128 x) {
+    if (x > std::numeric_limits<N>::max()) {
+        vec_set_sat(ctx);
+        return std::numeric_limits<N>::max();
+    }
+    if (x < std::numeric_limits<N>::min()) {
+        vec_set_sat(ctx);
+        return std::numeric_limits<N>::min();
+    }
+    return x;
+}
+
+#define GEN_OPN(name, S, expr) \
+static bool trans_##name##_wv(DisasContext *ctx, arg_##name##_wv *a) { \
+    return vec_opn<S>(ctx, a, VEC_VV, [](DisasContext *ctx, auto x, int y, auto n) { return (decltype(n))(expr); }); \
+} \
+static bool trans_##name##_wx(DisasContext *ctx, arg_##name##_wx *a) { \
+    return vec_opn<S>(ctx, a, VEC_VX, [](DisasContext *ctx, auto x, int y, auto n) { return (decltype(n))(expr); }); \
+} \
+static bool trans_##name##_wi(DisasContext *ctx, arg_##name##_wi *a) { \
+    return vec_opn<S>(ctx, a, VEC_VIU, [](DisasContext *ctx, auto x, int y, auto n) { return (decltype(n))(expr); }); \
+}
+
+GEN_OPN(vnsrl, false, x >> y)
+GEN_OPN(vnsra, true, x >> y)
+GEN_OPN(vnclipu, false, vec_clip<decltype(n)>(ctx, vec_roundoff(ctx, (__int128)x, y)))
+GEN_OPN(vnclip, true, vec_clip<decltype(n)>(ctx, vec_roundoff(ctx, (__int128)x, y)))
+
+// vzext and vsext, vs2 has sew / 2^frac
+template <bool S>
+static bool vec_ext(DisasContext *ctx, arg_rmr *a, int frac) {
+    REQUIRE_VECTOR
+    int sew = vec_sew(ctx), lmul = vec_lmul(ctx);
+    VEC_CHECK(sew >= frac && lmul - frac >= -3 && vec_check_vd(a->rd, a->vm, lmul) &&
+              vec_aligned(a->rs2, lmul - frac))
+    uint8_t *d = vec_dest(ctx, a->rd, vec_nregs(lmul));
+    const uint8_t *s2 = ctx->state->vreg[a->rs2];
+    vec_dispatch<VecUnsigned>(sew, [&](auto t) {
+        using T = typename decltype(t)::type;
+        vec_loop(ctx, a->vm, [&](uint32_t i) {
+            uint64_t x;
+            switch (sew - frac) {
+            case 0: x = S ? (uint64_t)((const int8_t*)s2)[i] : s2[i]; break;
+            case 1: x = S ? (uint64_t)((const int16_t*)s2)[i] : ((const uint16_t*)s2)[i]; break;
+            default: x = S ? (uint64_t)((const int32_t*)s2)[i] : ((const uint32_t*)s2)[i]; break;
+            }
+            ((T*)d)[i] = x;
+        });
+    });
+    ctx->info->type = VALU;
+    return true;
+}
+
+static bool trans_vzext_vf2(DisasContext *ctx, arg_vzext_vf2 *a) {
+    return vec_ext<false>(ctx, a, 1);
+}
+static bool trans_vzext_vf4(DisasContext *ctx, arg_vzext_vf4 *a) {
+    return vec_ext<false>(ctx, a, 2);
+}
+static bool trans_vzext_vf8(DisasContext *ctx, arg_vzext_vf8 *a) {
+    return vec_ext<false>(ctx, a, 3);
+}
+static bool trans_vsext_vf2(DisasContext *ctx, arg_vsext_vf2 *a) {
+    return vec_ext<true>(ctx, a, 1);
+}
+static bool trans_vsext_vf4(DisasContext *ctx, arg_vsext_vf4 *a) {
+    return vec_ext<true>(ctx, a, 2);
+}
+static bool trans_vsext_vf8(DisasContext *ctx, arg_vsext_vf8 *a) {
+    return vec_ext<true>(ctx, a, 3);
+}
+
+/* reduction */
+
+// vd[0] = op(...op(vs1[0], vs2[0])..., vs2[vl - 1]) over the active elements
+template <typename S, typename F>
+static bool vec_red(DisasContext *ctx, arg_rmrr *a, F op) {
+    REQUIRE_VECTOR
+    VEC_CHECK(ctx->state->vstart == 0 && vec_aligned(a->rs2, vec_lmul(ctx)))
+    uint8_t *d = vec_dest(ctx, a->rd, 1);
+    if (ctx->state->vl != 0) {
+        vec_dispatch<S>(vec_sew(ctx), [&](auto t) {
+            using T = typename decltype(t)::type;
+            const T *s2 = (const T*)ctx->state->vreg[a->rs2];
+            T acc = ((const T*)ctx->state->vreg[a->rs1])[0];
+            vec_loop(ctx, a->vm, [&](uint32_t i) { acc = op(acc, s2[i]); });
+            ((T*)d)[0] = acc;
+        });
+    }
+    ctx->info->type = VRED;
+    return true;
+}
+
+#define GEN_OPI_RED(name, S, expr) \
+static bool trans_##name(DisasContext *ctx, arg_##name *a) { \
+    return vec_red<S>(ctx, a, [](auto x, auto y) { return (decltype(x))(expr); }); \
+}
+
+GEN_OPI_RED(vredsum_vs, VecUnsigned, x + y)
+GEN_OPI_RED(vredand_vs, VecUnsigned, x & y)
+GEN_OPI_RED(vredor_vs, VecUnsigned, x | y)
+GEN_OPI_RED(vredxor_vs, VecUnsigned, x ^ y)
+GEN_OPI_RED(vredminu_vs, VecUnsigned, x < y ? x : y)
+GEN_OPI_RED(vredmin_vs, VecSigned, x < y ? x : y)
+GEN_OPI_RED(vredmaxu_vs, VecUnsigned, x > y ? x : y)
+GEN_OPI_RED(vredmax_vs, VecSigned, x > y ? x : y)
+
+// vd[0] (2 * sew) = vs1[0] + sum of the extended vs2 elements
+template <bool S>
+static bool vec_wredsum(DisasContext *ctx, arg_rmrr *a) {
+    REQUIRE_VECTOR
+    int sew = vec_sew(ctx), lmul = vec_lmul(ctx);
+    VEC_CHECK(sew < 3 && ctx->state->vstart == 0 && vec_aligned(a->rs2, lmul))
+    uint8_t *d = vec_dest(ctx, a->rd, 1);
+    if (ctx->state->vl != 0) {
+        vec_dispatch_w(sew, [&](auto n, auto w) {
+            using N = typename decltype(n)::type;
+            using W = typename decltype(w)::type;
+            typedef std::conditional_t<S, std::make_signed_t<N>, N> NS;
+            const N *s2 = (const N*)ctx->state->vreg[a->rs2];
+            W acc = ((const W*)ctx->state->vreg[a->rs1])[0];
+            vec_loop(ctx, a->vm, [&](uint32_t i) { acc += (W)(NS)s2[i]; });
+            ((W*)d)[0] = acc;
+        });
+    }
+    ctx->info->type = VRED;
+    return true;
+}
+
+static bool trans_vwredsumu_vs(DisasContext *ctx, arg_vwredsumu_vs *a) {
+    return vec_wredsum<false>(ctx, a);
+}
+static bool trans_vwredsum_vs(DisasContext *ctx, arg_vwredsum_vs *a) {
+    return vec_wredsum<true>(ctx, a);
+}
+
+/* mask */
+
+// bits of the 64 bit word at lo which are in [start, end)
+static inline uint64_t vec_range_mask(uint32_t lo, uint32_t start, uint32_t end) {
+    if (end <= lo) {
+        return 0;
+    }
+    uint32_t s = start > lo ? start - lo : 0;
+    uint32_t e = end < lo + 64 ? end - lo : 64;
+    if (s >= e) {
+        return 0;
+    }
+    return (e == 64 ? ~0ULL : (1ULL << e) - 1) & ~((1ULL << s) - 1);
+}
+
+// vd = op(vs2, vs1) on the mask bits of the body
+template <typename F>
+static bool vec_opmm(DisasContext *ctx, arg_r *a, F op) {
+    REQUIRE_VECTOR
+    uint8_t *d = vec_dest(ctx, a->rd, 1);
+    for (uint32_t lo = 0; lo < VLEN; lo += 64) {
+        uint64_t m = vec_range_mask(lo, ctx->state->vstart, ctx->state->vl);
+        if (m == 0) {
+            continue;
+        }
+        uint64_t x, y, z;
+        memcpy(&x, ctx->state->vreg[a->rs2] + lo / 8, 8);
+        memcpy(&y, ctx->state->vreg[a->rs1] + lo / 8, 8);
+        memcpy(&z, d + lo / 8, 8);
+        z = (z & ~m) | (op(x, y) & m);
+        memcpy(d + lo / 8, &z, 8);
+    }
+    ctx->info->type = VALU;
+    return true;
+}
+
+#define GEN_OPMM(name, expr) \
+static bool trans_##name(DisasContext *ctx, arg_##name *a) { \
+    return vec_opmm(ctx, a, [](uint64_t x, uint64_t y) { return expr; }); \
+}
+
+GEN_OPMM(vmand_mm, x & y)
+GEN_OPMM(vmnand_mm, ~(x & y))
+GEN_OPMM(vmandn_mm, x & ~y)
+GEN_OPMM(vmxor_mm, x ^ y)
+GEN_OPMM(vmor_mm, x | y)
+GEN_OPMM(vmnor_mm, ~(x | y))
+GEN_OPMM(vmorn_mm, x | ~y)
+GEN_OPMM(vmxnor_mm, ~(x ^ y))
+
+// active bits of vs2 in [0, vl), word by word
+template <typename F>
+static inline void vec_mask_words(DisasContext *ctx, arg_rmr *a, F f) {
+    for (uint32_t lo = 0; lo < ctx->state->vl; lo += 64) {
+        uint64_t x, m;
+        memcpy(&x, ctx->state->vreg[a->rs2] + lo / 8, 8);
+        m = vec_range_mask(lo, 0, ctx->state->vl);
+        if (!a->vm) {
+            uint64_t v0;
+            memcpy(&v0, ctx->state->vreg[0] + lo / 8, 8);
+            m &= v0;
+        }
+        if (!f(lo, x & m)) {
+            break;
+        }
+    }
+}
+
+static bool trans_vcpop_m(DisasContext *ctx, arg_vcpop_m *a) {
+    REQUIRE_VECTOR
+    VEC_CHECK(ctx->state->vstart == 0)
+    uint64_t count = 0;
+    vec_mask_words(ctx, a, [&](uint32_t lo, uint64_t x) {
+        count += std::popcount(x);
+        return true;
+    });
+    vec_no_dest(ctx);
+    vec_set_gpr(ctx, a->rd, count);
+    ctx->info->type = VALU;
+    return true;
+}
+
+static bool trans_vfirst_m(DisasContext *ctx, arg_vfirst_m *a) {
+    REQUIRE_VECTOR
+    VEC_CHECK(ctx->state->vstart == 0)
+    int64_t first = -1;
+    vec_mask_words(ctx, a, [&](uint32_t lo, uint64_t x) {
+        if (x != 0) {
+            first = lo + std::countr_zero(x);
+            return false;
+        }
+        return true;
+    });
+    vec_no_dest(ctx);
+    vec_set_gpr(ctx, a->rd, first);
+    ctx->info->type = VALU;
+    return true;
+}
+
+// vmsbf, vmsif and vmsof, set the bits before, up to or at the first set bit of vs2
+static bool vec_msxf(DisasContext *ctx, arg_rmr *a, bool before, bool at, bool after) {
+    REQUIRE_VECTOR
+    VEC_CHECK(ctx->state->vstart == 0 && a->rd != a->rs2 && (a->vm || a->rd != 0))
+    uint8_t *d = vec_dest(ctx, a->rd, 1);
+    const uint8_t *s2 = ctx->state->vreg[a->rs2];
+    bool found = false;
+    vec_loop(ctx, a->vm, [&](uint32_t i) {
+        if (found) {
+            vec_set_bit(d, i, after);
+        } else if (vec_bit(s2, i)) {
+            found = true;
+            vec_set_bit(d, i, at);
+        } else {
+            vec_set_bit(d, i, before);
+        }
+    });
+    ctx->info->type = VALU;
+    return true;
+}
+
+static bool trans_vmsbf_m(DisasContext *ctx, arg_vmsbf_m *a) {
+    return vec_msxf(ctx, a, true, false, false);
+}
+static bool trans_vmsif_m(DisasContext *ctx, arg_vmsif_m *a) {
+    return vec_msxf(ctx, a, true, true, false);
+}
+static bool trans_vmsof_m(DisasContext *ctx, arg_vmsof_m *a) {
+    return vec_msxf(ctx, a, false, true, false);
+}
+
+static bool trans_viota_m(DisasContext *ctx, arg_viota_m *a) {
+    REQUIRE_VECTOR
+    int lmul = vec_lmul(ctx);
+    int nregs = vec_nregs(lmul);
+    VEC_CHECK(ctx->state->vstart == 0 && vec_check_vd(a->rd, a->vm, lmul) && !vec_overlap(a->rd, nregs, a->rs2, 1))
+    uint8_t *d = vec_dest(ctx, a->rd, nregs);
+    const uint8_t *s2 = ctx->state->vreg[a->rs2];
+    vec_dispatch<VecUnsigned>(vec_sew(ctx), [&](auto t) {
+        using T = typename decltype(t)::type;
+        T count = 0;
+        vec_loop(ctx, a->vm, [&](uint32_t i) {
+            ((T*)d)[i] = count;
+            count += vec_bit(s2, i);
+        });
+    });
+    ctx->info->type = VALU;
+    return true;
+}
+
+static bool trans_vid_v(DisasContext *ctx, arg_vid_v *a) {
+    REQUIRE_VECTOR
+    int lmul = vec_lmul(ctx);
+    VEC_CHECK(vec_check_vd(a->rd, a->vm, lmul))
+    uint8_t *d = vec_dest(ctx, a->rd, vec_nregs(lmul));
+    vec_dispatch<VecUnsigned>(vec_sew(ctx), [&](auto t) {
+        using T = typename decltype(t)::type;
+        vec_loop(ctx, a->vm, [&](uint32_t i) { ((T*)d)[i] = i; });
+    });
+    ctx->info->type = VALU;
+    return true;
+}
+
+/* permutation */
+
+static bool trans_vmv_x_s(DisasContext *ctx, arg_vmv_x_s *a) {
+    REQUIRE_VECTOR
+    uint64_t dest;
+    vec_dispatch<VecSigned>(vec_sew(ctx), [&](auto t) {
+        using T = typename decltype(t)::type;
+        dest = ((const T*)ctx->state->vreg[a->rs2])[0];
+    });
+    vec_no_dest(ctx);
+    vec_set_gpr(ctx, a->rd, dest);
+    ctx->info->type = VPERM;
+    return true;
+}
+
+static bool trans_vmv_s_x(DisasContext *ctx, arg_vmv_s_x *a) {
+    REQUIRE_VECTOR
+    uint8_t *d = vec_dest(ctx, a->rd, 1);
+    if (ctx->state->vstart < ctx->state->vl) {
+        vec_dispatch<VecUnsigned>(vec_sew(ctx), [&](auto t) {
+            using T = typename decltype(t)::type;
+            ((T*)d)[0] = ctx->state->gpr[a->rs1];
+        });
+    }
+    ctx->info->src_reg[0] = a->rs1;
+    ctx->info->type = VPERM;
+    return true;
+}
+
+// vd[i] = vs2[i - offset] for i >= offset, src1 goes to vd[0] for vslide1up
+static bool vec_slideup(DisasContext *ctx, arg_rmrr *a, uint64_t offset, bool slide1, uint64_t src1) {
+    REQUIRE_VECTOR
+    int lmul = vec_lmul(ctx);
+    int nregs = vec_nregs(lmul);
+    VEC_CHECK(vec_check_vd(a->rd, a->vm, lmul) && vec_aligned(a->rs2, lmul) && !vec_overlap(a->rd, nregs, a->rs2, nregs))
+    uint8_t *d = vec_dest(ctx, a->rd, nregs);
+    vec_dispatch<VecUnsigned>(vec_sew(ctx), [&](auto t) {
+        using T = typename decltype(t)::type;
+        const T *s2 = (const T*)ctx->state->vreg[a->rs2];
+        vec_loop(ctx, a->vm, [&](uint32_t i) {
+            if (i >= offset) {
+                ((T*)d)[i] = s2[i - offset];
+            } else if (slide1) {
+                ((T*)d)[i] = src1;
+            }
+        });
+    });
+    ctx->info->type = VPERM;
+    return true;
+}
+
+// vd[i] = vs2[i + offset], 0 past vlmax, src1 goes to vd[vl - 1] for vslide1down
+static bool vec_slidedown(DisasContext *ctx, arg_rmrr *a, uint64_t offset, bool slide1, uint64_t src1) {
+    REQUIRE_VECTOR
+    int sew = vec_sew(ctx), lmul = vec_lmul(ctx);
+    VEC_CHECK(vec_check_vd(a->rd, a->vm, lmul) && vec_aligned(a->rs2, lmul))
+    uint8_t *d = vec_dest(ctx, a->rd, vec_nregs(lmul));
+    uint32_t vlmax = vec_vlmax(sew, lmul);
+    uint32_t vl = ctx->state->vl;
+    vec_dispatch<VecUnsigned>(sew, [&](auto t) {
+        using T = typename decltype(t)::type;
+        const T *s2 = (const T*)ctx->state->vreg[a->rs2];
+        vec_loop(ctx, a->vm, [&](uint32_t i) {
+            if (slide1 && i == vl - 1) {
+                ((T*)d)[i] = src1;
+            } else {
+                ((T*)d)[i] = offset < vlmax - i ? s2[i + offset] : 0;
+            }
+        });
+    });
+    ctx->info->type = VPERM;
+    return true;
+}
+
+static bool trans_vslideup_vx(DisasContext *ctx, arg_vslideup_vx *a) {
+    return vec_slideup(ctx, a, ctx->state->gpr[a->rs1], false, 0);
+}
+static bool trans_vslideup_vi(DisasContext *ctx, arg_vslideup_vi *a) {
+    return vec_slideup(ctx, a, a->rs1, false, 0);
+}
+static bool trans_vslide1up_vx(DisasContext *ctx, arg_vslide1up_vx *a) {
+    return vec_slideup(ctx, a, 1, true, ctx->state->gpr[a->rs1]);
+}
+static bool trans_vslidedown_vx(DisasContext *ctx, arg_vslidedown_vx *a) {
+    return vec_slidedown(ctx, a, ctx->state->gpr[a->rs1], false, 0);
+}
+static bool trans_vslidedown_vi(DisasContext *ctx, arg_vslidedown_vi *a) {
+    return vec_slidedown(ctx, a, a->rs1, false, 0);
+}
+static bool trans_vslide1down_vx(DisasContext *ctx, arg_vslide1down_vx *a) {
+    return vec_slidedown(ctx, a, 1, true, ctx->state->gpr[a->rs1]);
+}
+
+// vd[i] = vs2[index(i)], 0 when the index is not below vlmax
+template <typename I>
+static bool vec_rgather(DisasContext *ctx, arg_rmrr *a, int form) {
+    REQUIRE_VECTOR
+    int sew = vec_sew(ctx), lmul = vec_lmul(ctx);
+    int nregs = vec_nregs(lmul);
+    int iemul = sizeof(I) == 2 ? lmul + 1 - sew : lmul;
+    int inregs = vec_nregs(iemul);
+    VEC_CHECK(iemul >= -3 && iemul <= 3 && vec_check_vd(a->rd, a->vm, lmul) && vec_aligned(a->rs2, lmul) &&
+              !vec_overlap(a->rd, nregs, a->rs2, nregs) &&
+              (form != VEC_VV || (vec_aligned(a->rs1, iemul) && !vec_overlap(a->rd, nregs, a->rs1, inregs))))
+    uint8_t *d = vec_dest(ctx, a->rd, nregs);
+    uint32_t vlmax = vec_vlmax(sew, lmul);
+    uint64_t scalar = form == VEC_VX ? ctx->state->gpr[a->rs1] : a->rs1;
+    vec_dispatch<VecUnsigned>(sew, [&](auto t) {
+        using T = typename decltype(t)::type;
+        typedef std::conditional_t<sizeof(I) == 2, uint16_t, T> IT;
+        const T *s2 = (const T*)ctx->state->vreg[a->rs2];
+        const IT *s1 = (const IT*)ctx->state->vreg[a->rs1];
+        vec_loop(ctx, a->vm, [&](uint32_t i) {
+            uint64_t index = form == VEC_VV ? s1[i] : scalar;
+            ((T*)d)[i] = index < vlmax ? s2[index] : 0;
+        });
+    });
+    ctx->info->type = VPERM;
+    return true;
+}
+
+static bool trans_vrgather_vv(DisasContext *ctx, arg_vrgather_vv *a) {
+    return vec_rgather<uint64_t>(ctx, a, VEC_VV);
+}
+static bool trans_vrgather_vx(DisasContext *ctx, arg_vrgather_vx *a) {
+    return vec_rgather<uint64_t>(ctx, a, VEC_VX);
+}
+static bool trans_vrgather_vi(DisasContext *ctx, arg_vrgather_vi *a) {
+    return vec_rgather<uint64_t>(ctx, a, VEC_VIU);
+}
+static bool trans_vrgatherei16_vv(DisasContext *ctx, arg_vrgatherei16_vv *a) {
+    return vec_rgather<uint16_t>(ctx, a, VEC_VV);
+}
+
+static bool trans_vcompress_vm(DisasContext *ctx, arg_vcompress_vm *a) {
+    REQUIRE_VECTOR
+    int lmul = vec_lmul(ctx);
+    int nregs = vec_nregs(lmul);
+    VEC_CHECK(ctx->state->vstart == 0 && vec_aligned(a->rd, lmul) && vec_aligned(a->rs2, lmul) &&
+              !vec_overlap(a->rd, nregs, a->rs2, nregs) && !vec_overlap(a->rd, nregs, a->rs1, 1))
+    uint8_t *d = vec_dest(ctx, a->rd, nregs);
+    const uint8_t *s1 = ctx->state->vreg[a->rs1];
+    vec_dispatch<VecUnsigned>(vec_sew(ctx), [&](auto t) {
+        using T = typename decltype(t)::type;
+        const T *s2 = (const T*)ctx->state->vreg[a->rs2];
+        uint32_t j = 0;
+        vec_loop(ctx, 1, [&](uint32_t i) {
+            if (vec_bit(s1, i)) {
+                ((T*)d)[j++] = s2[i];
+            }
+        });
+    });
+    ctx->info->type = VPERM;
+    return true;
+}
+
+// whole register move, it ignores vtype except for the element size of vstart
+static bool vec_mvnr(DisasContext *ctx, arg_decode_insn3223 *a, int nregs) {
+    REQUIRE_VS
+    VEC_CHECK((a->rd & (nregs - 1)) == 0 && (a->rs2 & (nregs - 1)) == 0)
+    uint8_t *d = vec_dest(ctx, a->rd, nregs);
+    uint32_t offset = ctx->state->vstart << vec_sew(ctx);
+    if (offset < (uint32_t)nregs * VLENB) {
+        memcpy(d + offset, ctx->state->vreg[a->rs2] + offset, nregs * VLENB - offset);
+    }
+    ctx->info->type = VPERM;
+    return true;
+}
+
+static bool trans_vmv1r_v(DisasContext *ctx, arg_vmv1r_v *a) {
+    return vec_mvnr(ctx, a, 1);
+}
+static bool trans_vmv2r_v(DisasContext *ctx, arg_vmv2r_v *a) {
+    return vec_mvnr(ctx, a, 2);
+}
+static bool trans_vmv4r_v(DisasContext *ctx, arg_vmv4r_v *a) {
+    return vec_mvnr(ctx, a, 4);
+}
+static bool trans_vmv8r_v(DisasContext *ctx, arg_vmv8r_v *a) {
+    return vec_mvnr(ctx, a, 8);
+}
+
+/* vector float, T is the bits of f32 or f64 */
+
+#define GEN_VEC_FOP2(op) \
+template <typename T> \
+static inline T vec_f##op(T a, T b, float_status *s) { \
+    if constexpr (sizeof(T) == 4) return float32_##op(a, b, s); \
+    else return float64_##op(a, b, s); \
+}
+
+#define GEN_VEC_FCMP(op) \
+template <typename T> \
+static inline bool vec_f##op(T a, T b, float_status *s) { \
+    if constexpr (sizeof(T) == 4) return float32_##op(a, b, s); \
+    else return float64_##op(a, b, s); \
+}
+
+GEN_VEC_FOP2(add)
+GEN_VEC_FOP2(sub)
+GEN_VEC_FOP2(mul)
+GEN_VEC_FOP2(div)
+GEN_VEC_FOP2(minimum_number)
+GEN_VEC_FOP2(maximum_number)
+GEN_VEC_FCMP(eq_quiet)
+GEN_VEC_FCMP(lt)
+GEN_VEC_FCMP(le)
+
+template <typename T>
+static inline T vec_fmuladd(T a, T b, T c, int flags, float_status *s) {
+    if constexpr (sizeof(T) == 4) return float32_muladd(a, b, c, flags, s);
+    else return float64_muladd(a, b, c, flags, s);
+}
+
+template <typename T>
+static inline T vec_fsqrt(T a, float_status *s) {
+    if constexpr (sizeof(T) == 4) return float32_sqrt(a, s);
+    else return float64_sqrt(a, s);
+}
+
+// add, sub, mul and div try the host fpu first like the scalar ops
+template <typename T>
+static inline T vec_fop(DisasContext *ctx, HostFpOp op, T a, T b) {
+    TCGv dest;
+    float_status *s = &ctx->state->fp_status;
+    if constexpr (sizeof(T) == 4) {
+        if (host_float32(ctx, op, 7, a, b, dest)) return dest;
+    } else {
+        if (host_float64(ctx, op, 7, a, b, dest)) return dest;
+    }
+    switch (op) {
+    case HOST_FADD: return vec_fadd(a, b, s);
+    case HOST_FSUB: return vec_fsub(a, b, s);
+    case HOST_FMUL: return vec_fmul(a, b, s);
+    default: return vec_fdiv(a, b, s);
+    }
+}
+
+template <typename T>
+static inline T vec_fclass(T a, float_status *s) {
+    bool neg, inf, zero, sub, nan, snan;
+    if constexpr (sizeof(T) == 4) {
+        neg = float32_is_neg(a);
+        inf = float32_is_infinity(a);
+        zero = float32_is_zero(a);
+        sub = float32_is_denormal(a);
+        nan = float32_is_any_nan(a);
+        snan = float32_is_signaling_nan(a, s);
+    } else {
+        neg = float64_is_neg(a);
+        inf = float64_is_infinity(a);
+        zero = float64_is_zero(a);
+        sub = float64_is_denormal(a);
+        nan = float64_is_any_nan(a);
+        snan = float64_is_signaling_nan(a, s);
+    }
+    if (inf) return neg ? 1 << 0 : 1 << 7;
+    if (zero) return neg ? 1 << 3 : 1 << 4;
+    if (sub) return neg ? 1 << 2 : 1 << 5;
+    if (nan) return snan ? 1 << 8 : 1 << 9;
+    return neg ? 1 << 1 : 1 << 6;
+}
+
+// 7 bit estimate tables of the rvv spec, indexed by the top mantissa bits
+static constexpr uint8_t frsqrt7_table[128] = {
+    52, 51, 50, 48, 47, 46, 44, 43, 42, 41, 40, 39, 38, 36, 35, 34,
+    33, 32, 31, 30, 30, 29, 28, 27, 26, 25, 24, 23, 23, 22, 21, 20,
+    19, 19, 18, 17, 16, 16, 15, 14, 14, 13, 12, 12, 11, 10, 10, 9,
+    9, 8, 7, 7, 6, 6, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0,
+    127, 125, 123, 121, 119, 118, 116, 114, 113, 111, 109, 108, 106, 105, 103, 102,
+    100, 99, 97, 96, 95, 93, 92, 91, 90, 88, 87, 86, 85, 84, 83, 82,
+    80, 79, 78, 77, 76, 75, 74, 73, 72, 71, 70, 70, 69, 68, 67, 66,
+    65, 64, 63, 63, 62, 61, 60, 59, 59, 58, 57, 56, 56, 55, 54, 53
+};
+static constexpr uint8_t frec7_table[128] = {
+    127, 125, 123, 121, 119, 117, 116, 114, 112, 110, 109, 107, 105, 104, 102, 100,
+    99, 97, 96, 94, 93, 91, 90, 88, 87, 85, 84, 83, 81, 80, 79, 77,
+    76, 75, 74, 72, 71, 70, 69, 68, 66, 65, 64, 63, 62, 61, 60, 59,
+    58, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48, 47, 46, 45, 44, 43,
+    42, 41, 40, 40, 39, 38, 37, 36, 35, 35, 34, 33, 32, 31, 31, 30,
+    29, 28, 28, 27, 26, 25, 25, 24, 23, 23, 22, 21, 21, 20, 19, 19,
+    18, 17, 17, 16, 15, 15, 14, 14, 13, 12, 12, 11, 11, 10, 9, 9,
+    8, 8, 7, 7, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0
+};
+
+/**
+ * @brief split a float into sign, unbiased-free exponent and mantissa,
+ * subnormals are normalized so exp may become negative
+ */
+template <typename T>
+static inline void vec_fsplit(T a, uint64_t& sign, int64_t& exp, uint64_t& frac) {
+    constexpr int frac_size = sizeof(T) == 4 ? 23 : 52;
+    constexpr int exp_size = sizeof(T) == 4 ? 8 : 11;
+    sign = (uint64_t)a >> (frac_size + exp_size);
+    exp = ((uint64_t)a >> frac_size) & ((1ULL << exp_size) - 1);
+    frac = (uint64_t)a & ((1ULL << frac_size) - 1);
+    if (exp == 0 && frac != 0) {
+        while (!((frac >> (frac_size - 1)) & 1)) {
+            exp--;
+            frac <<= 1;
+        }
+        frac = (frac << 1) & ((1ULL << frac_size) - 1);
+    }
+}
+
+template <typename T>
+static inline T vec_frsqrt7(T a, float_status *s) {
+    constexpr int frac_size = sizeof(T) == 4 ? 23 : 52;
+    constexpr int exp_size = sizeof(T) == 4 ? 8 : 11;
+    constexpr T exp_mask = (T)(((1ULL << exp_size) - 1) << frac_size);
+    constexpr T canonical_nan = sizeof(T) == 4 ? (T)0x7fc00000 : (T)0x7ff8000000000000;
+    T cls = vec_fclass(a, s);
+    // -inf, -normal, -subnormal and snan are invalid, any nan gives the canonical one
+    if (cls & ((1 << 0) | (1 << 1) | (1 << 2) | (1 << 8))) {
+        s->float_exception_flags |= float_flag_invalid;
+        return canonical_nan;
+    }
+    if (cls & (1 << 9)) {
+        return canonical_nan;
+    }
+    uint64_t sign;
+    int64_t exp;
+    uint64_t frac;
+    vec_fsplit(a, sign, exp, frac);
+    if (cls & ((1 << 3) | (1 << 4))) {
+        s->float_exception_flags |= float_flag_divbyzero;
+        return (T)(sign << (frac_size + exp_size)) | exp_mask;
+    }
+    if (cls & (1 << 7)) {
+        return 0;
+    }
+    int idx = ((exp & 1) << 6) | (frac >> (frac_size - 6));
+    uint64_t out_frac = (uint64_t)frsqrt7_table[idx] << (frac_size - 7);
+    uint64_t out_exp = (3 * ((1ULL << (exp_size - 1)) - 1) + ~exp) / 2;
+    return (T)((out_exp << frac_size) & exp_mask) | (T)out_frac;
+}
+
+template <typename T>
+static inline T vec_frec7(T a, float_status *s) {
+    constexpr int frac_size = sizeof(T) == 4 ? 23 : 52;
+    constexpr int exp_size = sizeof(T) == 4 ? 8 : 11;
+    constexpr T exp_mask = (T)(((1ULL << exp_size) - 1) << frac_size);
+    constexpr T canonical_nan = sizeof(T) == 4 ? (T)0x7fc00000 : (T)0x7ff8000000000000;
+    T cls = vec_fclass(a, s);
+    uint64_t sign;
+    int64_t exp;
+    uint64_t frac;
+    vec_fsplit(a, sign, exp, frac);
+    T sign_bit = (T)(sign << (frac_size + exp_size));
+    if (cls & ((1 << 0) | (1 << 7))) {
+        return sign_bit;
+    }
+    if (cls & ((1 << 3) | (1 << 4))) {
+        s->float_exception_flags |= float_flag_divbyzero;
+        return sign_bit | exp_mask;
+    }
+    if (cls & ((1 << 8) | (1 << 9))) {
+        if (cls & (1 << 8)) {
+            s->float_exception_flags |= float_flag_invalid;
+        }
+        return canonical_nan;
+    }
+    // subnormals below 2^-(bias+1) overflow to inf or the largest finite value
+    if (exp < -1) {
+        s->float_exception_flags |= float_flag_inexact | float_flag_overflow;
+        FloatRoundMode rm = s->float_rounding_mode;
+        if (rm == float_round_to_zero || (rm == float_round_down && !sign) || (rm == float_round_up && sign)) {
+            return sign_bit | (exp_mask - 1);
+        }
+        return sign_bit | exp_mask;
+    }
+    uint64_t out_frac = (uint64_t)frec7_table[frac >> (frac_size - 7)] << (frac_size - 7);
+    uint64_t out_exp = 2 * ((1ULL << (exp_size - 1)) - 1) + ~exp;
+    // a subnormal result, no underflow since no precision is lost
+    if (out_exp == 0 || out_exp == UINT64_MAX) {
+        out_frac = (out_frac >> 1) | (1ULL << (frac_size - 1));
+        if (out_exp == UINT64_MAX) {
+            out_frac >>= 1;
+            out_exp = 0;
+        }
+    }
+    return sign_bit | (T)((out_exp << frac_size) & exp_mask) | (T)out_frac;
+}
+
+// f called with std::type_identity of the bits of the float of sew
+template <typename F>
+static inline void vec_dispatch_f(int sew, F f) {
+    if (sew == 2) {
+        f(std::type_identity<uint32_t>());
+    } else {
+        f(std::type_identity<uint64_t>());
+    }
+}
+
+// the scalar of a .vf op, f32 has to be nan boxed
+static inline uint64_t vec_fscalar(DisasContext *ctx, int sew, int rs1) {
+    uint64_t f = ctx->state->fpr[rs1];
+    return sew == 2 ? check_nanbox_s(ctx, f) : f;
+}
+
+// fp ops need mstatus.FS and sew of 32 or 64
+#define REQUIRE_VECTOR_FPU \
+    REQUIRE_VECTOR \
+    REQUIRE_FPU \
+    VEC_CHECK(vec_sew(ctx) >= 2)
+
+// single width fp op, vd = op(ctx, vs2, vs1 / f[rs1], vd)
+template <typename F>
+static bool vec_opf(DisasContext *ctx, arg_rmrr *a, bool vf, InstType type, F op) {
+    REQUIRE_VECTOR_FPU
+    int sew = vec_sew(ctx), lmul = vec_lmul(ctx);
+    VEC_CHECK(vec_check_vd(a->rd, a->vm, lmul) && vec_aligned(a->rs2, lmul) && (vf || vec_aligned(a->rs1, lmul)))
+    uint8_t *d = vec_dest(ctx, a->rd, vec_nregs(lmul));
+    uint64_t scalar = vf ? vec_fscalar(ctx, sew, a->rs1) : 0;
+    setrm(ctx, 7);
+    vec_dispatch_f(sew, [&](auto t) {
+        using T = typename decltype(t)::type;
+        const T *s2 = (const T*)ctx->state->vreg[a->rs2];
+        const T *s1 = (const T*)ctx->state->vreg[a->rs1];
+        vec_loop(ctx, a->vm, [&](uint32_t i) {
+            ((T*)d)[i] = op(ctx, s2[i], vf ? (T)scalar : s1[i], ((T*)d)[i]);
+        });
+    });
+    ctx->info->type = type;
+    return true;
+}
+
+// fp compare, vd.mask[i] = op(vs2[i], src1)
+template <typename F>
+static bool vec_opf_cmp(DisasContext *ctx, arg_rmrr *a, bool vf, F op) {
+    REQUIRE_VECTOR_FPU
+    int sew = vec_sew(ctx), lmul = vec_lmul(ctx);
+    VEC_CHECK(vec_aligned(a->rs2, lmul) && (vf || vec_aligned(a->rs1, lmul)))
+    uint8_t *d = vec_dest(ctx, a->rd, 1);
+    uint64_t scalar = vf ? vec_fscalar(ctx, sew, a->rs1) : 0;
+    vec_dispatch_f(sew, [&](auto t) {
+        using T = typename decltype(t)::type;
+        const T *s2 = (const T*)ctx->state->vreg[a->rs2];
+        const T *s1 = (const T*)ctx->state->vreg[a->rs1];
+        vec_loop(ctx, a->vm, [&](uint32_t i) {
+            vec_set_bit(d, i, op(s2[i], vf ? (T)scalar : s1[i], &ctx->state->fp_status));
+        });
+    });
+    ctx->info->type = VFADD;
+    return true;
+}
+
+#define GEN_OPF(name, vf, type, expr) \
+static bool trans_##name(DisasContext *ctx, arg_##name *a) { \
+    return vec_opf(ctx, a, vf, type, [](DisasContext *ctx, auto x, auto y, auto d) { \
+        [[maybe_unused]] float_status *s = &ctx->state->fp_status; \
+        return (decltype(x))(expr); \
+    }); \
+}
+
+#define GEN_OPF_VV_VF(name, type, expr) \
+GEN_OPF(name##_vv, false, type, expr) \
+GEN_OPF(name##_vf, true, type, expr)
+
+#define GEN_OPF_CMP(name, vf, expr) \
+static bool trans_##name(DisasContext *ctx, arg_##name *a) { \
+    return vec_opf_cmp(ctx, a, vf, [](auto x, auto y, float_status *s) -> bool { return expr; }); \
+}
+
+#define VEC_FSIGN(x) ((decltype(x))1 << (sizeof(x) * 8 - 1))
+
+GEN_OPF_VV_VF(vfadd, VFADD, vec_fop(ctx, HOST_FADD, x, y))
+GEN_OPF_VV_VF(vfsub, VFADD, vec_fop(ctx, HOST_FSUB, x, y))
+GEN_OPF(vfrsub_vf, true, VFADD, vec_fop(ctx, HOST_FSUB, y, x))
+GEN_OPF_VV_VF(vfmul, VFMUL, vec_fop(ctx, HOST_FMUL, x, y))
+GEN_OPF_VV_VF(vfdiv, VFDIV, vec_fop(ctx, HOST_FDIV, x, y))
+GEN_OPF(vfrdiv_vf, true, VFDIV, vec_fop(ctx, HOST_FDIV, y, x))
+GEN_OPF_VV_VF(vfmin, VFADD, vec_fminimum_number(x, y, s))
+GEN_OPF_VV_VF(vfmax, VFADD, vec_fmaximum_number(x, y, s))
+GEN_OPF_VV_VF(vfsgnj, VFADD, (x & ~VEC_FSIGN(x)) | (y & VEC_FSIGN(x)))
+GEN_OPF_VV_VF(vfsgnjn, VFADD, (x & ~VEC_FSIGN(x)) | (~y & VEC_FSIGN(x)))
+GEN_OPF_VV_VF(vfsgnjx, VFADD, x ^ (y & VEC_FSIGN(x)))
+GEN_OPF_VV_VF(vfmacc, VFMA, vec_fmuladd(y, x, d, 0, s))
+GEN_OPF_VV_VF(vfnmacc, VFMA, vec_fmuladd(y, x, d, float_muladd_negate_product | float_muladd_negate_c, s))
+GEN_OPF_VV_VF(vfmsac, VFMA, vec_fmuladd(y, x, d, float_muladd_negate_c, s))
+GEN_OPF_VV_VF(vfnmsac, VFMA, vec_fmuladd(y, x, d, float_muladd_negate_product, s))
+GEN_OPF_VV_VF(vfmadd, VFMA, vec_fmuladd(y, d, x, 0, s))
+GEN_OPF_VV_VF(vfnmadd, VFMA, vec_fmuladd(y, d, x, float_muladd_negate_product | float_muladd_negate_c, s))
+GEN_OPF_VV_VF(vfmsub, VFMA, vec_fmuladd(y, d, x, float_muladd_negate_c, s))
+GEN_OPF_VV_VF(vfnmsub, VFMA, vec_fmuladd(y, d, x, float_muladd_negate_product, s))
+
+GEN_OPF_CMP(vmfeq_vv, false, vec_feq_quiet(x, y, s))
+GEN_OPF_CMP(vmfeq_vf, true, vec_feq_quiet(x, y, s))
+GEN_OPF_CMP(vmfne_vv, false, !vec_feq_quiet(x, y, s))
+GEN_OPF_CMP(vmfne_vf, true, !vec_feq_quiet(x, y, s))
+GEN_OPF_CMP(vmflt_vv, false, vec_flt(x, y, s))
+GEN_OPF_CMP(vmflt_vf, true, vec_flt(x, y, s))
+GEN_OPF_CMP(vmfle_vv, false, vec_fle(x, y, s))
+GEN_OPF_CMP(vmfle_vf, true, vec_fle(x, y, s))
+GEN_OPF_CMP(vmfgt_vf, true, vec_flt(y, x, s))
+GEN_OPF_CMP(vmfge_vf, true, vec_fle(y, x, s))
+
+// single width unary fp op, vd = op(vs2, status)
+template <typename F>
+static bool vec_opf_unary(DisasContext *ctx, arg_rmr *a, InstType type, F op) {
+    REQUIRE_VECTOR_FPU
+    int lmul = vec_lmul(ctx);
+    VEC_CHECK(vec_check_vd(a->rd, a->vm, lmul) && vec_aligned(a->rs2, lmul))
+    uint8_t *d = vec_dest(ctx, a->rd, vec_nregs(lmul));
+    setrm(ctx, 7);
+    vec_dispatch_f(vec_sew(ctx), [&](auto t) {
+        using T = typename decltype(t)::type;
+        const T *s2 = (const T*)ctx->state->vreg[a->rs2];
+        vec_loop(ctx, a->vm, [&](uint32_t i) {
+            ((T*)d)[i] = op(s2[i], &ctx->state->fp_status);
+        });
+    });
+    ctx->info->type = type;
+    return true;
+}
+
+#define GEN_OPF_UNARY(name, type, expr32, expr64) \
+static bool trans_##name(DisasContext *ctx, arg_##name *a) { \
+    return vec_opf_unary(ctx, a, type, [](auto x, float_status *s) -> decltype(x) { \
+        if constexpr (sizeof(x) == 4) return expr32; \
+        else return expr64; \
+    }); \
+}
+
+GEN_OPF_UNARY(vfsqrt_v, VFDIV, float32_sqrt(x, s), float64_sqrt(x, s))
+GEN_OPF_UNARY(vfclass_v, VFADD, vec_fclass(x, s), vec_fclass(x, s))
+GEN_OPF_UNARY(vfrsqrt7_v, VFADD, vec_frsqrt7(x, s), vec_frsqrt7(x, s))
+GEN_OPF_UNARY(vfrec7_v, VFADD, vec_frec7(x, s), vec_frec7(x, s))
+GEN_OPF_UNARY(vfcvt_xu_f_v, VFADD, float32_to_uint32(x, s), float64_to_uint64(x, s))
+GEN_OPF_UNARY(vfcvt_x_f_v, VFADD, float32_to_int32(x, s), float64_to_int64(x, s))
+GEN_OPF_UNARY(vfcvt_rtz_xu_f_v, VFADD, float32_to_uint32_round_to_zero(x, s), float64_to_uint64_round_to_zero(x, s))
+GEN_OPF_UNARY(vfcvt_rtz_x_f_v, VFADD, float32_to_int32_round_to_zero(x, s), float64_to_int64_round_to_zero(x, s))
+GEN_OPF_UNARY(vfcvt_f_xu_v, VFADD, uint32_to_float32(x, s), uint64_to_float64(x, s))
+GEN_OPF_UNARY(vfcvt_f_x_v, VFADD, int32_to_float32((int32_t)x, s), int64_to_float64((int64_t)x, s))
+
+static bool trans_vfmerge_vfm(DisasContext *ctx, arg_vfmerge_vfm *a) {
+    REQUIRE_VECTOR_FPU
+    uint64_t scalar = vec_fscalar(ctx, vec_sew(ctx), a->rs1);
+    return vec_opi_carry(ctx, a, VEC_VX, [&](auto x, auto y, auto c) { return c ? (decltype(x))scalar : x; });
+}
+
+static bool trans_vfmv_v_f(DisasContext *ctx, arg_vfmv_v_f *a) {
+    REQUIRE_VECTOR_FPU
+    int lmul = vec_lmul(ctx);
+    VEC_CHECK(vec_aligned(a->rd, lmul))
+    uint8_t *d = vec_dest(ctx, a->rd, vec_nregs(lmul));
+    uint64_t scalar = vec_fscalar(ctx, vec_sew(ctx), a->rs1);
+    vec_dispatch_f(vec_sew(ctx), [&](auto t) {
+        using T = typename decltype(t)::type;
+        vec_loop(ctx, 1, [&](uint32_t i) { ((T*)d)[i] = scalar; });
+    });
+    ctx->info->type = VALU;
+    return true;
+}
+
+static bool trans_vfmv_f_s(DisasContext *ctx, arg_vfmv_f_s *a) {
+    REQUIRE_VECTOR_FPU
+    uint64_t dest = vec_sew(ctx) == 2 ? nanbox_s(((const uint32_t*)ctx->state->vreg[a->rs2])[0]) :
+                                        ((const uint64_t*)ctx->state->vreg[a->rs2])[0];
+    vec_no_dest(ctx);
+    SET_FPR_64
+    ctx->info->dst_reg = a->rd | DSTF_REG_MASK;
+    ctx->info->type = VPERM;
+    return true;
+}
+
+static bool trans_vfmv_s_f(DisasContext *ctx, arg_vfmv_s_f *a) {
+    REQUIRE_VECTOR_FPU
+    uint8_t *d = vec_dest(ctx, a->rd, 1);
+    uint64_t scalar = vec_fscalar(ctx, vec_sew(ctx), a->rs1);
+    if (ctx->state->vstart < ctx->state->vl) {
+        vec_dispatch_f(vec_sew(ctx), [&](auto t) {
+            using T = typename decltype(t)::type;
+            ((T*)d)[0] = scalar;
+        });
+    }
+    ctx->info->src_reg[0] = a->rs1 | DSTF_REG_MASK;
+    ctx->info->type = VPERM;
+    return true;
+}
+
+static bool trans_vfslide1up_vf(DisasContext *ctx, arg_vfslide1up_vf *a) {
+    REQUIRE_VECTOR_FPU
+    return vec_slideup(ctx, a, 1, true, vec_fscalar(ctx, vec_sew(ctx), a->rs1));
+}
+
+static bool trans_vfslide1down_vf(DisasContext *ctx, arg_vfslide1down_vf *a) {
+    REQUIRE_VECTOR_FPU
+    return vec_slidedown(ctx, a, 1, true, vec_fscalar(ctx, vec_sew(ctx), a->rs1));
+}
+
+/**
+ * @brief fp reduction, vd[0] = op(...op(vs1[0], vs2[0])..., vs2[vl - 1])
+ *
+ * The unordered sum is computed in order as well.
+ */
+template <typename F>
+static bool vec_fred(DisasContext *ctx, arg_rmrr *a, F op) {
+    REQUIRE_VECTOR_FPU
+    VEC_CHECK(ctx->state->vstart == 0 && vec_aligned(a->rs2, vec_lmul(ctx)))
+    uint8_t *d = vec_dest(ctx, a->rd, 1);
+    setrm(ctx, 7);
+    if (ctx->state->vl != 0) {
+        vec_dispatch_f(vec_sew(ctx), [&](auto t) {
+            using T = typename decltype(t)::type;
+            const T *s2 = (const T*)ctx->state->vreg[a->rs2];
+            T acc = ((const T*)ctx->state->vreg[a->rs1])[0];
+            vec_loop(ctx, a->vm, [&](uint32_t i) { acc = op(acc, s2[i], &ctx->state->fp_status); });
+            ((T*)d)[0] = acc;
+        });
+    }
+    ctx->info->type = VRED;
+    return true;
+}
+
+static bool trans_vfredusum_vs(DisasContext *ctx, arg_vfredusum_vs *a) {
+    return vec_fred(ctx, a, [](auto x, auto y, float_status *s) { return vec_fadd(x, y, s); });
+}
+static bool trans_vfredosum_vs(DisasContext *ctx, arg_vfredosum_vs *a) {
+    return vec_fred(ctx, a, [](auto x, auto y, float_status *s) { return vec_fadd(x, y, s); });
+}
+static bool trans_vfredmin_vs(DisasContext *ctx, arg_vfredmin_vs *a) {
+    return vec_fred(ctx, a, [](auto x, auto y, float_status *s) { return vec_fminimum_number(x, y, s); });
+}
+static bool trans_vfredmax_vs(DisasContext *ctx, arg_vfredmax_vs *a) {
+    return vec_fred(ctx, a, [](auto x, auto y, float_status *s) { return vec_fmaximum_number(x, y, s); });
+}
+
+/* widening and narrowing float, only f32 <-> f64 and the integer conversions they need */
+
+// widening fp op on f32 operands, vd (f64) = op(vs2, src1, vd, status)
+template <typename F>
+static bool vec_opfw(DisasContext *ctx, arg_rmrr *a, bool vf, bool wide, InstType type, F op) {
+    REQUIRE_VECTOR_FPU
+    int sew = vec_sew(ctx), lmul = vec_lmul(ctx);
+    VEC_CHECK(sew == 2 && lmul < 3 && vec_check_vd(a->rd, a->vm, lmul + 1) &&
+              vec_aligned(a->rs2, wide ? lmul + 1 : lmul) && (vf || vec_aligned(a->rs1, lmul)))
+    uint8_t *d = vec_dest(ctx, a->rd, vec_nregs(lmul + 1));
+    uint32_t scalar = vf ? vec_fscalar(ctx, sew, a->rs1) : 0;
+    float_status *s = &ctx->state->fp_status;
+    setrm(ctx, 7);
+    const uint8_t *s2 = ctx->state->vreg[a->rs2];
+    const uint32_t *s1 = (const uint32_t*)ctx->state->vreg[a->rs1];
+    vec_loop(ctx, a->vm, [&](uint32_t i) {
+        uint64_t x = wide ? ((const uint64_t*)s2)[i] : float32_to_float64(((const uint32_t*)s2)[i], s);
+        uint64_t y = float32_to_float64(vf ? scalar : s1[i], s);
+        ((uint64_t*)d)[i] = op(x, y, ((uint64_t*)d)[i], s);
+    });
+    ctx->info->type = type;
+    return true;
+}
+
+#define GEN_OPFW(name, vf, wide, type, expr) \
+static bool trans_##name(DisasContext *ctx, arg_##name *a) { \
+    return vec_opfw(ctx, a, vf, wide, type, [](uint64_t x, uint64_t y, uint64_t d, float_status *s) { return expr; }); \
+}
+
+GEN_OPFW(vfwadd_vv, false, false, VFADD, float64_add(x, y, s))
+GEN_OPFW(vfwadd_vf, true, false, VFADD, float64_add(x, y, s))
+GEN_OPFW(vfwadd_wv, false, true, VFADD, float64_add(x, y, s))
+GEN_OPFW(vfwadd_wf, true, true, VFADD, float64_add(x, y, s))
+GEN_OPFW(vfwsub_vv, false, false, VFADD, float64_sub(x, y, s))
+GEN_OPFW(vfwsub_vf, true, false, VFADD, float64_sub(x, y, s))
+GEN_OPFW(vfwsub_wv, false, true, VFADD, float64_sub(x, y, s))
+GEN_OPFW(vfwsub_wf, true, true, VFADD, float64_sub(x, y, s))
+GEN_OPFW(vfwmul_vv, false, false, VFMUL, float64_mul(x, y, s))
+GEN_OPFW(vfwmul_vf, true, false, VFMUL, float64_mul(x, y, s))
+GEN_OPFW(vfwmacc_vv, false, false, VFMA, float64_muladd(y, x, d, 0, s))
+GEN_OPFW(vfwmacc_vf, true, false, VFMA, float64_muladd(y, x, d, 0, s))
+GEN_OPFW(vfwnmacc_vv, false, false, VFMA, float64_muladd(y, x, d, float_muladd_negate_product | float_muladd_negate_c, s))
+GEN_OPFW(vfwnmacc_vf, true, false, VFMA, float64_muladd(y, x, d, float_muladd_negate_product | float_muladd_negate_c, s))
+GEN_OPFW(vfwmsac_vv, false, false, VFMA, float64_muladd(y, x, d, float_muladd_negate_c, s))
+GEN_OPFW(vfwmsac_vf, true, false, VFMA, float64_muladd(y, x, d, float_muladd_negate_c, s))
+GEN_OPFW(vfwnmsac_vv, false, false, VFMA, float64_muladd(y, x, d, float_muladd_negate_product, s))
+GEN_OPFW(vfwnmsac_vf, true, false, VFMA, float64_muladd(y, x, d, float_muladd_negate_product, s))
+
+// vd[0] (f64) = vs1[0] + the sum of the f32 elements of vs2
+static bool vec_fwredsum(DisasContext *ctx, arg_rmrr *a) {
+    REQUIRE_VECTOR_FPU
+    VEC_CHECK(vec_sew(ctx) == 2 && ctx->state->vstart == 0 && vec_aligned(a->rs2, vec_lmul(ctx)))
+    uint8_t *d = vec_dest(ctx, a->rd, 1);
+    float_status *s = &ctx->state->fp_status;
+    setrm(ctx, 7);
+    if (ctx->state->vl != 0) {
+        const uint32_t *s2 = (const uint32_t*)ctx->state->vreg[a->rs2];
+        uint64_t acc = ((const uint64_t*)ctx->state->vreg[a->rs1])[0];
+        vec_loop(ctx, a->vm, [&](uint32_t i) { acc = float64_add(acc, float32_to_float64(s2[i], s), s); });
+        ((uint64_t*)d)[0] = acc;
+    }
+    ctx->info->type = VRED;
+    return true;
+}
+
+static bool trans_vfwredusum_vs(DisasContext *ctx, arg_vfwredusum_vs *a) {
+    return vec_fwredsum(ctx, a);
+}
+static bool trans_vfwredosum_vs(DisasContext *ctx, arg_vfwredosum_vs *a) {
+    return vec_fwredsum(ctx, a);
+}
+
+/**
+ * @brief conversion between sew and 2 * sew elements
+ *
+ * widen converts vs2 of sew to vd of 2 * sew, otherwise vs2 of 2 * sew to
+ * vd of sew. op gets the source bits and a value of the sew type, sews
+ * without a float type are rejected by min_sew.
+ */
+template <typename F>
+static bool vec_fcvt(DisasContext *ctx, arg_rmr *a, bool widen, int min_sew, F op) {
+    REQUIRE_VECTOR
+    REQUIRE_FPU
+    int sew = vec_sew(ctx), lmul = vec_lmul(ctx);
+    VEC_CHECK(sew >= min_sew && sew <= 2 && lmul < 3 &&
+              vec_check_vd(a->rd, a->vm, widen ? lmul + 1 : lmul) && vec_aligned(a->rs2, widen ? lmul : lmul + 1))
+    uint8_t *d = vec_dest(ctx, a->rd, vec_nregs(widen ? lmul + 1 : lmul));
+    float_status *s = &ctx->state->fp_status;
+    setrm(ctx, 7);
+    vec_dispatch_w(sew, [&](auto n, auto w) {
+        using N = typename decltype(n)::type;
+        using W = typename decltype(w)::type;
+        const uint8_t *s2 = ctx->state->vreg[a->rs2];
+        vec_loop(ctx, a->vm, [&](uint32_t i) {
+            if (widen) {
+                ((W*)d)[i] = op(((const N*)s2)[i], N(), s);
+            } else {
+                ((N*)d)[i] = op(((const W*)s2)[i], N(), s);
+            }
+        });
+    });
+    ctx->info->type = VFADD;
+    return true;
+}
+
+// expr32 runs for sew e32, expr16 for e16
+#define GEN_FCVT(name, widen, min_sew, expr32, expr16) \
+static bool trans_##name(DisasContext *ctx, arg_##name *a) { \
+    return vec_fcvt(ctx, a, widen, min_sew, [](auto x, auto n, float_status *s) -> uint64_t { \
+        if constexpr (sizeof(n) == 4) return expr32; \
+        else if constexpr (sizeof(n) == 2) return expr16; \
+        else return 0; \
+    }); \
+}
+
+GEN_FCVT(vfwcvt_xu_f_v, true, 2, float32_to_uint64(x, s), 0)
+GEN_FCVT(vfwcvt_x_f_v, true, 2, float32_to_int64(x, s), 0)
+GEN_FCVT(vfwcvt_rtz_xu_f_v, true, 2, float32_to_uint64_round_to_zero(x, s), 0)
+GEN_FCVT(vfwcvt_rtz_x_f_v, true, 2, float32_to_int64_round_to_zero(x, s), 0)
+GEN_FCVT(vfwcvt_f_f_v, true, 2, float32_to_float64(x, s), 0)
+GEN_FCVT(vfwcvt_f_xu_v, true, 1, uint32_to_float64(x, s), uint16_to_float32(x, s))
+GEN_FCVT(vfwcvt_f_x_v, true, 1, int32_to_float64((int32_t)x, s), int16_to_float32((int16_t)x, s))
+GEN_FCVT(vfncvt_xu_f_w, false, 1, float64_to_uint32(x, s), float32_to_uint16(x, s))
+GEN_FCVT(vfncvt_x_f_w, false, 1, float64_to_int32(x, s), float32_to_int16(x, s))
+GEN_FCVT(vfncvt_rtz_xu_f_w, false, 1, float64_to_uint32_round_to_zero(x, s), float32_to_uint16_round_to_zero(x, s))
+GEN_FCVT(vfncvt_rtz_x_f_w, false, 1, float64_to_int32_round_to_zero(x, s), float32_to_int16_round_to_zero(x, s))
+GEN_FCVT(vfncvt_f_xu_w, false, 2, uint64_to_float32(x, s), 0)
+GEN_FCVT(vfncvt_f_x_w, false, 2, int64_to_float32((int64_t)x, s), 0)
+GEN_FCVT(vfncvt_f_f_w, false, 2, float64_to_float32(x, s), 0)
+
+static bool trans_vfncvt_rod_f_f_w(DisasContext *ctx, arg_vfncvt_rod_f_f_w *a) {
+    return vec_fcvt(ctx, a, false, 2, [](auto x, auto n, float_status *s) -> uint64_t {
+        if constexpr (sizeof(n) == 4) {
+            FloatRoundMode rm = s->float_rounding_mode;
+            s->float_rounding_mode = float_round_to_odd;
+            uint32_t res = float64_to_float32(x, s);
+            s->float_rounding_mode = rm;
+            return res;
+        } else {
+            return 0;
+        }
+    });
+}
+
+static bool trans_vaesdf_vs(DisasContext *ctx, arg_vaesdf_vs *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vaesdf_vv(DisasContext *ctx, arg_vaesdf_vv *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vaesdm_vs(DisasContext *ctx, arg_vaesdm_vs *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vaesdm_vv(DisasContext *ctx, arg_vaesdm_vv *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vaesef_vs(DisasContext *ctx, arg_vaesef_vs *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vaesef_vv(DisasContext *ctx, arg_vaesef_vv *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vaesem_vs(DisasContext *ctx, arg_vaesem_vs *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vaesem_vv(DisasContext *ctx, arg_vaesem_vv *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vaeskf1_vi(DisasContext *ctx, arg_vaeskf1_vi *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vaeskf2_vi(DisasContext *ctx, arg_vaeskf2_vi *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vaesz_vs(DisasContext *ctx, arg_vaesz_vs *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vandn_vv(DisasContext *ctx, arg_vandn_vv *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vandn_vx(DisasContext *ctx, arg_vandn_vx *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vbrev8_v(DisasContext *ctx, arg_vbrev8_v *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vbrev_v(DisasContext *ctx, arg_vbrev_v *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vclmulh_vv(DisasContext *ctx, arg_vclmulh_vv *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vclmulh_vx(DisasContext *ctx, arg_vclmulh_vx *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vclmul_vv(DisasContext *ctx, arg_vclmul_vv *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vclmul_vx(DisasContext *ctx, arg_vclmul_vx *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vclz_v(DisasContext *ctx, arg_vclz_v *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vcpop_v(DisasContext *ctx, arg_vcpop_v *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vctz_v(DisasContext *ctx, arg_vctz_v *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vfncvtbf16_f_f_w(DisasContext *ctx, arg_vfncvtbf16_f_f_w *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vfwcvtbf16_f_f_v(DisasContext *ctx, arg_vfwcvtbf16_f_f_v *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vfwmaccbf16_vf(DisasContext *ctx, arg_vfwmaccbf16_vf *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vfwmaccbf16_vv(DisasContext *ctx, arg_vfwmaccbf16_vv *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vghsh_vv(DisasContext *ctx, arg_vghsh_vv *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vgmul_vv(DisasContext *ctx, arg_vgmul_vv *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vrev8_v(DisasContext *ctx, arg_vrev8_v *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vrol_vv(DisasContext *ctx, arg_vrol_vv *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vrol_vx(DisasContext *ctx, arg_vrol_vx *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vror_vi(DisasContext *ctx, arg_vror_vi *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vror_vv(DisasContext *ctx, arg_vror_vv *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vror_vx(DisasContext *ctx, arg_vror_vx *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vsha2ch_vv(DisasContext *ctx, arg_vsha2ch_vv *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vsha2cl_vv(DisasContext *ctx, arg_vsha2cl_vv *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vsha2ms_vv(DisasContext *ctx, arg_vsha2ms_vv *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vsm3c_vi(DisasContext *ctx, arg_vsm3c_vi *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vsm3me_vv(DisasContext *ctx, arg_vsm3me_vv *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vsm4k_vi(DisasContext *ctx, arg_vsm4k_vi *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vsm4r_vs(DisasContext *ctx, arg_vsm4r_vs *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vsm4r_vv(DisasContext *ctx, arg_vsm4r_vv *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_vwsll_vi(DisasContext *ctx, arg_vwsll_vi *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_vwsll_vv(DisasContext *ctx, arg_vwsll_vv *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_vwsll_vx(DisasContext *ctx, arg_vwsll_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwsubu_vv(DisasContext *ctx, arg_vwsubu_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwsubu_vx(DisasContext *ctx, arg_vwsubu_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwsubu_wv(DisasContext *ctx, arg_vwsubu_wv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwsubu_wx(DisasContext *ctx, arg_vwsubu_wx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwsub_vv(DisasContext *ctx, arg_vwsub_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwsub_vx(DisasContext *ctx, arg_vwsub_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwsub_wv(DisasContext *ctx, arg_vwsub_wv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vwsub_wx(DisasContext *ctx, arg_vwsub_wx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vxor_vi(DisasContext *ctx, arg_vxor_vi *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vxor_vv(DisasContext *ctx, arg_vxor_vv *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vxor_vx(DisasContext *ctx, arg_vxor_vx *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vzext_vf2(DisasContext *ctx, arg_vzext_vf2 *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vzext_vf4(DisasContext *ctx, arg_vzext_vf4 *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_vzext_vf8(DisasContext *ctx, arg_vzext_vf8 *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_wrs_nto(DisasContext *ctx, arg_wrs_nto *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_wrs_sto(DisasContext *ctx, arg_wrs_sto *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_xperm4(DisasContext *ctx, arg_xperm4 *a) {__NOT_IMPLEMENTED_EXIT__}
-static bool trans_xperm8(DisasContext *ctx, arg_xperm8 *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_xperm4(DisasContext *ctx, arg_xperm4 *a) {
+    uint64_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
+    uint64_t src2 = get_gpr_64(ctx, a->rs2, EXT_NONE);
+    uint64_t dest = 0;
+    for (int i = 0; i < 64; i += 4) {
+        dest |= ((src1 >> (((src2 >> i) & 0xf) * 4)) & 0xf) << i;
+    }
+    SET_GPR_64
+    SET_SRC2_DST
+    ctx->info->type = INT;
+    return true;
+}
+static bool trans_xperm8(DisasContext *ctx, arg_xperm8 *a) {
+    uint64_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
+    uint64_t src2 = get_gpr_64(ctx, a->rs2, EXT_NONE);
+    uint64_t dest = 0;
+    for (int i = 0; i < 64; i += 8) {
+        uint64_t idx = (src2 >> i) & 0xff;
+        if (idx < 8) {
+            dest |= ((src1 >> (idx * 8)) & 0xff) << i;
+        }
+    }
+    SET_GPR_64
+    SET_SRC2_DST
+    ctx->info->type = INT;
+    return true;
+}
 static bool trans_zext_h_32(DisasContext *ctx, arg_zext_h_32 *a) {__NOT_IMPLEMENTED_EXIT__}
 static bool trans_zext_h_64(DisasContext *ctx, arg_zext_h_64 *a) {
     uint64_t src1 = get_gpr_64(ctx, a->rs1, EXT_NONE);
@@ -2876,7 +4958,7 @@ static bool trans_zext_h_64(DisasContext *ctx, arg_zext_h_64 *a) {
     ctx->info->type = INT;
     return true;
 }
-static bool trans_zip(DisasContext *ctx, arg_zip *a) {__NOT_IMPLEMENTED_EXIT__}
+static bool trans_zip(DisasContext *ctx, arg_zip *a) {return gen_rv32_only(ctx);}
 
 
 static bool trans_c64_illegal(DisasContext *ctx, arg_c64_illegal *a) {__NOT_IMPLEMENTED_EXIT__}
@@ -2918,4 +5000,256 @@ bool interpreter(DisasContext *ctx, uint32_t insn, bool rvc) {
     }
 }
 
-}
\ No newline at end of file
+// trans functions run by RiscvArch::run. They only fill the dst entries
+// their kind commits and raise no exception other than load and store faults
+BlockOpKind blockOpKind(bool (*trans)(void*, void*)) {
+    static const std::unordered_map<bool (*)(void*, void*), BlockOpKind> kinds = {
+        {(bool (*)(void*, void*))trans_lui, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_auipc, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_addi, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_slti, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sltiu, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_xori, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_ori, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_andi, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_slli, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_srli, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_srai, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_add, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sub, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sll, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_slt, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sltu, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_xor, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_srl, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sra, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_or, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_and, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_addiw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_slliw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_srliw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sraiw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_addw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_subw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sllw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_srlw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sraw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_mul, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_mulh, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_mulhu, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_mulw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_div, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_divu, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_rem, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_remu, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_divw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_divuw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_remw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_remuw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_add_uw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sh1add, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sh2add, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sh3add, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sh1add_uw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sh2add_uw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sh3add_uw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_slli_uw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_andn, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_orn, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_xnor, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_clz, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_clzw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_ctz, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_ctzw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_max, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_maxu, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_min, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_minu, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sext_b, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sext_h, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_rol, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_ror, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_rori, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_rolw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_rorw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_roriw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_rev8_64, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_orc_b, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_brev8, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_pack, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_packh, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_packw, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_xperm4, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_xperm8, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_clmul, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_clmulh, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_clmulr, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_aes64es, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_aes64esm, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_aes64ds, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_aes64dsm, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_aes64im, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_aes64ks2, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sha256sig0, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sha256sig1, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sha256sum0, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sha256sum1, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sha512sig0, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sha512sig1, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sha512sum0, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sha512sum1, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sm3p0, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sm3p1, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sm4ed, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_sm4ks, BLOCK_OP_REG},
+        {(bool (*)(void*, void*))trans_lb, BLOCK_OP_LOAD},
+        {(bool (*)(void*, void*))trans_lh, BLOCK_OP_LOAD},
+        {(bool (*)(void*, void*))trans_lw, BLOCK_OP_LOAD},
+        {(bool (*)(void*, void*))trans_ld, BLOCK_OP_LOAD},
+        {(bool (*)(void*, void*))trans_lbu, BLOCK_OP_LOAD},
+        {(bool (*)(void*, void*))trans_lhu, BLOCK_OP_LOAD},
+        {(bool (*)(void*, void*))trans_lwu, BLOCK_OP_LOAD},
+        {(bool (*)(void*, void*))trans_sb, BLOCK_OP_STORE},
+        {(bool (*)(void*, void*))trans_sh, BLOCK_OP_STORE},
+        {(bool (*)(void*, void*))trans_sw, BLOCK_OP_STORE},
+        {(bool (*)(void*, void*))trans_sd, BLOCK_OP_STORE},
+        {(bool (*)(void*, void*))trans_beq, BLOCK_OP_BRANCH},
+        {(bool (*)(void*, void*))trans_bne, BLOCK_OP_BRANCH},
+        {(bool (*)(void*, void*))trans_blt, BLOCK_OP_BRANCH},
+        {(bool (*)(void*, void*))trans_bge, BLOCK_OP_BRANCH},
+        {(bool (*)(void*, void*))trans_bltu, BLOCK_OP_BRANCH},
+        {(bool (*)(void*, void*))trans_bgeu, BLOCK_OP_BRANCH},
+        {(bool (*)(void*, void*))trans_jal, BLOCK_OP_JUMP},
+        {(bool (*)(void*, void*))trans_jalr, BLOCK_OP_JUMP},
+    };
+    auto iter = kinds.find(trans);
+    return iter == kinds.end() ? BLOCK_OP_NONE : iter->second;
+}
+
+enum JitFormat {
+    JIT_FMT_I,
+    JIT_FMT_SHIFT,
+    JIT_FMT_R,
+    JIT_FMT_U,
+    JIT_FMT_S,
+    JIT_FMT_B,
+    JIT_FMT_J,
+};
+
+bool jitInst(bool (*trans)(void*, void*), const uint8_t* args, JitInst& inst) {
+    static const std::unordered_map<bool (*)(void*, void*), std::pair<JitOp, JitFormat>> ops = {
+        {(bool (*)(void*, void*))trans_addi, {JIT_ADDI, JIT_FMT_I}},
+        {(bool (*)(void*, void*))trans_slti, {JIT_SLTI, JIT_FMT_I}},
+        {(bool (*)(void*, void*))trans_sltiu, {JIT_SLTIU, JIT_FMT_I}},
+        {(bool (*)(void*, void*))trans_xori, {JIT_XORI, JIT_FMT_I}},
+        {(bool (*)(void*, void*))trans_ori, {JIT_ORI, JIT_FMT_I}},
+        {(bool (*)(void*, void*))trans_andi, {JIT_ANDI, JIT_FMT_I}},
+        {(bool (*)(void*, void*))trans_addiw, {JIT_ADDIW, JIT_FMT_I}},
+        {(bool (*)(void*, void*))trans_lb, {JIT_LB, JIT_FMT_I}},
+        {(bool (*)(void*, void*))trans_lh, {JIT_LH, JIT_FMT_I}},
+        {(bool (*)(void*, void*))trans_lw, {JIT_LW, JIT_FMT_I}},
+        {(bool (*)(void*, void*))trans_ld, {JIT_LD, JIT_FMT_I}},
+        {(bool (*)(void*, void*))trans_lbu, {JIT_LBU, JIT_FMT_I}},
+        {(bool (*)(void*, void*))trans_lhu, {JIT_LHU, JIT_FMT_I}},
+        {(bool (*)(void*, void*))trans_lwu, {JIT_LWU, JIT_FMT_I}},
+        {(bool (*)(void*, void*))trans_jalr, {JIT_JALR, JIT_FMT_I}},
+        {(bool (*)(void*, void*))trans_slli, {JIT_SLLI, JIT_FMT_SHIFT}},
+        {(bool (*)(void*, void*))trans_srli, {JIT_SRLI, JIT_FMT_SHIFT}},
+        {(bool (*)(void*, void*))trans_srai, {JIT_SRAI, JIT_FMT_SHIFT}},
+        {(bool (*)(void*, void*))trans_slliw, {JIT_SLLIW, JIT_FMT_SHIFT}},
+        {(bool (*)(void*, void*))trans_srliw, {JIT_SRLIW, JIT_FMT_SHIFT}},
+        {(bool (*)(void*, void*))trans_sraiw, {JIT_SRAIW, JIT_FMT_SHIFT}},
+        {(bool (*)(void*, void*))trans_add, {JIT_ADD, JIT_FMT_R}},
+        {(bool (*)(void*, void*))trans_sub, {JIT_SUB, JIT_FMT_R}},
+        {(bool (*)(void*, void*))trans_sll, {JIT_SLL, JIT_FMT_R}},
+        {(bool (*)(void*, void*))trans_slt, {JIT_SLT, JIT_FMT_R}},
+        {(bool (*)(void*, void*))trans_sltu, {JIT_SLTU, JIT_FMT_R}},
+        {(bool (*)(void*, void*))trans_xor, {JIT_XOR, JIT_FMT_R}},
+        {(bool (*)(void*, void*))trans_srl, {JIT_SRL, JIT_FMT_R}},
+        {(bool (*)(void*, void*))trans_sra, {JIT_SRA, JIT_FMT_R}},
+        {(bool (*)(void*, void*))trans_or, {JIT_OR, JIT_FMT_R}},
+        {(bool (*)(void*, void*))trans_and, {JIT_AND, JIT_FMT_R}},
+        {(bool (*)(void*, void*))trans_addw, {JIT_ADDW, JIT_FMT_R}},
+        {(bool (*)(void*, void*))trans_subw, {JIT_SUBW, JIT_FMT_R}},
+        {(bool (*)(void*, void*))trans_sllw, {JIT_SLLW, JIT_FMT_R}},
+        {(bool (*)(void*, void*))trans_srlw, {JIT_SRLW, JIT_FMT_R}},
+        {(bool (*)(void*, void*))trans_sraw, {JIT_SRAW, JIT_FMT_R}},
+        {(bool (*)(void*, void*))trans_mul, {JIT_MUL, JIT_FMT_R}},
+        {(bool (*)(void*, void*))trans_mulw, {JIT_MULW, JIT_FMT_R}},
+        {(bool (*)(void*, void*))trans_lui, {JIT_LUI, JIT_FMT_U}},
+        {(bool (*)(void*, void*))trans_auipc, {JIT_AUIPC, JIT_FMT_U}},
+        {(bool (*)(void*, void*))trans_sb, {JIT_SB, JIT_FMT_S}},
+        {(bool (*)(void*, void*))trans_sh, {JIT_SH, JIT_FMT_S}},
+        {(bool (*)(void*, void*))trans_sw, {JIT_SW, JIT_FMT_S}},
+        {(bool (*)(void*, void*))trans_sd, {JIT_SD, JIT_FMT_S}},
+        {(bool (*)(void*, void*))trans_beq, {JIT_BEQ, JIT_FMT_B}},
+        {(bool (*)(void*, void*))trans_bne, {JIT_BNE, JIT_FMT_B}},
+        {(bool (*)(void*, void*))trans_blt, {JIT_BLT, JIT_FMT_B}},
+        {(bool (*)(void*, void*))trans_bge, {JIT_BGE, JIT_FMT_B}},
+        {(bool (*)(void*, void*))trans_bltu, {JIT_BLTU, JIT_FMT_B}},
+        {(bool (*)(void*, void*))trans_bgeu, {JIT_BGEU, JIT_FMT_B}},
+        {(bool (*)(void*, void*))trans_jal, {JIT_JAL, JIT_FMT_J}},
+    };
+    auto iter = ops.find(trans);
+    if (iter == ops.end()) {
+        return false;
+    }
+    inst.op = iter->second.first;
+    inst.rd = 0;
+    inst.rs1 = 0;
+    inst.rs2 = 0;
+    inst.imm = 0;
+    switch (iter->second.second) {
+    case JIT_FMT_I: {
+        const arg_i* a = (const arg_i*)args;
+        inst.rd = a->rd;
+        inst.rs1 = a->rs1;
+        inst.imm = a->imm;
+        break;
+    }
+    case JIT_FMT_SHIFT: {
+        const arg_shift* a = (const arg_shift*)args;
+        inst.rd = a->rd;
+        inst.rs1 = a->rs1;
+        inst.imm = a->shamt;
+        break;
+    }
+    case JIT_FMT_R: {
+        const arg_r* a = (const arg_r*)args;
+        inst.rd = a->rd;
+        inst.rs1 = a->rs1;
+        inst.rs2 = a->rs2;
+        break;
+    }
+    case JIT_FMT_U: {
+        const arg_u* a = (const arg_u*)args;
+        inst.rd = a->rd;
+        inst.imm = a->imm;
+        break;
+    }
+    case JIT_FMT_S: {
+        const arg_s* a = (const arg_s*)args;
+        inst.rs1 = a->rs1;
+        inst.rs2 = a->rs2;
+        inst.imm = a->imm;
+        break;
+    }
+    case JIT_FMT_B: {
+        const arg_b* a = (const arg_b*)args;
+        inst.rs1 = a->rs1;
+        inst.rs2 = a->rs2;
+        inst.imm = a->imm;
+        break;
+    }
+    case JIT_FMT_J: {
+        const arg_j* a = (const arg_j*)args;
+        inst.rd = a->rd;
+        inst.imm = a->imm;
+        break;
+    }
+    }
+    // trans_jalr reports rs1 = 0 as an error, leave it to the interpreter
+    return !(inst.op == JIT_JALR && inst.rs1 == 0);
+}
+
+}
@@ -0,0 +1,467 @@
+#include "arch/riscv/jit.h"
+#include "cache/memory.h"
+#include <cstring>
+#include <map>
+#include <initializer_list>
+#include <sys/mman.h>
+namespace cds::arch::riscv {
+
+#if defined(__x86_64__)
+
+namespace {
+
+enum HostReg {
+    RAX = 0,
+    RCX = 1,
+    RDX = 2,
+    RSI = 6,
+    RDI = 7,
+    R8 = 8,
+    R9 = 9,
+    R10 = 10,
+    R11 = 11,
+};
+
+enum HostCond {
+    CC_B = 0x2,
+    CC_AE = 0x3,
+    CC_E = 0x4,
+    CC_NE = 0x5,
+    CC_L = 0xc,
+    CC_GE = 0xd,
+};
+
+// group 1 and group 2 opcode extensions
+enum HostAlu {
+    ALU_ADD = 0,
+    ALU_OR = 1,
+    ALU_AND = 4,
+    ALU_SUB = 5,
+    ALU_XOR = 6,
+    ALU_CMP = 7,
+};
+
+enum HostShift {
+    SHIFT_SHL = 4,
+    SHIFT_SHR = 5,
+    SHIFT_SAR = 7,
+};
+
+/**
+ * @brief x86-64 encoder for the few instruction forms the jit needs
+ *
+ * Memory operands are always [base + disp32].
+ */
+class Emitter {
+public:
+    std::vector<uint8_t> buf;
+
+    void byte(uint8_t b) { buf.push_back(b); }
+    void u32(uint32_t v) {
+        for (int i = 0; i < 4; i++) byte(v >> (i * 8));
+    }
+    void u64(uint64_t v) {
+        for (int i = 0; i < 8; i++) byte(v >> (i * 8));
+    }
+    void rex(bool w, int reg, int rm) {
+        uint8_t prefix = 0x40 | (w << 3) | (((reg >> 3) & 1) << 2) | ((rm >> 3) & 1);
+        if (prefix != 0x40) byte(prefix);
+    }
+    void opRR(bool w, std::initializer_list<uint8_t> opcode, int reg, int rm) {
+        rex(w, reg, rm);
+        for (uint8_t op : opcode) byte(op);
+        byte(0xc0 | ((reg & 7) << 3) | (rm & 7));
+    }
+    void opRM(bool w, std::initializer_list<uint8_t> opcode, int reg, int base, int32_t disp) {
+        rex(w, reg, base);
+        for (uint8_t op : opcode) byte(op);
+        byte(0x80 | ((reg & 7) << 3) | (base & 7));
+        if ((base & 7) == 4) byte(0x24);
+        u32(disp);
+    }
+
+    void loadGpr(int reg, int gpr) {
+        if (gpr == 0) {
+            opRR(false, {0x31}, reg, reg);
+        } else {
+            opRM(true, {0x8b}, reg, RDI, gpr * 8);
+        }
+    }
+    void storeGpr(int gpr, int reg) {
+        if (gpr != 0) {
+            opRM(true, {0x89}, reg, RDI, gpr * 8);
+        }
+    }
+    void movImm(int reg, int64_t imm) {
+        rex(true, 0, reg);
+        if (imm == (int32_t)imm) {
+            byte(0xc7);
+            byte(0xc0 | (reg & 7));
+            u32(imm);
+        } else {
+            byte(0xb8 + (reg & 7));
+            u64(imm);
+        }
+    }
+    void movRR(int dst, int src) { opRR(true, {0x89}, src, dst); }
+    void aluImm(bool w, HostAlu alu, int reg, int32_t imm) {
+        rex(w, 0, reg);
+        byte(0x81);
+        byte(0xc0 | (alu << 3) | (reg & 7));
+        u32(imm);
+    }
+    void aluRR(bool w, HostAlu alu, int dst, int src) {
+        // add, or, and, sub, xor and cmp r/m, r
+        opRR(w, {(uint8_t)((alu << 3) | 1)}, src, dst);
+    }
+    void shiftImm(bool w, HostShift shift, int reg, uint8_t imm) {
+        rex(w, 0, reg);
+        byte(0xc1);
+        byte(0xc0 | (shift << 3) | (reg & 7));
+        byte(imm);
+    }
+    void shiftCl(bool w, HostShift shift, int reg) {
+        rex(w, 0, reg);
+        byte(0xd3);
+        byte(0xc0 | (shift << 3) | (reg & 7));
+    }
+    void movsxd(int dst, int src) { opRR(true, {0x63}, dst, src); }
+    void imul(bool w, int dst, int src) { opRR(w, {0x0f, 0xaf}, dst, src); }
+    void imulImm(int dst, int src, int32_t imm) {
+        opRR(true, {0x69}, dst, src);
+        u32(imm);
+    }
+    // rax = cond ? 1 : 0
+    void setcc(HostCond cond) {
+        byte(0x0f); byte(0x90 | cond); byte(0xc0);
+        byte(0x0f); byte(0xb6); byte(0xc0);
+    }
+    void cmovcc(HostCond cond, int dst, int src) { opRR(true, {0x0f, (uint8_t)(0x40 | cond)}, dst, src); }
+    void lea(int dst, int base, int32_t disp) { opRM(true, {0x8d}, dst, base, disp); }
+    // dst = pc + disp, pc is in rsi
+    void leaPC(int dst, int64_t disp) {
+        if (disp == (int32_t)disp) {
+            lea(dst, RSI, disp);
+        } else {
+            movImm(dst, disp);
+            aluRR(true, ALU_ADD, dst, RSI);
+        }
+    }
+    // *executed = count, executed is in rdx
+    void setExecuted(uint32_t count) {
+        opRM(true, {0xc7}, 0, RDX, 0);
+        u32(count);
+    }
+    /**
+     * @return position of the rel32 to patch
+     */
+    size_t jcc(HostCond cond) {
+        byte(0x0f);
+        byte(0x80 | cond);
+        u32(0);
+        return buf.size() - 4;
+    }
+    void patch(size_t pos, size_t target) {
+        uint32_t rel = target - (pos + 4);
+        memcpy(&buf[pos], &rel, 4);
+    }
+    void ret() { byte(0xc3); }
+};
+
+struct ExitPatch {
+    size_t pos;
+    uint32_t inst;
+};
+
+/**
+ * @brief load or store through the dtlb, leave to the interpreter on anything but a ram hit
+ */
+void emitMemory(Emitter& e, const JitInst& inst, uint32_t idx, SoftTLB* tlb,
+                const std::vector<uint8_t>& code_pages, std::vector<ExitPatch>& exits) {
+    bool store = inst.op >= JIT_SB && inst.op <= JIT_SD;
+    int size = 0;
+    switch (inst.op) {
+    case JIT_LB: case JIT_LBU: case JIT_SB: size = 1; break;
+    case JIT_LH: case JIT_LHU: case JIT_SH: size = 2; break;
+    case JIT_LW: case JIT_LWU: case JIT_SW: size = 4; break;
+    default: size = 8; break;
+    }
+    e.loadGpr(RAX, inst.rs1);
+    if (inst.imm != 0) {
+        e.aluImm(true, ALU_ADD, RAX, inst.imm);
+    }
+    if (store) {
+        e.loadGpr(R11, inst.rs2);
+    }
+    if (size > 1) {
+        // test al, size - 1
+        e.byte(0xa8);
+        e.byte(size - 1);
+        exits.push_back({e.jcc(CC_NE), idx});
+    }
+    // r8 = entry, r9 = vpn
+    e.movRR(R9, RAX);
+    e.shiftImm(true, SHIFT_SHR, R9, TLB_PGSHFT);
+    e.movRR(R8, R9);
+    e.aluImm(true, ALU_AND, R8, TLB_MASK);
+    e.imulImm(R8, R8, sizeof(TLBEntry));
+    e.movImm(R10, (int64_t)tlb->dtlb);
+    e.aluRR(true, ALU_ADD, R8, R10);
+    e.opRM(true, {0x3b}, R9, R8, store ? offsetof(TLBEntry, tag_write) : offsetof(TLBEntry, tag_read));
+    exits.push_back({e.jcc(CC_NE), idx});
+    e.opRM(true, {0x8b}, R9, R8, offsetof(TLBEntry, asid));
+    e.movImm(R10, (int64_t)&tlb->asid);
+    e.opRM(true, {0x3b}, R9, R10, 0);
+    size_t asid_hit = e.jcc(CC_E);
+    // cmp r9, TLB_ASID_GLOBAL
+    e.rex(true, 0, R9);
+    e.byte(0x83);
+    e.byte(0xc0 | (ALU_CMP << 3) | (R9 & 7));
+    e.byte(0xff);
+    exits.push_back({e.jcc(CC_NE), idx});
+    e.patch(asid_hit, e.buf.size());
+    if (store) {
+        // RiscvArch::paddrWrite flushes the decoded code of the page
+        e.opRM(true, {0x8b}, R9, R8, offsetof(TLBEntry, paddr));
+        e.movImm(R10, Memory::RAM_BASE);
+        e.aluRR(true, ALU_SUB, R9, R10);
+        e.shiftImm(true, SHIFT_SHR, R9, TLB_PGSHFT);
+        e.movImm(R10, code_pages.size());
+        e.aluRR(true, ALU_CMP, R9, R10);
+        size_t not_ram = e.jcc(CC_AE);
+        e.movImm(R10, (int64_t)code_pages.data());
+        e.aluRR(true, ALU_ADD, R10, R9);
+        // cmp byte [r10], 0
+        e.opRM(false, {0x80}, ALU_CMP, R10, 0);
+        e.byte(0);
+        exits.push_back({e.jcc(CC_NE), idx});
+        e.patch(not_ram, e.buf.size());
+    }
+    e.opRM(true, {0x8b}, R8, R8, offsetof(TLBEntry, host));
+    e.opRR(true, {0x85}, R8, R8);
+    exits.push_back({e.jcc(CC_E), idx});
+    e.aluImm(true, ALU_AND, RAX, TLB_PGMASK);
+    e.aluRR(true, ALU_ADD, R8, RAX);
+    switch (inst.op) {
+    case JIT_LB: e.opRM(true, {0x0f, 0xbe}, RCX, R8, 0); break;
+    case JIT_LBU: e.opRM(false, {0x0f, 0xb6}, RCX, R8, 0); break;
+    case JIT_LH: e.opRM(true, {0x0f, 0xbf}, RCX, R8, 0); break;
+    case JIT_LHU: e.opRM(false, {0x0f, 0xb7}, RCX, R8, 0); break;
+    case JIT_LW: e.opRM(true, {0x63}, RCX, R8, 0); break;
+    case JIT_LWU: e.opRM(false, {0x8b}, RCX, R8, 0); break;
+    case JIT_LD: e.opRM(true, {0x8b}, RCX, R8, 0); break;
+    case JIT_SB: e.opRM(false, {0x88}, R11, R8, 0); break;
+    case JIT_SH: e.byte(0x66); e.opRM(false, {0x89}, R11, R8, 0); break;
+    case JIT_SW: e.opRM(false, {0x89}, R11, R8, 0); break;
+    case JIT_SD: e.opRM(true, {0x89}, R11, R8, 0); break;
+    default: break;
+    }
+    if (!store) {
+        e.storeGpr(inst.rd, RCX);
+    }
+}
+
+} // namespace
+
+JitCompiler::JitCompiler(SoftTLB* tlb, const std::vector<uint8_t>& code_pages) : tlb(tlb), code_pages(code_pages) {
+    void* buf = mmap(nullptr, CODE_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    code = buf == MAP_FAILED ? nullptr : (uint8_t*)buf;
+}
+
+JitCompiler::~JitCompiler() {
+    if (code != nullptr) {
+        munmap(code, CODE_SIZE);
+    }
+}
+
+bool JitCompiler::supported() {
+    return true;
+}
+
+JitFunc JitCompiler::compile(const std::vector<JitInst>& insts, uint32_t& count) {
+    Emitter e;
+    std::vector<ExitPatch> exits;
+    std::vector<int64_t> offsets;
+    int64_t off = 0;
+    bool ended = false;
+    count = 0;
+    // the executable mapping failed, e.g. on a W^X host
+    if (code == nullptr) {
+        return nullptr;
+    }
+    for (uint32_t i = 0; i < insts.size() && !ended; i++) {
+        const JitInst& inst = insts[i];
+        offsets.push_back(off);
+        switch (inst.op) {
+        case JIT_ADDI: case JIT_XORI: case JIT_ORI: case JIT_ANDI: {
+            HostAlu alu = inst.op == JIT_ADDI ? ALU_ADD : inst.op == JIT_XORI ? ALU_XOR :
+                          inst.op == JIT_ORI ? ALU_OR : ALU_AND;
+            e.loadGpr(RAX, inst.rs1);
+            e.aluImm(true, alu, RAX, inst.imm);
+            e.storeGpr(inst.rd, RAX);
+            break;
+        }
+        case JIT_SLTI: case JIT_SLTIU:
+            e.loadGpr(RAX, inst.rs1);
+            e.aluImm(true, ALU_CMP, RAX, inst.imm);
+            e.setcc(inst.op == JIT_SLTI ? CC_L : CC_B);
+            e.storeGpr(inst.rd, RAX);
+            break;
+        case JIT_ADDIW:
+            e.loadGpr(RAX, inst.rs1);
+            e.aluImm(false, ALU_ADD, RAX, inst.imm);
+            e.movsxd(RAX, RAX);
+            e.storeGpr(inst.rd, RAX);
+            break;
+        case JIT_SLLI: case JIT_SRLI: case JIT_SRAI:
+        case JIT_SLLIW: case JIT_SRLIW: case JIT_SRAIW: {
+            bool word = inst.op >= JIT_SLLIW;
+            HostShift shift = (inst.op == JIT_SLLI || inst.op == JIT_SLLIW) ? SHIFT_SHL :
+                              (inst.op == JIT_SRLI || inst.op == JIT_SRLIW) ? SHIFT_SHR : SHIFT_SAR;
+            e.loadGpr(RAX, inst.rs1);
+            e.shiftImm(!word, shift, RAX, inst.imm);
+            if (word) e.movsxd(RAX, RAX);
+            e.storeGpr(inst.rd, RAX);
+            break;
+        }
+        case JIT_ADD: case JIT_SUB: case JIT_XOR: case JIT_OR: case JIT_AND:
+        case JIT_ADDW: case JIT_SUBW: {
+            bool word = inst.op == JIT_ADDW || inst.op == JIT_SUBW;
+            HostAlu alu = (inst.op == JIT_ADD || inst.op == JIT_ADDW) ? ALU_ADD :
+                          (inst.op == JIT_SUB || inst.op == JIT_SUBW) ? ALU_SUB :
+                          inst.op == JIT_XOR ? ALU_XOR : inst.op == JIT_OR ? ALU_OR : ALU_AND;
+            e.loadGpr(RAX, inst.rs1);
+            e.loadGpr(RCX, inst.rs2);
+            e.aluRR(!word, alu, RAX, RCX);
+            if (word) e.movsxd(RAX, RAX);
+            e.storeGpr(inst.rd, RAX);
+            break;
+        }
+        case JIT_SLL: case JIT_SRL: case JIT_SRA:
+        case JIT_SLLW: case JIT_SRLW: case JIT_SRAW: {
+            bool word = inst.op >= JIT_SLLW;
+            HostShift shift = (inst.op == JIT_SLL || inst.op == JIT_SLLW) ? SHIFT_SHL :
+                              (inst.op == JIT_SRL || inst.op == JIT_SRLW) ? SHIFT_SHR : SHIFT_SAR;
+            // the host masks the count like the guest
+            e.loadGpr(RAX, inst.rs1);
+            e.loadGpr(RCX, inst.rs2);
+            e.shiftCl(!word, shift, RAX);
+            if (word) e.movsxd(RAX, RAX);
+            e.storeGpr(inst.rd, RAX);
+            break;
+        }
+        case JIT_SLT: case JIT_SLTU:
+            e.loadGpr(RAX, inst.rs1);
+            e.loadGpr(RCX, inst.rs2);
+            e.aluRR(true, ALU_CMP, RAX, RCX);
+            e.setcc(inst.op == JIT_SLT ? CC_L : CC_B);
+            e.storeGpr(inst.rd, RAX);
+            break;
+        case JIT_MUL: case JIT_MULW:
+            e.loadGpr(RAX, inst.rs1);
+            e.loadGpr(RCX, inst.rs2);
+            e.imul(inst.op == JIT_MUL, RAX, RCX);
+            if (inst.op == JIT_MULW) e.movsxd(RAX, RAX);
+            e.storeGpr(inst.rd, RAX);
+            break;
+        case JIT_LUI:
+            e.movImm(RAX, inst.imm);
+            e.storeGpr(inst.rd, RAX);
+            break;
+        case JIT_AUIPC:
+            e.leaPC(RAX, off + inst.imm);
+            e.storeGpr(inst.rd, RAX);
+            break;
+        case JIT_LB: case JIT_LH: case JIT_LW: case JIT_LD: case JIT_LBU: case JIT_LHU: case JIT_LWU:
+        case JIT_SB: case JIT_SH: case JIT_SW: case JIT_SD:
+            emitMemory(e, inst, i, tlb, code_pages, exits);
+            break;
+        case JIT_BEQ: case JIT_BNE: case JIT_BLT: case JIT_BGE: case JIT_BLTU: case JIT_BGEU: {
+            HostCond cond = inst.op == JIT_BEQ ? CC_E : inst.op == JIT_BNE ? CC_NE :
+                            inst.op == JIT_BLT ? CC_L : inst.op == JIT_BGE ? CC_GE :
+                            inst.op == JIT_BLTU ? CC_B : CC_AE;
+            e.loadGpr(RAX, inst.rs1);
+            e.loadGpr(RCX, inst.rs2);
+            e.aluRR(true, ALU_CMP, RAX, RCX);
+            // mov and lea keep the flags
+            e.setExecuted(i + 1);
+            e.lea(RAX, RSI, off + inst.size);
+            e.lea(RCX, RSI, off + inst.imm);
+            e.cmovcc(cond, RAX, RCX);
+            e.ret();
+            ended = true;
+            break;
+        }
+        case JIT_JAL:
+            e.leaPC(RCX, off + inst.size);
+            e.storeGpr(inst.rd, RCX);
+            e.setExecuted(i + 1);
+            e.leaPC(RAX, off + inst.imm);
+            e.ret();
+            ended = true;
+            break;
+        case JIT_JALR:
+            e.loadGpr(RAX, inst.rs1);
+            if (inst.imm != 0) {
+                e.aluImm(true, ALU_ADD, RAX, inst.imm);
+            }
+            e.leaPC(RCX, off + inst.size);
+            e.storeGpr(inst.rd, RCX);
+            e.setExecuted(i + 1);
+            e.ret();
+            ended = true;
+            break;
+        }
+        off += inst.size;
+        count++;
+    }
+    if (!ended) {
+        e.setExecuted(count);
+        e.leaPC(RAX, off);
+        e.ret();
+    }
+    // an exit leaves before its instruction
+    std::map<uint32_t, size_t> stubs;
+    for (ExitPatch& exit : exits) {
+        auto iter = stubs.find(exit.inst);
+        if (iter == stubs.end()) {
+            iter = stubs.emplace(exit.inst, e.buf.size()).first;
+            e.setExecuted(exit.inst);
+            e.leaPC(RAX, offsets[exit.inst]);
+            e.ret();
+        }
+        e.patch(exit.pos, iter->second);
+    }
+    if (count == 0 || code_used + e.buf.size() > CODE_SIZE) {
+        return nullptr;
+    }
+    uint8_t* func = code + code_used;
+    memcpy(func, e.buf.data(), e.buf.size());
+    code_used += (e.buf.size() + 15) & ~15ULL;
+    return (JitFunc)func;
+}
+
+void JitCompiler::reset() {
+    code_used = 0;
+}
+
+#else
+
+JitCompiler::JitCompiler(SoftTLB* tlb, const std::vector<uint8_t>& code_pages) : tlb(tlb), code_pages(code_pages) {}
+
+JitCompiler::~JitCompiler() {}
+
+bool JitCompiler::supported() {
+    return false;
+}
+
+JitFunc JitCompiler::compile(const std::vector<JitInst>& insts, uint32_t& count) {
+    count = 0;
+    return nullptr;
+}
+
+void JitCompiler::reset() {}
+
+#endif
+
+} // namespace cds::arch::riscv
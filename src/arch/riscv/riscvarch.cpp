@@ -4,9 +4,23 @@
 #include "common/log.h"
 #include "config.h"
 #include "common/emuproxy.h"
+#include "common/checkpoint.h"
 #include <bit>
+#include <mutex>
 namespace cds::arch::riscv {
 
+RiscvArch::~RiscvArch() {
+    delete jit;
+    delete tlb;
+    delete[] blocks;
+    delete[] decode_cache;
+    if (env != nullptr) {
+        delete env->vdest;
+    }
+    delete env;
+    delete state;
+}
+
 void RiscvArch::afterLoad() {
     memory = CacheManager::getInstance().memory;
     state = new ArchState();
@@ -14,7 +28,25 @@ void RiscvArch::afterLoad() {
     env->state = state;
     env->arch = this;
     memset(state, 0, sizeof(ArchState));
-    initOps();
+    // the csr table is shared by all simulations in the process
+    static std::once_flag ops_flag;
+    std::call_once(ops_flag, initOps);
+    decode_cache = new DecodeCacheEntry[DECODE_CACHE_SIZE];
+    blocks = new Block[BLOCK_CACHE_SIZE];
+    code_pages.resize(memory->getSize() >> 12);
+    flushDecodeCache();
+    tlb = new SoftTLB();
+    env->tlb = tlb;
+    env->vdest = new VecDest();
+    resetTLB(tlb->itlb);
+    resetTLB(tlb->dtlb);
+    Stats::registerStat(&decode_cache_hit, "decodeCacheHit", "decode cache hit times");
+    Stats::registerStat(&decode_cache_miss, "decodeCacheMiss", "decode cache miss times");
+    Stats::registerStat(&tlb_miss, "tlbMiss", "software tlb miss times");
+    Stats::registerStat(&block_build, "blockBuild", "threaded code blocks built");
+    Stats::registerStat(&block_inst, "blockInst", "instructions run by threaded code blocks");
+    Stats::registerStat(&jit_block, "jitBlock", "blocks compiled to host code");
+    Stats::registerStat(&jit_inst, "jitInst", "instructions run by compiled host code");
 #ifdef LOG_PC
     Log::init("pc", Config::getLogFilePath("pc.log"));
 #endif
@@ -23,7 +55,7 @@ void RiscvArch::afterLoad() {
 #endif
 }
 
-std::map<std::string, size_t> name_offset_map = {
+static const std::map<std::string, size_t> name_offset_map = {
     {"misa", ARCH_MISA},
     {"priv", ARCH_PRIV},
     {"mstatus", ARCH_MSTATUS},
@@ -36,42 +68,70 @@ std::map<std::string, size_t> name_offset_map = {
 void RiscvArch::initConfig(const std::string& config_path) {
     Arch::initConfig(config_path);
     for (const auto& cfg : archConfigs) {
-        if (name_offset_map.find(cfg.name) == name_offset_map.end()) {
+        auto iter = name_offset_map.find(cfg.name);
+        if (iter == name_offset_map.end()) {
             continue;
         }
-        uint32_t offset = name_offset_map[cfg.name] + cfg.offset;
+        uint32_t offset = iter->second + cfg.offset;
         uint64_t* addr = (uint64_t*)((uint8_t*)state + offset);
         *addr = cfg.value;
     }
+    updateMMUState();
 }
 
 int RiscvArch::decode(uint64_t vaddr, uint64_t paddr, DecodeInfo* info) {
     bool rvc;
     bool decode_valid;
-    fetch(paddr, &info->inst, rvc, &info->inst_size);
     env->pc = vaddr;
     env->paddr = paddr;
     env->info = info;
+    inst_pending = true;
     memset(info, 0, DEC_MEMSET_END);
     env->info->exception = EXC_NONE;
-    decode_valid = interpreter(env, info->inst, rvc);
+    DecodeCacheEntry* entry = &decode_cache[(paddr >> 1) & DECODE_CACHE_MASK];
+    if (likely(entry->paddr == paddr)) {
+        info->inst = entry->inst;
+        info->inst_size = entry->inst_size;
+        decode_valid = entry->trans(env, entry->args);
+        decode_cache_hit++;
+    } else {
+        fetch(paddr, &info->inst, rvc, &info->inst_size);
+        env->ic = entry;
+        decode_valid = interpreter(env, info->inst, rvc);
+        env->ic = nullptr;
+        if (likely(decode_valid)) {
+            entry->paddr = paddr;
+            entry->inst = info->inst;
+            entry->inst_size = info->inst_size;
+            markCodePage(paddr);
+            markCodePage(paddr + info->inst_size - 1);
+        } else {
+            entry->paddr = -1;
+        }
+        decode_cache_miss++;
+    }
     if(unlikely(!decode_valid)) {
         Log::error("RiscvArch::decode: invalid instruction at 0x{:x}", paddr);
     }
-    bool irq_enable = (state->priv <= MODE_S) && (state->mstatus & MSTATUS_SIE) || 
-                    (state->priv == MODE_M) && (state->mstatus & MSTATUS_MIE) || (state->priv == MODE_U);
-    int64_t irq_enable_mask = -irq_enable;
-    uint32_t irq_valids = state->mip & state->mie & irq_enable_mask;
+    uint32_t irq_valids = pendingIrqs();
     if (irq_valids != 0) {
         info->exception = IRQ_MASK | (std::bit_width(irq_valids) - 1);
     }
     return info->inst_size;
 }
 
+uint32_t RiscvArch::pendingIrqs() {
+    bool irq_enable = (state->priv <= MODE_S) && (state->mstatus & MSTATUS_SIE) || 
+                    (state->priv == MODE_M) && (state->mstatus & MSTATUS_MIE) || (state->priv == MODE_U);
+    int64_t irq_enable_mask = -irq_enable;
+    return state->mip & state->mie & irq_enable_mask;
+}
+
 void RiscvArch::handleException(uint64_t exception, uint64_t paddr, DecodeInfo* info) {
     if (exception == EXC_IPF) {
         env->pc = paddr;
         env->info = info;
+        inst_pending = true;
         info->exc_data = paddr;
         info->exception = exception;
     }
@@ -123,19 +183,31 @@ inline bool RiscvArch::paddrRead(uint64_t paddr, int size, FETCH_TYPE type, uint
     return !mmio;
 }
 
-inline bool RiscvArch::paddrWrite(uint64_t paddr, int size, FETCH_TYPE type, uint8_t* data) {
+bool RiscvArch::paddrWrite(uint64_t paddr, int size, FETCH_TYPE type, uint8_t* data) {
 // impl pmp check
     bool mmio;
     memory->paddrWrite(paddr, size, data, mmio);
+    uint64_t page = (paddr - Memory::RAM_BASE) >> PGSHFT;
+    if (unlikely(page < code_pages.size() && code_pages[page])) {
+        flushDecodePage(paddr);
+    }
     return !mmio;
 }
 
 
 
 void RiscvArch::translateAddr(uint64_t vaddr, FETCH_TYPE type, uint64_t& paddr, uint64_t& exception) {
+    TLBEntry* entry = type == FETCH_TYPE::IFETCH ? &tlb->itlb[(vaddr >> PGSHFT) & TLB_MASK] :
+                                                   &tlb->dtlb[(vaddr >> PGSHFT) & TLB_MASK];
+    if (likely(tlb_hit(tlb, entry, type == FETCH_TYPE::SFETCH ? entry->tag_write : entry->tag_read, vaddr))) {
+        paddr = entry->paddr | (vaddr & TLB_PGMASK);
+        return;
+    }
+    tlb_miss++;
     if (type == FETCH_TYPE::IFETCH && !ifetch_mmu_state ||
         type != FETCH_TYPE::IFETCH && !data_mmu_state) {
         paddr = vaddr;
+        fillTLB(entry, vaddr, paddr, type, true);
         return;
     }
     paddr = (state->satp & 0xfffffffffff) << PGSHFT;
@@ -186,6 +258,49 @@ void RiscvArch::translateAddr(uint64_t vaddr, FETCH_TYPE type, uint64_t& paddr,
         }
     }
     paddr = (paddr & ~pg_mask) | (vaddr & pg_mask);
+    tlb_superpage |= level > 0;
+    fillTLB(entry, vaddr, paddr, type, pte.g);
+}
+
+void RiscvArch::fillTLB(TLBEntry* entry, uint64_t vaddr, uint64_t paddr, FETCH_TYPE type, bool global) {
+    uint64_t vpn = vaddr >> PGSHFT;
+    uint64_t asid = global ? TLB_ASID_GLOBAL : tlb->asid;
+    if (entry->asid != asid || (entry->tag_read != vpn && entry->tag_write != vpn)) {
+        entry->tag_read = -1;
+        entry->tag_write = -1;
+    }
+    entry->asid = asid;
+    entry->paddr = paddr & ~TLB_PGMASK;
+    entry->host = memory->getHostAddr(entry->paddr);
+    // a writable pte is also readable and its accessed bit is set
+    if (type == FETCH_TYPE::SFETCH) {
+        entry->tag_write = vpn;
+    }
+    entry->tag_read = vpn;
+}
+
+void RiscvArch::flushTLB(uint64_t vaddr, uint64_t asid) {
+    if (vaddr == 0 || tlb_superpage) {
+        resetTLB(tlb->itlb);
+        resetTLB(tlb->dtlb);
+        tlb_superpage = false;
+        return;
+    }
+    uint64_t vpn = vaddr >> PGSHFT;
+    TLBEntry* entries[2] = {&tlb->itlb[vpn & TLB_MASK], &tlb->dtlb[vpn & TLB_MASK]};
+    for (TLBEntry* entry : entries) {
+        if (entry->tag_read == vpn || entry->tag_write == vpn) {
+            entry->tag_read = -1;
+            entry->tag_write = -1;
+        }
+    }
+}
+
+void RiscvArch::resetTLB(TLBEntry* entries) {
+    for (int i = 0; i < TLB_SIZE; i++) {
+        entries[i].tag_read = -1;
+        entries[i].tag_write = -1;
+    }
 }
 
 
@@ -202,9 +317,46 @@ inline void RiscvArch::fetch(uint64_t paddr, uint32_t* inst, bool& rvc, uint8_t*
     *size = 4 >> rvc;
 }   
 
+inline void RiscvArch::markCodePage(uint64_t paddr) {
+    uint64_t page = (paddr - Memory::RAM_BASE) >> PGSHFT;
+    if (page < code_pages.size()) {
+        code_pages[page] = 1;
+    }
+}
+
+void RiscvArch::flushDecodePage(uint64_t paddr) {
+    uint64_t page_base = paddr & ~((1ULL << PGSHFT) - 1);
+    // entries of one page occupy a contiguous window of the decode cache
+    uint32_t idx = (page_base >> 1) & DECODE_CACHE_MASK;
+    for (uint32_t i = 0; i < (1 << (PGSHFT - 1)); i++) {
+        if ((decode_cache[idx + i].paddr & ~((1ULL << PGSHFT) - 1)) == page_base) {
+            decode_cache[idx + i].paddr = -1;
+        }
+    }
+    // 32bit instruction at the end of the previous page
+    DecodeCacheEntry* entry = &decode_cache[((page_base - 2) >> 1) & DECODE_CACHE_MASK];
+    if (entry->paddr == page_base - 2) {
+        entry->paddr = -1;
+    }
+    code_pages[(page_base - Memory::RAM_BASE) >> PGSHFT] = 0;
+    flushBlocks(page_base);
+}
+
+void RiscvArch::flushDecodeCache() {
+    for (uint32_t i = 0; i < DECODE_CACHE_SIZE; i++) {
+        decode_cache[i].paddr = -1;
+    }
+    std::fill(code_pages.begin(), code_pages.end(), 0);
+    for (uint32_t i = 0; i < BLOCK_CACHE_SIZE; i++) {
+        blocks[i].paddr = -1;
+    }
+    block_epoch++;
+}
+
 uint64_t RiscvArch::updateEnv() {
     DecodeInfo* info = env->info;
     ArchState* state = env->state;
+    inst_pending = false;
     uint64_t exception_idx = info->exception & EXC_MASK;
     uint64_t exception_mask = (1 << exception_idx);
     uint64_t irq = (int64_t)info->exception < 0;
@@ -318,6 +470,23 @@ xtval_end:;
                             paddrWrite(ha, info->dst_idx[2], FETCH_TYPE::SFETCH, (uint8_t*)&info->dst_data[2]);
                         }
                         break;
+                    case IFENCE:
+                        flushDecodeCache();
+                        break;
+                    case SFENCE:
+                        flushTLB(info->dst_data[1], info->dst_data[2]);
+                        break;
+                    default:
+                        break;
+                }
+                if (info->type >= VEC_START && info->type <= VEC_END) {
+                    VecDest* vdest = env->vdest;
+                    for (int i = 0; i < vdest->nstores; i++) {
+                        VecStore& store = vdest->stores[i];
+                        paddrWrite(store.paddr, store.size, FETCH_TYPE::SFETCH, vdest->data + store.offset);
+                    }
+                    memcpy(state->vreg[vdest->vd], vdest->data, vdest->nregs * VLENB);
+                    state->vstart = 0;
                 }
                 state->gpr[0] = 0;
                 updateMMUState();
@@ -380,6 +549,28 @@ void RiscvArch::updateMMUState() {
     ifetch_mmu_state = (state->satp >> 60) == 8 && (state->priv != MODE_M);
     data_mmu_state = (state->satp >> 60) == 8 && (((state->mstatus & MSTATUS_MPRV) ? 
                                         (state->mstatus & MSTATUS_MPP) >> MSTATUS_MPP_SHIFT : state->priv) != MODE_M);
+    // permission of cached translations depends on privilege, mprv, sum and mxr
+    uint64_t ikey = state->priv | (ifetch_mmu_state << 2);
+    uint64_t dkey = state->priv | (data_mmu_state << 2) |
+                    (state->mstatus & (MSTATUS_MPRV | MSTATUS_MPP | MSTATUS_SUM | MSTATUS_MXR));
+    if (unlikely(ikey != itlb_key)) {
+        resetTLB(tlb->itlb);
+        itlb_key = ikey;
+    }
+    if (unlikely(dkey != dtlb_key)) {
+        resetTLB(tlb->dtlb);
+        dtlb_key = dkey;
+    }
+    if (unlikely(state->satp != tlb_satp)) {
+        uint64_t asid = (state->satp >> 44) & 0xffff;
+        // entries are tagged by asid, only a new root table under the same asid needs a flush
+        if (asid == tlb->asid && (state->satp & 0xfffffffffff) != (tlb_satp & 0xfffffffffff)) {
+            resetTLB(tlb->itlb);
+            resetTLB(tlb->dtlb);
+        }
+        tlb->asid = asid;
+        tlb_satp = state->satp;
+    }
 }
 
 void RiscvArch::irqListener(uint64_t irq) {
@@ -419,10 +610,34 @@ void RiscvArch::flushCache(uint8_t id, uint64_t addr, uint32_t asid) {
     } else if (id == 1) {
         CacheManager::getInstance().getDCache()->flush(addr, asid);
     } else if (id == 2) {
-        // TODO: MMU flush
+        flushTLB(addr, asid);
     }
 }
 
+void RiscvArch::save(Checkpoint* cp) {
+    cp->write((uint64_t)sizeof(ArchState));
+    cp->write(*state);
+}
+
+void RiscvArch::restore(Checkpoint* cp) {
+    uint64_t size;
+    cp->read(size);
+    if (size != sizeof(ArchState)) {
+        Log::error("RiscvArch::restore: ArchState size mismatch, checkpoint {}, current {}", size, sizeof(ArchState));
+        ExitHandler::exit(1);
+    }
+    cp->read(*state);
+    // cached decode and translation belong to the old memory image
+    flushDecodeCache();
+    resetTLB(tlb->itlb);
+    resetTLB(tlb->dtlb);
+    itlb_key = -1;
+    dtlb_key = -1;
+    tlb_satp = state->satp;
+    tlb->asid = (state->satp >> 44) & 0xffff;
+    updateMMUState();
+}
+
 bool RiscvArch::exceptionValid(uint64_t exception) {
     return exception != EXC_NONE;
 }
@@ -446,6 +661,13 @@ static void fs(DisasContext *ctx, int csrno) {
     ctx->info->exception = EXC_II;
 }
 
+static void vs(DisasContext *ctx, int csrno) {
+    if (ctx->state->mstatus & MSTATUS_VS) {
+        return;
+    }
+    ctx->info->exception = EXC_II;
+}
+
 static void ctr(DisasContext *ctx, int csrno) {
     if (csrno >= CSR_CYCLE && csrno <= CSR_INSTRET) {
         uint64_t ctr_mask;
@@ -579,6 +801,95 @@ csrw_func_def(fcsr) {
     ctx->info->dst_data[2] = MSTATUS_FS;
 }
 
+static bool vector_enabled(DisasContext *ctx) {
+    if (!(ctx->state->mstatus & MSTATUS_VS)) {
+        ctx->info->exception = EXC_II;
+        return false;
+    }
+    ctx->state->mstatus |= MSTATUS_VS;
+    return true;
+}
+
+csrr_func_def(vstart) {
+    if (!vector_enabled(ctx)) return;
+    *val = ctx->state->vstart;
+}
+
+csrw_func_def(vstart) {
+    if (!vector_enabled(ctx)) return;
+    ctx->info->dst_idx[1] = ARCH_VSTART;
+    ctx->info->dst_mask[1] = 0xffffffffffffffff;
+    ctx->info->dst_data[1] = val & (VLEN - 1);
+
+    ctx->info->dst_idx[2] = ARCH_MSTATUS;
+    ctx->info->dst_mask[2] = MSTATUS_VS;
+    ctx->info->dst_data[2] = MSTATUS_VS;
+}
+
+csrr_func_def(vxsat) {
+    if (!vector_enabled(ctx)) return;
+    *val = ctx->state->vxsat;
+}
+
+csrw_func_def(vxsat) {
+    if (!vector_enabled(ctx)) return;
+    ctx->info->dst_idx[1] = ARCH_VXSAT;
+    ctx->info->dst_mask[1] = 0xffffffffffffffff;
+    ctx->info->dst_data[1] = val & 1;
+
+    ctx->info->dst_idx[2] = ARCH_MSTATUS;
+    ctx->info->dst_mask[2] = MSTATUS_VS;
+    ctx->info->dst_data[2] = MSTATUS_VS;
+}
+
+csrr_func_def(vxrm) {
+    if (!vector_enabled(ctx)) return;
+    *val = ctx->state->vxrm;
+}
+
+csrw_func_def(vxrm) {
+    if (!vector_enabled(ctx)) return;
+    ctx->info->dst_idx[1] = ARCH_VXRM;
+    ctx->info->dst_mask[1] = 0xffffffffffffffff;
+    ctx->info->dst_data[1] = val & 3;
+
+    ctx->info->dst_idx[2] = ARCH_MSTATUS;
+    ctx->info->dst_mask[2] = MSTATUS_VS;
+    ctx->info->dst_data[2] = MSTATUS_VS;
+}
+
+csrr_func_def(vcsr) {
+    if (!vector_enabled(ctx)) return;
+    *val = (ctx->state->vxrm << 1) | ctx->state->vxsat;
+}
+
+// mstatus.VS is already dirty after vector_enabled, both entries hold vcsr fields
+csrw_func_def(vcsr) {
+    if (!vector_enabled(ctx)) return;
+    ctx->info->dst_idx[1] = ARCH_VXSAT;
+    ctx->info->dst_mask[1] = 0xffffffffffffffff;
+    ctx->info->dst_data[1] = val & 1;
+
+    ctx->info->dst_idx[2] = ARCH_VXRM;
+    ctx->info->dst_mask[2] = 0xffffffffffffffff;
+    ctx->info->dst_data[2] = (val >> 1) & 3;
+}
+
+csrr_func_def(vl) {
+    if (!vector_enabled(ctx)) return;
+    *val = ctx->state->vl;
+}
+
+csrr_func_def(vtype) {
+    if (!vector_enabled(ctx)) return;
+    *val = ctx->state->vtype;
+}
+
+csrr_func_def(vlenb) {
+    if (!vector_enabled(ctx)) return;
+    *val = VLENB;
+}
+
 static uint64_t get_ticks(DisasContext *ctx) {
     return ctx->arch->getTick();
 }
@@ -625,7 +936,8 @@ csrr_func_def(mhartid) {
 
 csrr_func_def(mstatus) {
     *val = (ctx->state->mstatus & (MSTATUS_MASK | MSTATUS64_UXL | MSTATUS64_SXL)) | 
-            ((uint64_t)((ctx->state->mstatus & MSTATUS_FS) == MSTATUS_FS) << MSTATUS64_SD);
+            ((uint64_t)((ctx->state->mstatus & MSTATUS_FS) == MSTATUS_FS ||
+                        (ctx->state->mstatus & MSTATUS_VS) == MSTATUS_VS) << MSTATUS64_SD);
 }
 
 csrw_func_def(mstatus) {
@@ -757,7 +1069,8 @@ csrw_func_def(senvcfg) {
 
 csrr_func_def(sstatus) {
     *val = (ctx->state->mstatus & (SSTATUS_MASK | MSTATUS64_UXL)) | 
-           ((uint64_t)((ctx->state->mstatus & MSTATUS_FS) == MSTATUS_FS) << MSTATUS64_SD);
+           ((uint64_t)((ctx->state->mstatus & MSTATUS_FS) == MSTATUS_FS ||
+                       (ctx->state->mstatus & MSTATUS_VS) == MSTATUS_VS) << MSTATUS64_SD);
 }
 
 csrw_func_def(sstatus) {
@@ -895,6 +1208,14 @@ void RiscvArch::initOps() {
     csr_ops[CSR_FFLAGS]   = { "fflags",   fs,     read_fflags,  write_fflags };
     csr_ops[CSR_FRM]      = { "frm",      fs,     read_frm,     write_frm    };
     csr_ops[CSR_FCSR]     = { "fcsr",     fs,     read_fcsr,    write_fcsr   };
+    /* User Vector CSRs */
+    csr_ops[CSR_VSTART]   = { "vstart",   vs,     read_vstart,  write_vstart };
+    csr_ops[CSR_VXSAT]    = { "vxsat",    vs,     read_vxsat,   write_vxsat  };
+    csr_ops[CSR_VXRM]     = { "vxrm",     vs,     read_vxrm,    write_vxrm   };
+    csr_ops[CSR_VCSR]     = { "vcsr",     vs,     read_vcsr,    write_vcsr   };
+    csr_ops[CSR_VL]       = { "vl",       vs,     read_vl                    };
+    csr_ops[CSR_VTYPE]    = { "vtype",    vs,     read_vtype                 };
+    csr_ops[CSR_VLENB]    = { "vlenb",    vs,     read_vlenb                 };
     /* User Timers and Counters */
     csr_ops[CSR_CYCLE]    = { "cycle",    ctr,    read_cycle    };
     csr_ops[CSR_INSTRET]  = { "instret",  ctr,    read_instret  };
@@ -1,19 +1,32 @@
 #include "cache/cache.h"
 #include "cache/replace/lru.h"
+#include "cache/replace/plru.h"
+#include "cache/replace/rrip.h"
+#include "cache/replace/random.h"
 #include "common/log.h"
+#include "common/checkpoint.h"
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 void Cache::setParent(Cache* parent) {
     this->parent = parent;
+    if (parent != nullptr) {
+        parent->children.push_back(this);
+    }
 }
 
 Cache::~Cache() {
-    for (int i = 0; i < set_size; i++) {
-        for (int j = 0; j < way; j++) {
-            delete tagvs[i][j];
-        }
-        delete[] tagvs[i];
-    }
-    delete[] tagvs;
+    // memory and devices have no tag array, free(nullptr) is a no-op
+    free(tags);
+    delete[] valid_mask;
+    delete[] dirty_mask;
+    delete[] shared_mask;
+    delete replace;
 }
 
 void Cache::splitAddr(uint64_t addr, uint64_t& tag, uint32_t& set, uint32_t& offset) {
@@ -26,13 +39,63 @@ uint32_t Cache::getOffset(uint64_t addr) {
     return addr & line_mask;
 }
 
-CacheTagv* Cache::match(uint64_t tag, uint32_t set) {
+int Cache::match(uint64_t tag, uint32_t set) {
+    const uint64_t* set_tags = tags + (uint64_t)set * way_stride;
+    uint64_t hit = 0;
+#if defined(__AVX2__)
+    // compare four ways per instruction, padding ways are masked by valid_mask
+    __m256i key = _mm256_set1_epi64x(tag);
+    for (int i = 0; i < way_stride; i += 4) {
+        __m256i eq = _mm256_cmpeq_epi64(_mm256_load_si256((const __m256i*)(set_tags + i)), key);
+        hit |= (uint64_t)_mm256_movemask_pd(_mm256_castsi256_pd(eq)) << i;
+    }
+#else
     for (int i = 0; i < way; i++) {
-        if (tagvs[set][i]->valid && tagvs[set][i]->tag == tag) {
-            return tagvs[set][i];
-        }
+        hit |= (uint64_t)(set_tags[i] == tag) << i;
+    }
+#endif
+    hit &= valid_mask[set];
+    return hit == 0 ? -1 : std::countr_zero(hit);
+}
+
+void Cache::invalidateSet(uint32_t set) {
+    valid_mask[set] = 0;
+    for (int i = 0; i < way; i++) {
+        replace->clear(set, i);
+    }
+}
+
+void Cache::fill(uint32_t set, int way_idx, uint64_t tag, bool dirty) {
+    uint64_t bit = 1ULL << way_idx;
+    uint64_t& way_tag = tags[(uint64_t)set * way_stride + way_idx];
+    if (valid_mask[set] & bit) {
+        evict((way_tag << tag_offset) | ((uint64_t)set << index_offset), dirty_mask[set] & bit);
+    }
+    way_tag = tag;
+    valid_mask[set] |= bit;
+    shared_mask[set] &= ~bit;
+    dirty_mask[set] = dirty ? dirty_mask[set] | bit : dirty_mask[set] & ~bit;
+}
+
+void Cache::evict(uint64_t addr, bool dirty) {
+    if (parent != nullptr) {
+        parent->childEvict(addr, dirty);
     }
-    return nullptr;
+}
+
+bool Cache::invalidate(uint64_t addr, bool& dirty) {
+    uint64_t tag;
+    uint32_t set, offset;
+    splitAddr(addr, tag, set, offset);
+    int way_idx = match(tag, set);
+    if (way_idx < 0) {
+        return false;
+    }
+    uint64_t bit = 1ULL << way_idx;
+    dirty |= (dirty_mask[set] & bit) != 0;
+    valid_mask[set] &= ~bit;
+    replace->clear(set, way_idx);
+    return true;
 }
 
 uint8_t Cache::setCallback(cache_callback_t const & callback) {
@@ -44,7 +107,19 @@ uint8_t Cache::setCallback(cache_callback_t const & callback) {
 void Cache::afterLoad() {
     if (replace_method == "lru") {
         replace = new LRUReplace();
-        replace->setParams(2, set_size, way);
+    } else if (replace_method == "plru") {
+        replace = new PLRUReplace();
+    } else if (replace_method == "srrip") {
+        replace = new RRIPReplace(SRRIP);
+    } else if (replace_method == "brrip") {
+        replace = new RRIPReplace(BRRIP);
+    } else if (replace_method == "drrip") {
+        replace = new RRIPReplace(DRRIP);
+    } else if (replace_method == "random") {
+        replace = new RandomReplace();
+    } else {
+        std::cerr << "Error: cache level " << level << " has unknown replace method " << replace_method << std::endl;
+        ExitHandler::exit(1);
     }
     line_byte = line_size / 8;
     tag_offset = log2(line_size) + log2(set_size);
@@ -52,11 +127,69 @@ void Cache::afterLoad() {
     set_mask = set_size - 1;
     line_mask = line_size - 1;
 
-    tagvs = new CacheTagv**[set_size];
+    if (way > 64) {
+        std::cerr << "Error: cache level " << level << " has " << way << " ways, at most 64 are supported" << std::endl;
+        ExitHandler::exit(1);
+    }
+    replace->setParams(2, set_size, way);
+    way_stride = (way + 7) & ~7;
+    uint64_t tag_bytes = (uint64_t)set_size * way_stride * sizeof(uint64_t);
+    tags = (uint64_t*)aligned_alloc(64, tag_bytes);
+    memset(tags, 0, tag_bytes);
+    valid_mask = new uint64_t[set_size]();
+    dirty_mask = new uint64_t[set_size]();
+    shared_mask = new uint64_t[set_size]();
+}
+
+void Cache::warm(uint64_t addr, bool is_write) {
+    uint64_t tag;
+    uint32_t set, offset;
+    splitAddr(addr, tag, set, offset);
+    int hit_way = match(tag, set);
+    if (hit_way < 0) {
+        bool dirty = parent != nullptr && parent->childWarm(addr);
+        fill(set, replace->get(set), tag, is_write || dirty);
+    } else {
+        replace->insert(set, hit_way);
+        if (is_write) {
+            setDirty(set, hit_way);
+        }
+    }
+}
+
+void Cache::save(Checkpoint* cp) {
+    cp->write(set_size);
+    cp->write(way);
+    // keep the per line record so older checkpoints stay readable
+    for (int i = 0; i < set_size; i++) {
+        for (int j = 0; j < way; j++) {
+            CacheTagv tagv{};
+            tagv.tag = tags[(uint64_t)i * way_stride + j];
+            tagv.valid = (valid_mask[i] >> j) & 1;
+            tagv.shared = (shared_mask[i] >> j) & 1;
+            tagv.dirty = (dirty_mask[i] >> j) & 1;
+            cp->write(tagv);
+        }
+    }
+}
+
+void Cache::restore(Checkpoint* cp) {
+    int cp_set_size, cp_way;
+    cp->read(cp_set_size);
+    cp->read(cp_way);
+    if (cp_set_size != set_size || cp_way != way) {
+        Log::warn("cache level {} geometry changed, tags are not restored", level);
+        return;
+    }
     for (int i = 0; i < set_size; i++) {
-        tagvs[i] = new CacheTagv*[way];
+        valid_mask[i] = dirty_mask[i] = shared_mask[i] = 0;
         for (int j = 0; j < way; j++) {
-            tagvs[i][j] = new CacheTagv();
+            CacheTagv tagv;
+            cp->read(tagv);
+            tags[(uint64_t)i * way_stride + j] = tagv.tag;
+            valid_mask[i] |= (uint64_t)tagv.valid << j;
+            shared_mask[i] |= (uint64_t)tagv.shared << j;
+            dirty_mask[i] |= (uint64_t)tagv.dirty << j;
         }
     }
 }
\ No newline at end of file
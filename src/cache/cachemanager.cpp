@@ -1,6 +1,16 @@
 #include "cache/cachemanager.h"
 #include "device/irqhandler.h"
 #include "common/log.h"
+#include "common/checkpoint.h"
+
+CacheManager::~CacheManager() {
+    for (auto cache : cache_map) {
+        delete cache.second;
+    }
+    // memory deletes the devices it was given
+    delete memory;
+    delete phys_map;
+}
 
 void CacheManager::afterLoad() {
     for (auto cache : cache_map) {
@@ -22,6 +32,45 @@ void CacheManager::afterLoad() {
 
     memory->setDevices(devices);
     memory->afterLoad();
+
+    // device ranges are known after afterLoad
+    phys_map = new PhysMap();
+    phys_map->addRam(Memory::RAM_BASE, memory->getSize(), memory->getRam());
+    for (auto device : devices) {
+        phys_map->addDevice(device);
+    }
+    memory->setPhysMap(phys_map);
+}
+
+void CacheManager::save(Checkpoint* cp) {
+    cp->addSection("memory");
+    memory->save(cp);
+    for (size_t i = 0; i < devices.size(); i++) {
+        cp->addSection("device" + std::to_string(i));
+        devices[i]->save(cp);
+    }
+    if (cp->uarch) {
+        for (auto cache : cache_map) {
+            cp->addSection("cache" + std::to_string(cache.first));
+            cache.second->save(cp);
+        }
+    }
+}
+
+void CacheManager::restore(Checkpoint* cp) {
+    if (cp->findSection("memory")) {
+        memory->restore(cp);
+    }
+    for (size_t i = 0; i < devices.size(); i++) {
+        if (cp->findSection("device" + std::to_string(i))) {
+            devices[i]->restore(cp);
+        }
+    }
+    for (auto cache : cache_map) {
+        if (cp->findSection("cache" + std::to_string(cache.first))) {
+            cache.second->restore(cp);
+        }
+    }
 }
 
 Cache* CacheManager::getICache() {
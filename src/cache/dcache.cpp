@@ -1,26 +1,21 @@
 #include "cache/dcache.h"
+#include <cstring>
 
 void DCache::afterLoad() {
     callback_id = parent->setCallback([this](uint16_t* ids, CacheTagv* tagv_i) {
-        CacheTagv* tagv = this->tagvs[this->lookup_set][this->replace_way];
-        tagv->tag = this->lookup_tag;
-        tagv->valid = true;
-        tagv->dirty = this->lookup_req->req == WRITE_BACK;
-        if (this->req_clear_wait) {
-            this->req_clear_wait = false;
-        } else {
-            this->callbacks[0](this->lookup_req->id, nullptr);
-            this->state = REFILL;
-        }
+        this->refill(ids[1], tagv_i);
     });
-    lookup_req = new CacheReq;
-    lookup_req->id[1] = 0;
-    lookup_req->size = line_size;
+    mshrs.init(mshr_num, mshr_target_num, line_size);
+    Stats::registerStat(&mshrs.alloc, "mshrAlloc", "dcache misses that allocated an MSHR");
+    Stats::registerStat(&mshrs.merge, "mshrMerge", "dcache misses merged into an outstanding MSHR");
+    Stats::registerStat(&mshrs.full_stall, "mshrFullStall", "ticks a dcache miss waited for a free MSHR or target");
+    Stats::registerStat(&mshr_occupancy, "mshrOccupancy", "busy MSHRs summed over all ticks");
+    Stats::registerRatio(&mshr_occupancy, &mshrs.alloc, "mshrMissLatency", "mean ticks an MSHR is busy");
     Cache::afterLoad();
 }
 
 bool DCache::lookup(int callback_id, CacheReq* req) {
-    if (!flush_valid && (state == IDLE || (state == LOOKUP && _match && lookup_req->req != WRITE_BACK))) {
+    if (!flush_valid && !idle_req_valid && write_cycle == 0) {
         idle_req = req;
         idle_req_valid = true;
         return true;
@@ -29,57 +24,33 @@ bool DCache::lookup(int callback_id, CacheReq* req) {
 }
 
 void DCache::tick() {
+    mshr_occupancy += mshrs.validNum();
+    mshrs.issue(parent, callback_id);
     if (flush_valid) {
         flush_num--;
-        for (int i = 0; i < way; i++) {
-            tagvs[flush_set][i]->valid = false;
-        }
+        invalidateSet(flush_set);
         flush_set = (flush_set + 1) % set_size;
         if (flush_num == 0) {
             flush_valid = false;
         }
-    } else {
-        switch(state) {
-            case IDLE: {
-                if (idle_req_valid) {
-                    state = LOOKUP;
-                    handleIdleReq();
-                }
-                break;
-            }
-            case LOOKUP: {
-                if (!_match) {
-                    if (!req_clear_wait) {
-                        bool success = parent->lookup(callback_id, lookup_req);
-                        if (success) {
-                            replace_way = replace->get(lookup_set);
-                            state = MISS;
-                        }
-                    }
-                } else if (lookup_req->req == WRITE_BACK) {
-                    state = WRITE;
-                    lookup_tagv->dirty = true;
-                } else if (idle_req_valid) {
-                    handleIdleReq();
-                } else {
-                    state = IDLE;
-                }
-                break;
-            }
-            case WRITE: {
-                state = IDLE;
-                break;
-            }
-            case MISS: {
-                break;
-            }
-            case REFILL: {
-                state = IDLE;
-                idle_req_valid = false;
-                break;
-            }
-        }
+    } else if (write_cycle > 0) {
+        write_cycle--;
+    } else if (idle_req_valid) {
+        handleIdleReq();
+    }
+}
+
+uint64_t DCache::nextTick() {
+    if (flush_valid || write_cycle > 0 || mshrs.issuing() || (idle_req_valid && !mshrs.stall)) {
+        return getTick();
     }
+    // misses only move on in the refill callback of the parent
+    return -1;
+}
+
+void DCache::skip(uint64_t ticks) {
+    mshr_occupancy += mshrs.validNum() * ticks;
+    mshrs.skip(ticks);
 }
 
 void DCache::flush(uint64_t addr, uint32_t asid) {
@@ -90,22 +61,38 @@ void DCache::flush(uint64_t addr, uint32_t asid) {
 
 void DCache::redirect() {
     idle_req_valid = false;
-    if (state == MISS || state == REFILL) {
-        req_clear_wait = true;
+    write_cycle = 0;
+    mshrs.clearTargets();
+}
+
+void DCache::refill(int idx, CacheTagv* tagv_i) {
+    auto& mshr = mshrs.refill(idx);
+    fill(mshr.set, replace->get(mshr.set), mshr.tag, mshr.dirty || (tagv_i != nullptr && tagv_i->dirty));
+    for (auto& id : mshr.targets) {
+        callbacks[0](id.data(), nullptr);
     }
-    state = IDLE;
 }
 
 void DCache::handleIdleReq() {
-    lookup_req->addr = idle_req->addr;
-    lookup_req->id[0] = idle_req->id[0];
-    lookup_req->req = idle_req->req;
-    idle_req_valid = false;
-    uint32_t offset;
-    splitAddr(lookup_req->addr, lookup_tag, lookup_set, offset);
-    lookup_tagv = match(lookup_tag, lookup_set);
-    _match = lookup_tagv != nullptr;
-    if (_match) {
-        callbacks[0](lookup_req->id, nullptr);
+    uint64_t tag;
+    uint32_t set, offset;
+    splitAddr(idle_req->addr, tag, set, offset);
+    bool is_write = idle_req->req == WRITE_BACK;
+    int way_idx = match(tag, set);
+    if (way_idx >= 0) {
+        idle_req_valid = false;
+        replace->insert(set, way_idx);
+        if (is_write) {
+            setDirty(set, way_idx);
+            write_cycle = 2;
+        }
+        callbacks[0](idle_req->id, nullptr);
+        return;
     }
-}
\ No newline at end of file
+
+    std::array<uint16_t, 4> id;
+    memcpy(id.data(), idle_req->id, sizeof(idle_req->id));
+    if (mshrs.add(set, tag, idle_req->addr, idle_req->req, id, is_write)) {
+        idle_req_valid = false;
+    }
+}
@@ -3,9 +3,8 @@
 void ICache::afterLoad() {
     callback_id = parent->setCallback([this](uint16_t* ids, CacheTagv* tagv_i) {
         in_callback = true;
-        CacheTagv* tagv = this->tagvs[this->lookup_set][this->replace_way];
-        tagv->tag = this->lookup_tag;
-        tagv->valid = true; 
+        this->replace_way = this->replace->get(this->lookup_set);
+        this->fill(this->lookup_set, this->replace_way, this->lookup_tag, tagv_i != nullptr && tagv_i->dirty);
         if (this->req_clear_wait) {
             this->req_clear_wait = false;
         } else {
@@ -37,9 +36,7 @@ bool ICache::lookup(int callback_id, CacheReq* req) {
 void ICache::tick() {
     if (unlikely(flush_valid)) {
         flush_num--;
-        for (int i = 0; i < way; i++) {
-            tagvs[flush_set][i]->valid = false;
-        }
+        invalidateSet(flush_set);
         flush_set = (flush_set + 1) % set_size;
         if (flush_num == 0) {
             flush_valid = false;
@@ -57,11 +54,12 @@ void ICache::tick() {
                 if (!_match) {
                     lookup_req->id[1] = current_id;
                     if (!req_clear_wait) {
-                        bool success = parent->lookup(callback_id, lookup_req);
-                        if (success) {
-                            replace_way = replace->get(lookup_set);
-                            state = MISS;
+                        // the parent may refill before lookup returns
+                        state = MISS;
+                        if (parent->lookup(callback_id, lookup_req)) {
                             current_id++;
+                        } else {
+                            state = LOOKUP;
                         }
                     }
                 } else if (idle_req_valid) {
@@ -83,6 +81,17 @@ void ICache::tick() {
     }
 }
 
+uint64_t ICache::nextTick() {
+    if (unlikely(flush_valid)) {
+        return getTick();
+    }
+    // a miss only moves on in the refill callback of the parent
+    if ((state == IDLE && !idle_req_valid) || state == MISS || (state == LOOKUP && !_match && req_clear_wait)) {
+        return -1;
+    }
+    return getTick();
+}
+
 void ICache::flush(uint64_t addr, uint32_t asid) {
     flush_set = 0;
     flush_num = set_size;
@@ -103,9 +112,10 @@ void ICache::handleIdleReq() {
     idle_req_valid = false;
     uint32_t offset;
     splitAddr(lookup_req->addr, lookup_tag, lookup_set, offset);
-    CacheTagv* tagv = match(lookup_tag, lookup_set);
-    _match = tagv != nullptr;
+    int hit_way = match(lookup_tag, lookup_set);
+    _match = hit_way >= 0;
     if (_match) {
+        replace->insert(lookup_set, hit_way);
         callbacks[0](lookup_req->id, nullptr);
     }
 }
\ No newline at end of file
@@ -4,6 +4,10 @@
 #include "config.h"
 #include "common/emuproxy.h"
 #include "common/log.h"
+#include "common/checkpoint.h"
+
+#define RAM_PAGE_MASK 0xfffULL
+#define HUGEPAGE_SIZE (2ULL << 20)
 
 Memory::Memory(const std::string& filename) {
     this->filename = filename;
@@ -42,11 +46,25 @@ void Memory::afterLoad() {
     result->valid = true;
     result->shared = true;
     result->dirty = false;
-    ram = (uint8_t *)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE, -1, 0);
-    if (ram == (uint8_t*)MAP_FAILED) {
+    // reserve 2MB aligned guest ram so transparent hugepages can back it,
+    // pages are only allocated when the guest touches them
+    uint64_t ram_size = (size + RAM_PAGE_MASK) & ~RAM_PAGE_MASK;
+    uint64_t map_size = ram_size + HUGEPAGE_SIZE;
+    uint8_t* map = (uint8_t *)mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE | MAP_NORESERVE, -1, 0);
+    if (map == (uint8_t*)MAP_FAILED) {
         Log::error("could not mmap memory size {}", size);
         ExitHandler::exit(1);
     }
+    ram = (uint8_t*)(((uint64_t)map + HUGEPAGE_SIZE - 1) & ~(HUGEPAGE_SIZE - 1));
+    if (ram != map) {
+        munmap(map, ram - map);
+    }
+    if (map + map_size != ram + ram_size) {
+        munmap(ram + ram_size, map + map_size - (ram + ram_size));
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(ram, ram_size, MADV_HUGEPAGE);
+#endif
 
 #ifdef LOG_MEM
     Log::init("mem", Config::getLogFilePath("mem.log"));
@@ -90,15 +108,54 @@ void Memory::afterLoad() {
       filesize = size;
     }
 
-    fseek(fp, 0, SEEK_SET);
-    int ret = fread(ram, filesize, 1, fp);
+    // map the image copy on write over the start of ram, it is read from
+    // the file on first touch and guest writes never reach the file
+    uint64_t image_size = (filesize + RAM_PAGE_MASK) & ~RAM_PAGE_MASK;
+    if (filesize == 0 || mmap(ram, image_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+                              fileno(fp), 0) == MAP_FAILED) {
+        // not mappable (e.g. a pipe), fall back to reading it
+        if (image_size != 0 && mmap(ram, image_size, PROT_READ | PROT_WRITE,
+                                    MAP_ANON | MAP_PRIVATE | MAP_FIXED | MAP_NORESERVE, -1, 0) == MAP_FAILED) {
+            Log::error("could not mmap memory size {}", image_size);
+            ExitHandler::exit(1);
+        }
+        fseek(fp, 0, SEEK_SET);
+        int ret = filesize == 0 ? 1 : fread(ram, filesize, 1, fp);
+        assert(ret == 1);
+    }
 #ifdef DIFFTEST
     NemuProxy::getInstance().memcpy(0x80000000, ram, filesize, DUT_TO_REF);
 #endif
-    assert(ret == 1);
     fclose(fp);
 }
 
+void Memory::save(Checkpoint* cp) {
+    cp->write(size);
+    cp->writePages(ram, size);
+}
+
+void Memory::restore(Checkpoint* cp) {
+    uint64_t cp_size;
+    cp->read(cp_size);
+    if (cp_size != size) {
+        Log::error("Memory::restore: memory size mismatch, checkpoint {}, current {}", cp_size, size);
+        ExitHandler::exit(1);
+    }
+    // drop the image mapping, the checkpoint holds every non-zero page
+    uint64_t ram_size = (size + RAM_PAGE_MASK) & ~RAM_PAGE_MASK;
+    if (mmap(ram, ram_size, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE | MAP_FIXED | MAP_NORESERVE, -1, 0) == MAP_FAILED) {
+        Log::error("could not mmap memory size {}", size);
+        ExitHandler::exit(1);
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(ram, ram_size, MADV_HUGEPAGE);
+#endif
+    cp->readPages(ram, size);
+#ifdef DIFFTEST
+    NemuProxy::getInstance().memcpy(0x80000000, ram, size, DUT_TO_REF);
+#endif
+}
+
 bool Memory::lookup(int callback_id, CacheReq* req) {
     req->addr &= 0xffffffffff;
     if (req->req == READ_SHARED) {
@@ -141,24 +198,63 @@ void Memory::tick() {
     }
 }
 
+uint64_t Memory::nextTick() {
+#if defined(DRAMSIM) || defined(RAMULATOR)
+    // the dram model keeps its own clock, it is ticked every cycle
+    return getTick();
+#else
+    return nextEventTick();
+#endif
+}
+
+void Memory::skip(uint64_t ticks) {
+    for (auto device : devices) {
+        device->skip(ticks);
+    }
+}
+
+uint64_t Memory::nextEventTick() {
+#ifdef DRAMSIM
+    if (dram_idle_queue.size() != (size_t)dram_queue_size) {
+        return getTick();
+    }
+#endif
+#ifdef RAMULATOR
+    if (write_valid || !dram_read_queue.empty()) {
+        return getTick();
+    }
+#endif
+    uint64_t next = -1;
+    for (auto device : devices) {
+        next = std::min(next, device->nextTick());
+    }
+    return next;
+}
+
+void Memory::endLag(uint64_t end) {
+    if (lag_tick != (uint64_t)-1) {
+        skip(end - lag_tick);
+        lag_tick = -1;
+    }
+}
+
 bool Memory::memoryRead(int callback_id, uint16_t* id, uint64_t addr, uint32_t size) {
-    for (Device* device: devices) {
-        if (unlikely(device->inRange(addr))) {
-            if (device_idle_queue.empty()) {
-                return false;
-            }
-            DeviceReq* req = device_idle_queue.front();
-            req->callback_id = callback_id;
-            *(uint64_t*)req->id = *(uint64_t*)id;
-            req->addr = addr;
-            req->size = size;
-            req->is_write = false;
-            bool success = device->addRequest(req);
-            if (success) {
-                device_idle_queue.pop();
-            }
-            return success;
+    Device* device = phys_map->getDevice(addr);
+    if (unlikely(device != nullptr)) {
+        if (device_idle_queue.empty()) {
+            return false;
+        }
+        DeviceReq* req = device_idle_queue.front();
+        req->callback_id = callback_id;
+        *(uint64_t*)req->id = *(uint64_t*)id;
+        req->addr = addr;
+        req->size = size;
+        req->is_write = false;
+        bool success = device->addRequest(req);
+        if (success) {
+            device_idle_queue.pop();
         }
+        return success;
     }
 #ifdef DRAMSIM
     if (unlikely(dram_idle_queue.empty())) {
@@ -196,23 +292,22 @@ bool Memory::memoryRead(int callback_id, uint16_t* id, uint64_t addr, uint32_t s
 }
 
 bool Memory::memoryWrite(int callback_id, uint16_t* id, uint64_t addr, uint32_t size) {
-    for (Device* device: devices) {
-        if (unlikely(device->inRange(addr))) {
-            if (device_idle_queue.empty()) {
-                return false;
-            }
-            DeviceReq* req = device_idle_queue.front();
-            req->callback_id = callback_id;
-            *(uint64_t*)req->id = *(uint64_t*)id;
-            req->addr = addr;   
-            req->size = size;
-            req->is_write = true;
-            bool success = device->addRequest(req);
-            if (success) {
-                device_idle_queue.pop();
-            }
-            return success;
+    Device* device = phys_map->getDevice(addr);
+    if (unlikely(device != nullptr)) {
+        if (device_idle_queue.empty()) {
+            return false;
         }
+        DeviceReq* req = device_idle_queue.front();
+        req->callback_id = callback_id;
+        *(uint64_t*)req->id = *(uint64_t*)id;
+        req->addr = addr;   
+        req->size = size;
+        req->is_write = true;
+        bool success = device->addRequest(req);
+        if (success) {
+            device_idle_queue.pop();
+        }
+        return success;
     }
 #ifdef DRAMSIM
     if (unlikely(dram_idle_queue.empty())) {
@@ -246,43 +341,67 @@ bool Memory::memoryWrite(int callback_id, uint16_t* id, uint64_t addr, uint32_t
 }
 
 void Memory::paddrRead(uint64_t paddr, uint32_t size, uint8_t* data, bool& mmio) {
-    mmio = false;
-    for (Device* device: devices) {
-        if (unlikely(device->inRange(paddr))) {
-            mmio = true;
-            device->read(paddr, size, data);
-#ifdef DIFFTEST
-            NemuProxy::getInstance().memcpy(paddr, data, 1, DUT_TO_REF);
-#endif
+    uint8_t* host = phys_map->getHost(paddr);
+    if (likely(host != nullptr)) {
+        mmio = false;
+        memcpy(data, host, size);
 #ifdef LOG_MEM
-            Log::trace("mem", "mmio read 0x{:x} {} {:x}", paddr, size, *data);
+        uint64_t val = *((uint64_t*)host);
+        Log::trace("mem", "read 0x{:x} {} {:x}", paddr, size, val);
 #endif
-            return;
-        }
+        return;
+    }
+    mmio = true;
+    if (unlikely(lag_tick != (uint64_t)-1)) {
+        // the devices see the access at the tick it happens, the quantum ends with it
+        endLag(getTick() + 1);
+    }
+    Device* device = phys_map->getDevice(paddr);
+    if (unlikely(device == nullptr)) {
+        // unmapped address reads as zero
+        memset(data, 0, size);
+        return;
     }
-    memcpy(data, ram + paddr - 0x80000000, size);
+    device->read(paddr, size, data);
+#ifdef DIFFTEST
+    NemuProxy::getInstance().memcpy(paddr, data, 1, DUT_TO_REF);
+#endif
 #ifdef LOG_MEM
-    uint64_t val = *((uint64_t*)(ram + paddr - 0x80000000));
-    Log::trace("mem", "read 0x{:x} {} {:x}", paddr, size, val);
+    Log::trace("mem", "mmio read 0x{:x} {} {:x}", paddr, size, *data);
 #endif
 }
 
 void Memory::paddrWrite(uint64_t paddr, uint32_t size, uint8_t* data, bool& mmio) {
-    mmio = false;
-    for (Device* device: devices) {
-        if (unlikely(device->inRange(paddr))) {
-            mmio = true;
-            device->write(paddr, size, data);
+    uint8_t* host = phys_map->getHost(paddr);
+    if (likely(host != nullptr)) {
+        mmio = false;
+        memcpy(host, data, size);
 #ifdef LOG_MEM
-            Log::trace("mem", "mmio write 0x{:x} {} {:x}", paddr, size, *data);
+        uint64_t val = *((uint64_t*)host);
+        Log::trace("mem", "write 0x{:x} {} {:x}", paddr, size, val);
 #endif
-            return;
-        }
+        return;
     }
-    memcpy(ram + paddr - 0x80000000, data, size);
+    mmio = true;
+    if (unlikely(lag_tick != (uint64_t)-1)) {
+        endLag(getTick() + 1);
+    }
+    Device* device = phys_map->getDevice(paddr);
+    if (unlikely(device == nullptr)) {
+        return;
+    }
+    device->write(paddr, size, data);
 #ifdef LOG_MEM
-    uint64_t val = *((uint64_t*)(ram + paddr - 0x80000000));
-    Log::trace("mem", "write 0x{:x} {} {:x}", paddr, size, val);
+    Log::trace("mem", "mmio write 0x{:x} {} {:x}", paddr, size, *data);
+#endif
+}
+
+uint8_t* Memory::getHostAddr(uint64_t paddr) {
+#ifdef LOG_MEM
+    // keep every access visible in mem.log
+    return nullptr;
+#else
+    return phys_map->getHost(paddr);
 #endif
 }
 
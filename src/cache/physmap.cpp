@@ -0,0 +1,59 @@
+#include "cache/physmap.h"
+#include <cstdlib>
+
+PhysMap::PhysMap() {
+    // regions are only touched when mapped, calloc keeps the rest lazy
+    regions = (PhysRegion*)calloc(REGION_NUM, sizeof(PhysRegion));
+}
+
+PhysMap::~PhysMap() {
+    for (uint64_t i = 0; i < REGION_NUM; i++) {
+        delete[] regions[i].pages;
+    }
+    free(regions);
+}
+
+void PhysMap::addRam(uint64_t base, uint64_t size, uint8_t* host) {
+    uint64_t page_mask = (1ULL << PAGE_SHIFT) - 1;
+    map(base, (base + size + page_mask) & ~page_mask, host, nullptr);
+}
+
+void PhysMap::addDevice(Device* device) {
+    uint64_t start, end;
+    device->getRange(start, end);
+    uint64_t page_mask = (1ULL << PAGE_SHIFT) - 1;
+    map(start & ~page_mask, (end + page_mask) & ~page_mask, nullptr, device);
+}
+
+void PhysMap::map(uint64_t start, uint64_t end, uint8_t* host, Device* device) {
+    uint64_t region_mask = (1ULL << REGION_SHIFT) - 1;
+    uint64_t page_mask = (1ULL << PAGE_SHIFT) - 1;
+    uint64_t addr = start;
+    while (addr < end) {
+        PhysRegion* region = &regions[(addr >> REGION_SHIFT) & (REGION_NUM - 1)];
+        uint64_t region_end = (addr & ~region_mask) + region_mask + 1;
+        if ((addr & region_mask) == 0 && end >= region_end) {
+            delete[] region->pages;
+            region->pages = nullptr;
+            region->region.host = host != nullptr ? host + (addr - start) : nullptr;
+            region->region.device = device;
+            region->region.mask = region_mask;
+            addr = region_end;
+            continue;
+        }
+        if (region->pages == nullptr) {
+            region->pages = new PhysPage[REGION_PAGES];
+            for (uint64_t i = 0; i < REGION_PAGES; i++) {
+                PhysPage* page = &region->pages[i];
+                page->host = region->region.host != nullptr ? region->region.host + (i << PAGE_SHIFT) : nullptr;
+                page->device = region->region.device;
+                page->mask = page_mask;
+            }
+        }
+        for (; addr < end && addr < region_end; addr += page_mask + 1) {
+            PhysPage* page = &region->pages[(addr >> PAGE_SHIFT) & (REGION_PAGES - 1)];
+            page->host = host != nullptr ? host + (addr - start) : nullptr;
+            page->device = device;
+        }
+    }
+}
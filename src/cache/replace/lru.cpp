@@ -1,18 +1,62 @@
 #include "cache/replace/lru.h"
 
+void LRUReplace::touch(int set, int id) {
+    if (way > 16) {
+        uint8_t* set_ages = &wide_ages[(size_t)set * way];
+        uint8_t a = set_ages[id];
+        for (int i = 0; i < way; i++) {
+            set_ages[i] += set_ages[i] < a;
+        }
+        set_ages[id] = 0;
+        return;
+    }
+    uint64_t a = age(set, id);
+    uint64_t& word = ages[set];
+    for (int i = 0; i < way; i++) {
+        if (age(set, i) < a) {
+            word += 1ULL << (i * 4);
+        }
+    }
+    word &= ~(0xfULL << (id * 4));
+}
+
 void LRUReplace::insert(int set, int id) {
-    std::list<int>::iterator& lru_iter = lru_map[set][id];
-    lru_list[set].splice(lru_list[set].end(), lru_list[set], lru_iter);
+    touch(set, id);
 }
 
 void LRUReplace::clear(int set, int id) {
-    std::list<int>::iterator& lru_iter = lru_map[set][id];
-    lru_list[set].splice(lru_list[set].begin(), lru_list[set], lru_iter);
+    if (way > 16) {
+        uint8_t* set_ages = &wide_ages[(size_t)set * way];
+        uint8_t a = set_ages[id];
+        for (int i = 0; i < way; i++) {
+            set_ages[i] -= set_ages[i] > a;
+        }
+        set_ages[id] = way - 1;
+        return;
+    }
+    uint64_t a = age(set, id);
+    uint64_t& word = ages[set];
+    for (int i = 0; i < way; i++) {
+        if (age(set, i) > a) {
+            word -= 1ULL << (i * 4);
+        }
+    }
+    word |= (uint64_t)(way - 1) << (id * 4);
 }
 
 int LRUReplace::get(int set) {
-    int id = lru_list[set].front();
-    lru_list[set].splice(lru_list[set].end(), lru_list[set], lru_list[set].begin());
+    int id = 0;
+    if (way > 16) {
+        const uint8_t* set_ages = &wide_ages[(size_t)set * way];
+        while (set_ages[id] != way - 1) {
+            id++;
+        }
+    } else {
+        while (age(set, id) != (uint64_t)(way - 1)) {
+            id++;
+        }
+    }
+    touch(set, id);
     return id;
 }
 
@@ -22,12 +66,20 @@ void LRUReplace::setParams(int arg_num, ...) {
     set = va_arg(args, int);
     way = va_arg(args, int);
     va_end(args);
-    
-    lru_list.resize(set);
-    lru_map.resize(set);
-    for (int i = 0; i < set; i++) {
-        for (int j = 0; j < way; j++) {
-            lru_map[i][j] = lru_list[i].insert(lru_list[i].end(), j);
+
+    // way 0 is the first victim, as if the ways were filled in order
+    if (way > 16) {
+        wide_ages.resize((size_t)set * way);
+        for (int i = 0; i < set; i++) {
+            for (int j = 0; j < way; j++) {
+                wide_ages[(size_t)i * way + j] = way - 1 - j;
+            }
         }
+        return;
     }
-}
\ No newline at end of file
+    uint64_t init = 0;
+    for (int j = 0; j < way; j++) {
+        init |= (uint64_t)(way - 1 - j) << (j * 4);
+    }
+    ages.assign(set, init);
+}
@@ -0,0 +1,43 @@
+#include "cache/replace/plru.h"
+#include <iostream>
+
+void PLRUReplace::insert(int set, int id) {
+    uint64_t& bits = tree[set];
+    // point every node on the path away from id
+    for (int node = id + way; node > 1; node >>= 1) {
+        uint64_t bit = 1ULL << (node >> 1);
+        bits = (node & 1) ? bits & ~bit : bits | bit;
+    }
+}
+
+void PLRUReplace::clear(int set, int id) {
+    uint64_t& bits = tree[set];
+    for (int node = id + way; node > 1; node >>= 1) {
+        uint64_t bit = 1ULL << (node >> 1);
+        bits = (node & 1) ? bits | bit : bits & ~bit;
+    }
+}
+
+int PLRUReplace::get(int set) {
+    int node = 1;
+    while (node < way) {
+        node = 2 * node + ((tree[set] >> node) & 1);
+    }
+    int id = node - way;
+    insert(set, id);
+    return id;
+}
+
+void PLRUReplace::setParams(int arg_num, ...) {
+    va_list args;
+    va_start(args, arg_num);
+    set = va_arg(args, int);
+    way = va_arg(args, int);
+    va_end(args);
+
+    if ((way & (way - 1)) != 0) {
+        std::cerr << "Error: plru replace needs a power of two way num, got " << way << std::endl;
+        ExitHandler::exit(1);
+    }
+    tree.assign(set, 0);
+}
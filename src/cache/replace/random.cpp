@@ -0,0 +1,16 @@
+#include "cache/replace/random.h"
+
+int RandomReplace::get(int set) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state % way;
+}
+
+void RandomReplace::setParams(int arg_num, ...) {
+    va_list args;
+    va_start(args, arg_num);
+    set = va_arg(args, int);
+    way = va_arg(args, int);
+    va_end(args);
+}
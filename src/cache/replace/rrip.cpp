@@ -0,0 +1,92 @@
+#include "cache/replace/rrip.h"
+#include <algorithm>
+#include <bit>
+
+#define RRPV_MAX 3
+#define PSEL_MAX 1023
+#define BIP_PERIOD 32
+
+RRIPReplace::RRIPReplace(rrip_mode_t mode) {
+    this->mode = mode;
+}
+
+void RRIPReplace::setRRPV(int set, int id, int rrpv) {
+    uint64_t bit = 1ULL << id;
+    rrpv_lo[set] = (rrpv & 1) ? rrpv_lo[set] | bit : rrpv_lo[set] & ~bit;
+    rrpv_hi[set] = (rrpv & 2) ? rrpv_hi[set] | bit : rrpv_hi[set] & ~bit;
+}
+
+bool RRIPReplace::useBRRIP(int set) {
+    if (mode != DRRIP) {
+        return mode == BRRIP;
+    }
+    int leader = set % dueling_period;
+    if (leader == 0) {
+        return false;
+    }
+    if (leader == 1) {
+        return true;
+    }
+    return psel > PSEL_MAX / 2;
+}
+
+void RRIPReplace::insert(int set, int id) {
+    // hit promotion
+    setRRPV(set, id, 0);
+}
+
+void RRIPReplace::clear(int set, int id) {
+    setRRPV(set, id, RRPV_MAX);
+    filled[set] &= ~(1ULL << id);
+}
+
+int RRIPReplace::get(int set) {
+    uint64_t& lo = rrpv_lo[set];
+    uint64_t& hi = rrpv_hi[set];
+    uint64_t empty = way_mask & ~filled[set];
+    int id;
+    if (empty != 0) {
+        id = std::countr_zero(empty);
+    } else {
+        uint64_t distant = lo & hi;
+        // no way at RRPV_MAX yet, age every way by one, at most 3 rounds
+        while (distant == 0) {
+            hi = (hi ^ lo) & way_mask;
+            lo = ~lo & way_mask;
+            distant = lo & hi;
+        }
+        id = std::countr_zero(distant);
+    }
+    filled[set] |= 1ULL << id;
+
+    // every call is a miss, a leader set missing votes for the other policy
+    if (mode == DRRIP) {
+        int leader = set % dueling_period;
+        if (leader == 0 && psel < PSEL_MAX) {
+            psel++;
+        } else if (leader == 1 && psel > 0) {
+            psel--;
+        }
+    }
+    if (useBRRIP(set) && ++bip_count % BIP_PERIOD != 0) {
+        setRRPV(set, id, RRPV_MAX);
+    } else {
+        setRRPV(set, id, RRPV_MAX - 1);
+    }
+    return id;
+}
+
+void RRIPReplace::setParams(int arg_num, ...) {
+    va_list args;
+    va_start(args, arg_num);
+    set = va_arg(args, int);
+    way = va_arg(args, int);
+    va_end(args);
+
+    way_mask = way == 64 ? ~0ULL : (1ULL << way) - 1;
+    // about 32 leader sets per policy, and never more than half of the sets
+    dueling_period = std::max(set / 32, 4);
+    rrpv_lo.assign(set, way_mask);
+    rrpv_hi.assign(set, way_mask);
+    filled.assign(set, 0);
+}
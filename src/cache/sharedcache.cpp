@@ -0,0 +1,178 @@
+#include "cache/sharedcache.h"
+#include "common/stats.h"
+#include <cstring>
+#include <iostream>
+
+void SharedCache::afterLoad() {
+    if (inclusion == "inclusive") {
+        inclusion_mode = INCLUSIVE;
+    } else if (inclusion == "exclusive") {
+        inclusion_mode = EXCLUSIVE;
+    } else if (inclusion == "nine") {
+        inclusion_mode = NINE;
+    } else {
+        std::cerr << "Error: cache level " << level << " has unknown inclusion " << inclusion << std::endl;
+        ExitHandler::exit(1);
+    }
+    for (auto child : children) {
+        if (child->getLevel() >= level || child->getLineSize() > line_size) {
+            std::cerr << "Error: cache level " << level << " has a child of level " << child->getLevel()
+                      << " with " << child->getLineSize() << " byte lines" << std::endl;
+            ExitHandler::exit(1);
+        }
+    }
+    callback_id = parent->setCallback([this](uint16_t* ids, CacheTagv* tagv_i) {
+        this->refill(ids[1], tagv_i);
+    });
+    mshrs.init(mshr_num, mshr_target_num, line_size);
+    result.valid = true;
+    result.shared = false;
+    std::string prefix = "l" + std::to_string(level);
+    std::string name = "level " + std::to_string(level) + " cache ";
+    Stats::registerStat(&hit, prefix + "Hit", name + "hits");
+    Stats::registerStat(&miss, prefix + "Miss", name + "misses, merged ones included");
+    Stats::registerStat(&eviction, prefix + "Eviction", name + "valid lines replaced");
+    Stats::registerStat(&writeback, prefix + "Writeback", name + "dirty lines replaced");
+    Stats::registerStat(&back_invalidate, prefix + "BackInvalidate", "child lines invalidated by " + name + "replacements");
+    Stats::registerStat(&mshrs.full_stall, prefix + "MshrFullStall", "ticks a " + name + "miss waited for a free MSHR or target");
+    Stats::registerRatio(&miss, &access, prefix + "MissRate", name + "miss rate");
+    Cache::afterLoad();
+}
+
+bool SharedCache::lookup(int callback_id, CacheReq* req) {
+    if ((int)req_queue.size() == queue_size) {
+        return false;
+    }
+    // the child may reuse its request, keep a copy
+    Request& request = req_queue.emplace_back();
+    request.ready_tick = getTick() + delay;
+    request.addr = req->addr;
+    request.req = req->req;
+    request.target.callback_id = callback_id;
+    memcpy(request.target.id.data(), req->id, sizeof(req->id));
+    return true;
+}
+
+void SharedCache::tick() {
+    mshrs.issue(parent, callback_id);
+    if (req_queue.empty() || req_queue.front().ready_tick > getTick()) {
+        return;
+    }
+    if (handleReq(req_queue.front())) {
+        req_queue.pop_front();
+    }
+}
+
+uint64_t SharedCache::nextTick() {
+    if (mshrs.issuing()) {
+        return getTick();
+    }
+    // a stalled request only moves on in the refill callback of the parent
+    if (req_queue.empty() || mshrs.stall) {
+        return -1;
+    }
+    return std::max(req_queue.front().ready_tick, getTick());
+}
+
+void SharedCache::skip(uint64_t ticks) {
+    mshrs.skip(ticks);
+}
+
+void SharedCache::refill(int idx, CacheTagv* tagv_i) {
+    auto& mshr = mshrs.refill(idx);
+    bool dirty = tagv_i != nullptr && tagv_i->dirty;
+    if (inclusion_mode != EXCLUSIVE) {
+        fill(mshr.set, replace->get(mshr.set), mshr.tag, dirty);
+        dirty = false;
+    }
+    // an exclusive cache passes a dirty line from the parent on, only one child may own it
+    for (auto& target : mshr.targets) {
+        result.dirty = dirty;
+        callbacks[target.callback_id](target.id.data(), &result);
+        dirty = false;
+    }
+}
+
+bool SharedCache::handleReq(Request& request) {
+    uint64_t tag;
+    uint32_t set, offset;
+    splitAddr(request.addr, tag, set, offset);
+    int way_idx = match(tag, set);
+    if (way_idx >= 0) {
+        hit++;
+        access++;
+        result.dirty = false;
+        if (inclusion_mode == EXCLUSIVE) {
+            // the line and its dirty bit move to the child
+            Cache::invalidate(request.addr, result.dirty);
+        } else {
+            replace->insert(set, way_idx);
+        }
+        callbacks[request.target.callback_id](request.target.id.data(), &result);
+        return true;
+    }
+
+    if (!mshrs.add(set, tag, request.addr, request.req, request.target, false)) {
+        return false;
+    }
+    miss++;
+    access++;
+    return true;
+}
+
+bool SharedCache::childWarm(uint64_t addr) {
+    if (inclusion_mode != EXCLUSIVE) {
+        return Cache::childWarm(addr);
+    }
+    bool dirty = false;
+    if (!Cache::invalidate(addr, dirty) && parent != nullptr) {
+        dirty = parent->childWarm(addr);
+    }
+    return dirty;
+}
+
+bool SharedCache::invalidate(uint64_t addr, bool& dirty) {
+    bool present = Cache::invalidate(addr, dirty);
+    if (inclusion_mode == INCLUSIVE) {
+        for (auto child : children) {
+            for (int i = 0; i < line_size; i += child->getLineSize()) {
+                present |= child->invalidate(addr + i, dirty);
+            }
+        }
+    }
+    return present;
+}
+
+void SharedCache::childEvict(uint64_t addr, bool dirty) {
+    uint64_t tag;
+    uint32_t set, offset;
+    splitAddr(addr, tag, set, offset);
+    int way_idx = match(tag, set);
+    if (way_idx >= 0) {
+        if (dirty) {
+            setDirty(set, way_idx);
+        }
+    } else if (inclusion_mode == EXCLUSIVE) {
+        fill(set, replace->get(set), tag, dirty);
+    } else if (dirty && parent != nullptr) {
+        // a nine cache may have dropped the line already, the data goes on
+        parent->childEvict(addr, dirty);
+    }
+}
+
+void SharedCache::evict(uint64_t addr, bool dirty) {
+    eviction++;
+    if (inclusion_mode == INCLUSIVE) {
+        for (auto child : children) {
+            for (int i = 0; i < line_size; i += child->getLineSize()) {
+                if (child->invalidate(addr + i, dirty)) {
+                    back_invalidate++;
+                }
+            }
+        }
+    }
+    if (dirty) {
+        writeback++;
+    }
+    Cache::evict(addr, dirty);
+}
@@ -1,10 +1,6 @@
 #include "common/base.h"
 #include "common/common.h"
 
-// Define static members of Base class
-uint64_t* Base::tick = nullptr;
-Arch* Base::arch = nullptr;
-
 // Define InstTypeName array
 std::string InstTypeName[] = {
     "INT",
@@ -35,7 +31,22 @@ std::string InstTypeName[] = {
     "FMUL",
     "FMA",
     "FDIV",
-    "FSQRT"
+    "FSQRT",
+    "VSET",
+    "VALU",
+    "VMUL",
+    "VDIV",
+    "VFADD",
+    "VFMUL",
+    "VFMA",
+    "VFDIV",
+    "VRED",
+    "VPERM",
+    "VLOAD",
+    "VSTORE",
+    "AES",
+    "SHA",
+    "CLMUL"
 };
 
 // Define InstResultName array
@@ -0,0 +1,176 @@
+#include "common/checkpoint.h"
+#include <zstd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "common/log.h"
+
+static const char checkpoint_magic[8] = "CDSCKPT";
+
+void Checkpoint::addSection(const std::string& name) {
+    if (!sections.empty()) {
+        sections.back().second.size = buffer.size() - sections.back().second.offset;
+    }
+    sections.push_back({name, {buffer.size(), 0}});
+}
+
+void Checkpoint::write(const void* data, uint64_t size) {
+    const uint8_t* src = (const uint8_t*)data;
+    buffer.insert(buffer.end(), src, src + size);
+}
+
+void Checkpoint::writePages(const uint8_t* data, uint64_t size) {
+    uint64_t page_num = (size + PAGE_SIZE - 1) / PAGE_SIZE;
+    uint64_t count_pos = buffer.size();
+    uint64_t count = 0;
+    write(count);
+    for (uint64_t i = 0; i < page_num; i++) {
+        const uint8_t* page = data + i * PAGE_SIZE;
+        uint64_t page_size = std::min(PAGE_SIZE, size - i * PAGE_SIZE);
+        bool zero = true;
+        for (uint64_t j = 0; j < page_size; j += 8) {
+            uint64_t val = 0;
+            memcpy(&val, page + j, std::min((uint64_t)8, page_size - j));
+            if (val != 0) {
+                zero = false;
+                break;
+            }
+        }
+        if (!zero) {
+            write(i);
+            write(page, page_size);
+            count++;
+        }
+    }
+    memcpy(buffer.data() + count_pos, &count, sizeof(count));
+}
+
+bool Checkpoint::dump(const std::string& path) {
+    if (!sections.empty()) {
+        sections.back().second.size = buffer.size() - sections.back().second.offset;
+    }
+    uint64_t table_pos = buffer.size();
+    for (auto& section : sections) {
+        uint32_t name_size = section.first.size();
+        write(section.second);
+        write(name_size);
+        write(section.first.data(), name_size);
+    }
+    write(table_pos);
+
+    Header header;
+    memcpy(header.magic, checkpoint_magic, sizeof(header.magic));
+    header.version = VERSION;
+    header.section_num = sections.size();
+    header.raw_size = buffer.size();
+
+    std::vector<uint8_t> compressed(ZSTD_compressBound(buffer.size()));
+    size_t compressed_size = ZSTD_compress(compressed.data(), compressed.size(), buffer.data(), buffer.size(),
+                                           ZSTD_CLEVEL_DEFAULT);
+    if (ZSTD_isError(compressed_size)) {
+        Log::error("checkpoint compress failed: {}", ZSTD_getErrorName(compressed_size));
+        return false;
+    }
+    FILE* fp = fopen(path.c_str(), "wb");
+    if (fp == NULL) {
+        Log::error("can not open checkpoint {}", path);
+        return false;
+    }
+    bool success = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+                   fwrite(compressed.data(), compressed_size, 1, fp) == 1;
+    fclose(fp);
+    if (!success) {
+        Log::error("write checkpoint {} failed", path);
+    }
+    return success;
+}
+
+bool Checkpoint::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        Log::error("can not open checkpoint {}", path);
+        return false;
+    }
+    struct stat st;
+    fstat(fd, &st);
+    uint64_t file_size = st.st_size;
+    if (file_size < sizeof(Header)) {
+        Log::error("checkpoint {} is truncated", path);
+        ::close(fd);
+        return false;
+    }
+    uint8_t* file = (uint8_t*)mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (file == (uint8_t*)MAP_FAILED) {
+        Log::error("can not mmap checkpoint {}", path);
+        return false;
+    }
+
+    Header header;
+    memcpy(&header, file, sizeof(header));
+    if (memcmp(header.magic, checkpoint_magic, sizeof(header.magic)) != 0 || header.version != VERSION) {
+        Log::error("{} is not a checkpoint of version {}", path, VERSION);
+        munmap(file, file_size);
+        return false;
+    }
+    buffer.resize(header.raw_size);
+    size_t size = ZSTD_decompress(buffer.data(), buffer.size(), file + sizeof(header), file_size - sizeof(header));
+    munmap(file, file_size);
+    if (ZSTD_isError(size) || size != header.raw_size || size < sizeof(uint64_t)) {
+        Log::error("checkpoint {} decompress failed", path);
+        return false;
+    }
+
+    // the section table is at the end of the data, its offset is the last word
+    sections.clear();
+    uint64_t table_pos;
+    read_pos = header.raw_size - sizeof(table_pos);
+    read_end = header.raw_size;
+    read(table_pos);
+    read_pos = table_pos;
+    for (uint32_t i = 0; i < header.section_num; i++) {
+        Section section;
+        uint32_t name_size;
+        read(section);
+        read(name_size);
+        std::string name(name_size, '\0');
+        read(name.data(), name_size);
+        sections.push_back({name, section});
+    }
+    return true;
+}
+
+bool Checkpoint::findSection(const std::string& name) {
+    for (auto& section : sections) {
+        if (section.first == name) {
+            read_pos = section.second.offset;
+            read_end = section.second.offset + section.second.size;
+            return true;
+        }
+    }
+    return false;
+}
+
+void Checkpoint::read(void* data, uint64_t size) {
+    if (read_pos + size > read_end) {
+        Log::error("checkpoint read beyond section end");
+        ExitHandler::exit(1);
+    }
+    memcpy(data, buffer.data() + read_pos, size);
+    read_pos += size;
+}
+
+void Checkpoint::readPages(uint8_t* data, uint64_t size) {
+    uint64_t count;
+    read(count);
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t idx;
+        read(idx);
+        if (idx * PAGE_SIZE >= size) {
+            Log::error("checkpoint page {} out of range", idx);
+            ExitHandler::exit(1);
+        }
+        read(data + idx * PAGE_SIZE, std::min(PAGE_SIZE, size - idx * PAGE_SIZE));
+    }
+}
@@ -1,14 +1,22 @@
 #include "common/exithandler.h"
+#include <cstdlib>
 
 std::vector<std::function<void(int)>> ExitHandler::handlers;
 
 void ExitHandler::exit(int code) {
+    if (trap_exit) {
+        throw SimExit{code};
+    }
     for (auto& handler : handlers) {
         handler(code);
     }
-    exit(code);
+    ::exit(code);
 }
 
 void ExitHandler::registerExitHandler(std::function<void(int)> handler) {
     handlers.push_back(handler);
 }
+
+void ExitHandler::clearExitHandler() {
+    handlers.clear();
+}
@@ -0,0 +1,180 @@
+#include "common/layer.h"
+#include "common/exithandler.h"
+#include "common/log.h"
+#include <fstream>
+#include <iostream>
+#include <yaml-cpp/yaml.h>
+#include <nlohmann/json.hpp>
+
+static YAML::Node jsonToYaml(const nlohmann::json& json) {
+    YAML::Node node;
+    if (json.is_object()) {
+        node = YAML::Node(YAML::NodeType::Map);
+        for (auto& item : json.items()) {
+            node[item.key()] = jsonToYaml(item.value());
+        }
+    } else if (json.is_array()) {
+        node = YAML::Node(YAML::NodeType::Sequence);
+        for (auto& item : json) {
+            node.push_back(jsonToYaml(item));
+        }
+    } else if (json.is_string()) {
+        node = json.get<std::string>();
+    } else if (!json.is_null()) {
+        node = json.dump();
+    }
+    return node;
+}
+
+static void readError(const std::string& path, const std::string& msg) {
+    std::cerr << "Error: " << path << ": " << msg << std::endl;
+    ExitHandler::exit(1);
+}
+
+static void readParams(const std::string& path, const YAML::Node& yaml, const std::string& prefix, std::map<std::string, std::string>& params) {
+    if (!yaml.IsMap()) {
+        readError(path, "params of " + prefix + " is not a map");
+    }
+    for (auto item : yaml) {
+        if (!item.second.IsScalar()) {
+            readError(path, "param " + prefix + item.first.as<std::string>() + " is not a scalar");
+        }
+        params[prefix + item.first.as<std::string>()] = item.second.as<std::string>();
+    }
+}
+
+static void readNode(const std::string& path, const YAML::Node& yaml, LayerNode& node) {
+    if (!yaml.IsMap()) {
+        readError(path, "component " + node.name + " is not a map");
+    }
+    for (auto item : yaml) {
+        std::string key = item.first.as<std::string>();
+        if (key == "class") {
+            node.name = item.second.as<std::string>();
+        } else if (key == "container") {
+            node.container = item.second.as<std::string>();
+        } else if (key == "type") {
+            node.type = item.second.as<std::string>();
+        } else if (key == "id") {
+            node.id = item.second.as<int>();
+        } else if (key == "parent") {
+            node.parent = item.second.as<std::string>();
+        } else if (key == "params") {
+            readParams(path, item.second, "", node.params);
+        } else if (key == "children") {
+            if (!item.second.IsSequence()) {
+                readError(path, "children of " + node.name + " is not a list");
+            }
+            for (auto child : item.second) {
+                LayerNode& child_node = node.children.emplace_back();
+                readNode(path, child, child_node);
+                if (child_node.name.empty() || child_node.container.empty()) {
+                    readError(path, "a child of " + node.name + " has no class or container");
+                }
+            }
+        } else {
+            readError(path, "unknown key " + key + " in " + node.name);
+        }
+    }
+}
+
+std::shared_ptr<const Layer> Layer::read(const std::string& path) {
+    auto layer = std::make_shared<Layer>();
+    YAML::Node yaml;
+    try {
+        if (path.ends_with(".json")) {
+            std::ifstream file(path);
+            if (!file.is_open()) {
+                readError(path, "failed to open");
+            }
+            yaml = jsonToYaml(nlohmann::json::parse(file));
+        } else {
+            yaml = YAML::LoadFile(path);
+        }
+        if (!yaml.IsMap()) {
+            readError(path, "document is not a map");
+        }
+        if (yaml["cpu"]) {
+            layer->cpu = yaml["cpu"].as<std::string>();
+        }
+        if (yaml["params"]) {
+            for (auto cls : yaml["params"]) {
+                readParams(path, cls.second, cls.first.as<std::string>() + ".", layer->params);
+            }
+        }
+        if (yaml["layer"]) {
+            for (auto root : yaml["layer"]) {
+                LayerNode& node = layer->roots[root.first.as<std::string>()];
+                node.name = root.first.as<std::string>();
+                if (!root.second.IsNull()) {
+                    readNode(path, root.second, node);
+                }
+            }
+        }
+    } catch (const YAML::Exception& e) {
+        readError(path, e.what());
+    } catch (const nlohmann::json::exception& e) {
+        readError(path, e.what());
+    }
+    return layer;
+}
+
+void Layer::loadRoot(Base* obj, const std::string& name) {
+    SimContext* context = SimContext::current();
+    if (context->layer == nullptr) {
+        obj->load();
+        return;
+    }
+    auto iter = context->layer->roots.find(name);
+    if (iter == context->layer->roots.end()) {
+        LayerNode node;
+        node.name = name;
+        load(obj, node);
+    } else {
+        load(obj, iter->second);
+    }
+}
+
+const std::vector<LayerNode>& Layer::children() {
+    static const std::vector<LayerNode> empty;
+    const LayerNode* node = SimContext::current()->layer_node;
+    return node == nullptr ? empty : node->children;
+}
+
+void Layer::leaveNode() {
+    SimContext::current()->layer_node = nullptr;
+}
+
+void Layer::error(const LayerNode& node, const std::string& msg) {
+    std::cerr << "Error: layer component " << node.name << " " << msg << std::endl;
+    ExitHandler::exit(1);
+}
+
+Base* Layer::construct(const LayerNode& node) {
+    auto iter = creators().find(node.name);
+    if (iter == creators().end()) {
+        error(node, "is not registered, add it to params.py and rerun parse.py");
+    }
+    return iter->second();
+}
+
+void Layer::load(Base* obj, const LayerNode& node) {
+    SimContext* context = SimContext::current();
+    const LayerNode* prev_node = context->layer_node;
+    std::set<std::string> prev_used;
+    std::swap(prev_used, context->used_node_params);
+    context->layer_node = &node;
+    obj->load();
+    for (auto& param : node.params) {
+        if (context->used_node_params.count(param.first) == 0) {
+            Log::warn("parameter {} of {} is not used", param.first, node.name);
+        }
+    }
+    context->layer_node = prev_node;
+    std::swap(prev_used, context->used_node_params);
+}
+
+std::map<std::string, std::function<Base*()>>& Layer::creators() {
+    static std::map<std::string, std::function<Base*()>> creators;
+    return creators;
+}
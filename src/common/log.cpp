@@ -1,4 +1,27 @@
 #include "common/log.h"
+#include <mutex>
 
-uint64_t Log::start_tick = 0;
-uint64_t Log::end_tick = -1;
\ No newline at end of file
+std::shared_ptr<spdlog::logger> Log::fileLogger(const std::string& name, const std::string& file, bool truncate) {
+    static std::once_flag pool_flag;
+    std::call_once(pool_flag, [] {
+        spdlog::init_thread_pool(65536, 2);
+    });
+    auto logger = std::make_shared<spdlog::async_logger>(name, std::make_shared<spdlog::sinks::basic_file_sink_mt>(file, truncate),
+                                                         spdlog::thread_pool(), spdlog::async_overflow_policy::block);
+    logger->set_pattern("%v");
+    logger->set_level(spdlog::level::trace);
+    return logger;
+}
+
+std::shared_ptr<spdlog::logger> Log::stdoutLogger(const std::string& name) {
+    auto logger = std::make_shared<spdlog::logger>(name, std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+    logger->set_pattern("%v");
+    logger->set_level(spdlog::level::trace);
+    return logger;
+}
+
+std::shared_ptr<spdlog::logger> Log::nullLogger(const std::string& name) {
+    auto logger = std::make_shared<spdlog::logger>(name, std::make_shared<spdlog::sinks::null_sink_st>());
+    logger->set_level(spdlog::level::off);
+    return logger;
+}
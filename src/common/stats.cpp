@@ -1,5 +1,6 @@
 #include "common/stats.h"
 #include "common/log.h"
+#include <cmath>
 
 void Stats::registerStat(std::any value, const std::string& name, const std::string& description) {
     instance().stats.push_back({value, name, description});
@@ -11,30 +12,26 @@ void Stats::registerRatio(std::any divend, std::any divisor, const std::string&
 
 void Stats::writeback() {
     // 清空stat.log文件并重新创建日志器
-    auto stat_logger = spdlog::get("stat");
-    if (stat_logger) {
+    SimContext* context = SimContext::current();
+    if (context->stat) {
         // 获取sink并尝试转换为basic_file_sink_mt
-        auto& sinks = stat_logger->sinks();
+        auto& sinks = context->stat->sinks();
         if (!sinks.empty()) {
             auto file_sink = std::dynamic_pointer_cast<spdlog::sinks::basic_file_sink_mt>(sinks[0]);
             if (file_sink) {
-                auto log_path = file_sink->filename();
-                spdlog::drop("stat");
-                stat_logger = spdlog::basic_logger_mt<spdlog::async_factory>("stat", log_path, true);
-                stat_logger->set_pattern("%v");
-                stat_logger->set_level(spdlog::level::trace);
+                context->stat = Log::fileLogger("stat", file_sink->filename(), true);
             }
         }
     }
     
     for (auto& stat : instance().stats) {
         if (stat.value.type() == typeid(int*)) {
-            Log::stat("{:<20} {:>10} # {}", stat.name, *std::any_cast<int*>(stat.value), stat.description);
+            Log::stat("{:<20} {:>10} # {}", stat.name, delta(std::any_cast<int*>(stat.value)), stat.description);
         }
         if (stat.value.type() == typeid(uint64_t*)) {
-            Log::stat("{:<20} {:>10} # {}", stat.name, *std::any_cast<uint64_t*>(stat.value), stat.description);
+            Log::stat("{:<20} {:>10} # {}", stat.name, delta(std::any_cast<uint64_t*>(stat.value)), stat.description);
         } else if (stat.value.type() == typeid(double*)) {
-            Log::stat("{:<20} {:>10} # {}", stat.name, *std::any_cast<double*>(stat.value), stat.description);
+            Log::stat("{:<20} {:>10} # {}", stat.name, delta(std::any_cast<double*>(stat.value)), stat.description);
         }
     }
     for (auto& ratio : instance().ratios) {
@@ -42,32 +39,32 @@ void Stats::writeback() {
         bool valid = true;
         
         if (ratio.divend.type() == typeid(int*) && ratio.divisor.type() == typeid(int*)) {
-            int divend = *std::any_cast<int*>(ratio.divend);
-            int divisor = *std::any_cast<int*>(ratio.divisor);
+            int divend = delta(std::any_cast<int*>(ratio.divend));
+            int divisor = delta(std::any_cast<int*>(ratio.divisor));
             if (divisor != 0) {
                 result = static_cast<double>(divend) / static_cast<double>(divisor);
             } else {
                 valid = false;
             }
         } else if (ratio.divend.type() == typeid(int*) && ratio.divisor.type() == typeid(uint64_t*)) {
-            int divend = *std::any_cast<int*>(ratio.divend);
-            uint64_t divisor = *std::any_cast<uint64_t*>(ratio.divisor);
+            int divend = delta(std::any_cast<int*>(ratio.divend));
+            uint64_t divisor = delta(std::any_cast<uint64_t*>(ratio.divisor));
             if (divisor != 0) {
                 result = static_cast<double>(divend) / static_cast<double>(divisor);
             } else {
                 valid = false;
             }
         } else if (ratio.divend.type() == typeid(uint64_t*) && ratio.divisor.type() == typeid(int*)) {
-            uint64_t divend = *std::any_cast<uint64_t*>(ratio.divend);
-            int divisor = *std::any_cast<int*>(ratio.divisor);
+            uint64_t divend = delta(std::any_cast<uint64_t*>(ratio.divend));
+            int divisor = delta(std::any_cast<int*>(ratio.divisor));
             if (divisor != 0) {
                 result = static_cast<double>(divend) / static_cast<double>(divisor);
             } else {
                 valid = false;
             }
         } else if (ratio.divend.type() == typeid(uint64_t*) && ratio.divisor.type() == typeid(uint64_t*)) {
-            uint64_t divend = *std::any_cast<uint64_t*>(ratio.divend);
-            uint64_t divisor = *std::any_cast<uint64_t*>(ratio.divisor);
+            uint64_t divend = delta(std::any_cast<uint64_t*>(ratio.divend));
+            uint64_t divisor = delta(std::any_cast<uint64_t*>(ratio.divisor));
             if (divisor != 0) {
                 result = static_cast<double>(divend) / static_cast<double>(divisor);
             } else {
@@ -85,6 +82,59 @@ void Stats::writeback() {
     }
 }
 
+void Stats::setBase(const std::any& value) {
+    if (value.type() == typeid(int*)) {
+        int* ptr = std::any_cast<int*>(value);
+        instance().bases[ptr] = *ptr;
+    } else if (value.type() == typeid(uint64_t*)) {
+        uint64_t* ptr = std::any_cast<uint64_t*>(value);
+        instance().bases[ptr] = *ptr;
+    } else if (value.type() == typeid(double*)) {
+        double* ptr = std::any_cast<double*>(value);
+        instance().bases[ptr] = *ptr;
+    }
+}
+
+void Stats::reset() {
+    for (auto& stat : instance().stats) {
+        setBase(stat.value);
+    }
+    for (auto& ratio : instance().ratios) {
+        setBase(ratio.divend);
+        setBase(ratio.divisor);
+    }
+}
+
+bool Stats::deltaValue(const std::any& value, double& result) {
+    if (value.type() == typeid(int*)) {
+        result = delta(std::any_cast<int*>(value));
+    } else if (value.type() == typeid(uint64_t*)) {
+        result = delta(std::any_cast<uint64_t*>(value));
+    } else if (value.type() == typeid(double*)) {
+        result = delta(std::any_cast<double*>(value));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::vector<std::pair<std::string, double>> Stats::collect() {
+    std::vector<std::pair<std::string, double>> values;
+    for (auto& stat : instance().stats) {
+        double value;
+        if (deltaValue(stat.value, value)) {
+            values.push_back({stat.name, value});
+        }
+    }
+    for (auto& ratio : instance().ratios) {
+        double divend, divisor;
+        if (deltaValue(ratio.divend, divend) && deltaValue(ratio.divisor, divisor)) {
+            values.push_back({ratio.name, divisor != 0 ? divend / divisor : std::nan("")});
+        }
+    }
+    return values;
+}
+
 std::any Stats::getStat(const std::string& name) {
     for (auto& stat : instance().stats) {
         if (stat.name == name) {
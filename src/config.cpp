@@ -1,3 +0,0 @@
-#include "config.h"
-
-std::string Config::_log_path = "";
\ No newline at end of file
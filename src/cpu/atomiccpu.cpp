@@ -1,4 +1,6 @@
 #include "cpu/atomiccpu.h"
+#include "common/checkpoint.h"
+#include "cache/cachemanager.h"
 
 AtomicCPU::~AtomicCPU() {
     delete info;
@@ -6,21 +8,70 @@ AtomicCPU::~AtomicCPU() {
 
 void AtomicCPU::afterLoad() {
     info = new DecodeInfo();
-    pc = Base::arch->getStartPC();
+    pc = Base::getArch()->getStartPC();
     inst_count = 0;
-    Base::arch->setInstret(&inst_count);
+    Base::getArch()->setInstret(&inst_count);
 }
 
 void AtomicCPU::exec() {
     uint64_t paddr;
-    uint64_t exception = Base::arch->getExceptionNone();
-    Base::arch->translateAddr(pc, FETCH_TYPE::IFETCH, paddr, exception);
-    if (exception) {
-        Base::arch->handleException(exception, pc, info);
+    uint64_t exception = Base::getArch()->getExceptionNone();
+    Base::getArch()->translateAddr(pc, FETCH_TYPE::IFETCH, paddr, exception);
+    if (Base::getArch()->exceptionValid(exception)) {
+        Base::getArch()->handleException(exception, pc, info);
+        uint64_t inst_pc = pc;
+        pc = Base::getArch()->updateEnv();
+        if (unlikely(profiler != nullptr)) {
+            profiler->commit(inst_pc, pc, 0, INT);
+        }
     } else {
-        int inst_size = Base::arch->decode(pc, paddr, info);
+        int inst_size = Base::getArch()->decode(pc, paddr, info);
+        uint64_t inst_pc = pc;
+        pc = Base::getArch()->updateEnv();
+        if (unlikely(warm_cpu != nullptr) && !Base::getArch()->exceptionValid(info->exception)) {
+            warm_cpu->warm(inst_pc, paddr, pc, info);
+        }
+        if (unlikely(profiler != nullptr)) {
+            profiler->commit(inst_pc, pc, inst_size, info->type);
+        }
     }
-    pc = Base::arch->updateEnv();
     Base::upTick();
     inst_count++;
+}
+
+uint64_t AtomicCPU::execQuantum(uint64_t n) {
+    Memory* memory = CacheManager::getInstance().memory;
+    // warming and profiling need every instruction, they stay on the generic path
+    bool threaded = warm_cpu == nullptr && profiler == nullptr;
+    uint64_t i = 0;
+    while (i < n) {
+        if (likely(threaded)) {
+            i += Base::getArch()->run(pc, n - i, jit_threshold);
+            if (i == n || unlikely(!memory->lagging())) {
+                return i;
+            }
+        }
+        AtomicCPU::exec();
+        i++;
+        if (unlikely(!memory->lagging())) {
+            return i;
+        }
+    }
+    return n;
+}
+
+void AtomicCPU::switchIn(uint64_t pc, uint64_t inst_count) {
+    this->pc = pc;
+    this->inst_count = inst_count;
+    Base::getArch()->setInstret(&this->inst_count);
+}
+
+void AtomicCPU::save(Checkpoint* cp) {
+    cp->write(pc);
+    cp->write(inst_count);
+}
+
+void AtomicCPU::restore(Checkpoint* cp) {
+    cp->read(pc);
+    cp->read(inst_count);
 }
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include "cpu/bbv.h"
+#include "common/log.h"
+#include <algorithm>
+
+BBVProfiler::BBVProfiler(const std::string& path, uint64_t interval) {
+    this->interval = interval;
+    fp = fopen(path.c_str(), "w");
+    if (fp == NULL) {
+        Log::error("can not open bbv file {}", path);
+        ExitHandler::exit(1);
+    }
+}
+
+BBVProfiler::~BBVProfiler() {
+    if (bb_size != 0) {
+        endBlock();
+    }
+    // the last partial interval is kept, the clustering tool weights it by its size
+    if (!bb_counts.empty()) {
+        dumpInterval();
+    }
+    fclose(fp);
+}
+
+void BBVProfiler::endBlock() {
+    auto iter = bb_ids.find(bb_start);
+    uint32_t id;
+    if (iter == bb_ids.end()) {
+        id = bb_ids.size() + 1;
+        bb_ids[bb_start] = id;
+    } else {
+        id = iter->second;
+    }
+    bb_counts[id] += bb_size;
+    interval_inst += bb_size;
+    bb_size = 0;
+    if (interval_inst >= interval) {
+        // carry the overshoot so interval i still starts near i * interval
+        interval_inst -= interval;
+        dumpInterval();
+    }
+}
+
+void BBVProfiler::dumpInterval() {
+    std::vector<std::pair<uint32_t, uint64_t>> counts(bb_counts.begin(), bb_counts.end());
+    std::sort(counts.begin(), counts.end());
+    fputc('T', fp);
+    for (auto& count : counts) {
+        fprintf(fp, ":%u:%lu ", count.first, count.second);
+    }
+    fputc('\n', fp);
+    bb_counts.clear();
+}
@@ -1,5 +1,6 @@
 #include "cpu/cachecpu.h"
 #include "cache/cachemanager.h"
+#include "common/checkpoint.h"
 
 CacheCPU::~CacheCPU() {
     delete req;
@@ -8,9 +9,9 @@ CacheCPU::~CacheCPU() {
 
 void CacheCPU::afterLoad() {
     info = new DecodeInfo();
-    pc = Base::arch->getStartPC();
+    pc = Base::getArch()->getStartPC();
     inst_count = 0;
-    Base::arch->setInstret(&inst_count);
+    Base::getArch()->setInstret(&inst_count);
     icache = CacheManager::getInstance().getICache();
     icache->setCallback(std::bind(&CacheCPU::icacheCallback, this, std::placeholders::_1, std::placeholders::_2));
     req = new CacheReq();
@@ -20,20 +21,20 @@ void CacheCPU::afterLoad() {
 
 void CacheCPU::exec() {
     if (inst_valid) {
-        Base::arch->decode(pc, paddr, info);
-        pc = Base::arch->updateEnv();
+        Base::getArch()->decode(pc, paddr, info);
+        pc = Base::getArch()->updateEnv();
         if (info->type == IFENCE) {
-            arch->flushCache(0, 0, 0);
+            Base::getArch()->flushCache(0, 0, 0);
         }
         inst_valid = false; 
         inst_count++;
     }
 
     uint64_t exception;
-    Base::arch->translateAddr(pc, FETCH_TYPE::IFETCH, paddr, exception);
+    Base::getArch()->translateAddr(pc, FETCH_TYPE::IFETCH, paddr, exception);
     if (exception) {
         inst_valid = true;
-        Base::arch->handleException(exception, pc, info);
+        Base::getArch()->handleException(exception, pc, info);
     } else {
         req->addr = paddr;
         icache->lookup(0, req);
@@ -43,4 +44,26 @@ void CacheCPU::exec() {
 
 void CacheCPU::icacheCallback(uint16_t* id, CacheTagv* tag) {
     inst_valid = true;
+}
+
+void CacheCPU::switchIn(uint64_t pc, uint64_t inst_count) {
+    this->pc = pc;
+    this->inst_count = inst_count;
+    Base::getArch()->setInstret(&this->inst_count);
+    inst_valid = false;
+}
+
+void CacheCPU::warm(uint64_t pc, uint64_t paddr, uint64_t next_pc, DecodeInfo* info) {
+    icache->warm(paddr, false);
+}
+
+void CacheCPU::save(Checkpoint* cp) {
+    cp->write(pc);
+    cp->write(inst_count);
+}
+
+void CacheCPU::restore(Checkpoint* cp) {
+    cp->read(pc);
+    cp->read(inst_count);
+    inst_valid = false;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "cpu/pipelinecpu.h"
 #include "cache/cachemanager.h"
 #include "common/log.h"
+#include "common/checkpoint.h"
 
 PipelineCPU::~PipelineCPU() {
     for (int i = 0; i < id_extra_idx; i++) {
@@ -13,15 +14,15 @@ PipelineCPU::~PipelineCPU() {
 }
 
 void PipelineCPU::afterLoad() {
-    pc = Base::arch->getStartPC();
+    pc = Base::getArch()->getStartPC();
     pred_pc = pc;
     inst_count = 0;
-    Base::arch->setInstret(&inst_count);
+    Base::getArch()->setInstret(&inst_count);
     Stats::registerStat(&inst_count, "inst_count", "total number of instructions");
     mem_end_map = new bool[retire_size];
     for (int i = 0; i < retire_size; i++) {
         CacheReqWrapper *req = initCacheReq();
-        req->inst->info->exception = Base::arch->getExceptionNone();
+        req->inst->info->exception = Base::getArch()->getExceptionNone();
         cache_req_list.push(req);
         CacheReq *mem_req = new CacheReq();
         mem_req->id[0] = i;
@@ -31,7 +32,7 @@ void PipelineCPU::afterLoad() {
     id_extra_insts = new Inst *[retire_size];
     for (int i = 0; i < retire_size; i++) {
         id_extra_insts[i] = new Inst();
-        id_extra_insts[i]->info->exception = Base::arch->getExceptionNone();
+        id_extra_insts[i]->info->exception = Base::getArch()->getExceptionNone();
     }
 
     icache = CacheManager::getInstance().getICache();
@@ -77,12 +78,12 @@ void PipelineCPU::exec() {
     if (getTick() == 203) {
         Log::info("debug");
     }
-    if (unlikely(getTick() - wb_tick > 5000)) {
+    if (unlikely(getTick() - wb_tick > WB_TIMEOUT)) {
         Log::error("PipelineCPU::exec: WB stage stalled for {} ticks", getTick() - wb_tick);
         ExitHandler::exit(1);
     }
     if (wb_valid) {
-        if (Base::arch->exceptionValid(wb_inst->info->exception)) {
+        if (Base::getArch()->exceptionValid(wb_inst->info->exception)) {
             wb_inst->result = wb_inst->info->exception & IRQ_MASK ? InstResult::INTERRUPT : InstResult::EXCEPTION;
             excRedirect(wb_inst);
         }
@@ -91,14 +92,14 @@ void PipelineCPU::exec() {
         log_db->addData<DBInstData>(&db_inst);
 #endif
         wb_valid = false;
-        wb_inst->info->exception = Base::arch->getExceptionNone();
+        wb_inst->info->exception = Base::getArch()->getExceptionNone();
         wb_inst->result = InstResult::NORMAL;
         inst_count++;
         wb_tick = getTick();
     }
     bool mem_end = false;
     if (mem_valid) {
-        if (!Base::arch->exceptionValid(mem_inst->info->exception)) {
+        if (!Base::getArch()->exceptionValid(mem_inst->info->exception)) {
             if (mem_inst->info->type >= MEM_START && mem_inst->info->type <= MEM_END) {
                 mem_end = mem_end_map[mem_inst->mem_id];
                 if (mem_end) {
@@ -132,7 +133,7 @@ void PipelineCPU::exec() {
 #ifdef DB_INST
             exe_inst->id = current_id;
 #endif
-            if (Base::arch->exceptionValid(exe_inst->info->exception)) {
+            if (Base::getArch()->exceptionValid(exe_inst->info->exception)) {
                 exe_end = true;
             } else {
                 CacheReq *mem_req = mem_req_list.back();
@@ -161,6 +162,48 @@ void PipelineCPU::exec() {
                 case FMISC_COMPLEX:
                     exe_stall_cycle = fmisc_complex_delay;
                     break;
+                case VALU:
+                    exe_stall_cycle = valu_delay;
+                    break;
+                case VMUL:
+                    exe_stall_cycle = vmul_delay;
+                    break;
+                case VDIV:
+                    exe_stall_cycle = vdiv_delay;
+                    break;
+                case VFADD:
+                    exe_stall_cycle = vfadd_delay;
+                    break;
+                case VFMUL:
+                    exe_stall_cycle = vfmul_delay;
+                    break;
+                case VFMA:
+                    exe_stall_cycle = vfma_delay;
+                    break;
+                case VFDIV:
+                    exe_stall_cycle = vfdiv_delay;
+                    break;
+                case VRED:
+                    exe_stall_cycle = vred_delay;
+                    break;
+                case VPERM:
+                    exe_stall_cycle = vperm_delay;
+                    break;
+                case VLOAD:
+                    exe_stall_cycle = vload_delay;
+                    break;
+                case VSTORE:
+                    exe_stall_cycle = vstore_delay;
+                    break;
+                case AES:
+                    exe_stall_cycle = aes_delay;
+                    break;
+                case SHA:
+                    exe_stall_cycle = sha_delay;
+                    break;
+                case CLMUL:
+                    exe_stall_cycle = clmul_delay;
+                    break;
                 case COND: {
                     if ((exe_inst->info->dst_data[1] ^ exe_inst->taken) || 
                         exe_inst->next_pc != exe_inst->real_target) {
@@ -191,7 +234,7 @@ void PipelineCPU::exec() {
                 case LOAD:
                 case LR: {
                     uint64_t mem_paddr, mem_exception;
-                    Base::arch->translateAddr(exe_inst->info->exc_data, LFETCH, mem_paddr,
+                    Base::getArch()->translateAddr(exe_inst->info->exc_data, LFETCH, mem_paddr,
                                               mem_exception);
                     mem_req->addr = mem_paddr;
                     mem_req->size = exe_inst->info->dst_idx[2];
@@ -214,7 +257,7 @@ void PipelineCPU::exec() {
                 case STORE:
                 case AMO: {
                     uint64_t mem_paddr, mem_exception;
-                    Base::arch->translateAddr(exe_inst->info->exc_data, SFETCH, mem_paddr,
+                    Base::getArch()->translateAddr(exe_inst->info->exc_data, SFETCH, mem_paddr,
                                               mem_exception);
                     mem_req->addr = mem_paddr;
                     mem_req->size = exe_inst->info->dst_idx[2];
@@ -228,11 +271,11 @@ void PipelineCPU::exec() {
                 }
                 case FENCE:
                 case SFENCE:
-                    Base::arch->flushCache(1, 0, 0);
+                    Base::getArch()->flushCache(1, 0, 0);
                     exe_end = true;
                     break;
                 case IFENCE:
-                    Base::arch->flushCache(0, 0, 0);
+                    Base::getArch()->flushCache(0, 0, 0);
                     exe_end = true;
                     break;
                 default:
@@ -258,12 +301,12 @@ void PipelineCPU::exec() {
 
     if (id_valid && !exe_valid) {
         uint64_t exception = id_inst->info->exception;
-        bool exc_valid = Base::arch->exceptionValid(exception);
+        bool exc_valid = Base::getArch()->exceptionValid(exception);
         if (exc_valid) {
-            Base::arch->handleException(exception, pc, id_inst->info);
+            Base::getArch()->handleException(exception, pc, id_inst->info);
         }
         if (!id_wait_redirect) {
-            id_inst->real_target = Base::arch->updateEnv();
+            id_inst->real_target = Base::getArch()->updateEnv();
             pc = id_inst->real_target;
 
             bool target_eq = pc == id_inst->next_pc;
@@ -272,8 +315,8 @@ void PipelineCPU::exec() {
             bool is_direct = id_inst->info->type == DIRECT || id_inst->info->type == PUSH;
             bool is_jump = id_inst->info->type > PUSH && id_inst->info->type <= BRANCH_END;
             bool is_branch = is_cond || is_jump || is_direct;
-            bool archFlush = Base::arch->needFlush(id_inst->info);
-            if (Base::arch->exceptionValid(id_inst->info->exception)) {
+            bool archFlush = Base::getArch()->needFlush(id_inst->info);
+            if (Base::getArch()->exceptionValid(id_inst->info->exception)) {
                 id_wait_redirect = true;
             } else if (is_jump) {
                 id_wait_redirect = !target_eq;
@@ -319,11 +362,11 @@ void PipelineCPU::exec() {
 
     CacheReqWrapper *req_wrapper = fetch_cache_req;
     if (fetch_valid && !id_valid) {
-        if (likely(!Base::arch->exceptionValid(req_wrapper->inst->info->exception))) {
-            Base::arch->translateAddr(req_wrapper->inst->pc, FETCH_TYPE::IFETCH,
+        if (likely(!Base::getArch()->exceptionValid(req_wrapper->inst->info->exception))) {
+            Base::getArch()->translateAddr(req_wrapper->inst->pc, FETCH_TYPE::IFETCH,
                                       req_wrapper->inst->paddr, req_wrapper->inst->info->exception);
         }
-        if (unlikely(Base::arch->exceptionValid(req_wrapper->inst->info->exception))) {
+        if (unlikely(Base::getArch()->exceptionValid(req_wrapper->inst->info->exception))) {
             if (cache_req_list.one() && !id_stall_valid) {
                 id_valid = true;
 #ifdef DB_INST
@@ -348,7 +391,7 @@ void PipelineCPU::exec() {
     if (!fetch_valid) {
     req_wrapper = cache_req_list.back();
     req_wrapper->inst->pc = pred_pc;
-    req_wrapper->inst->info->exception = Base::arch->getExceptionNone();
+    req_wrapper->inst->info->exception = Base::getArch()->getExceptionNone();
     // req_wrapper->inst->bp_meta_idx =
     //     predictor->predict(req_wrapper->inst->pc, req_wrapper->inst->next_pc,
     //                        req_wrapper->inst->size, req_wrapper->inst->taken, fetch_valid);
@@ -368,6 +411,30 @@ void PipelineCPU::exec() {
     Base::upTick();
 }
 
+uint64_t PipelineCPU::nextTick() {
+    // idle only while every stage is blocked behind a load or store waiting for the dcache
+    if (wb_valid || !mem_valid || !exe_valid || !id_valid || !fetch_valid) {
+        return getTick();
+    }
+    if (Base::getArch()->exceptionValid(mem_inst->info->exception) ||
+        mem_inst->info->type < MEM_START || mem_inst->info->type > MEM_END || mem_end_map[mem_inst->mem_id]) {
+        return getTick();
+    }
+    // wake up in time for the WB watchdog
+    uint64_t timeout = wb_tick + WB_TIMEOUT + 1;
+    if (exe_end) {
+        return timeout;
+    }
+    // exe is counting down a multi-cycle instruction, it ends at the tick exe_stall_cycle reaches 0
+    return exe_stall_cycle > 1 ? std::min(timeout, getTick() + exe_stall_cycle - 1) : getTick();
+}
+
+void PipelineCPU::skip(uint64_t ticks) {
+    if (exe_stall_cycle > 0) {
+        exe_stall_cycle -= ticks;
+    }
+}
+
 PipelineCPU::CacheReqWrapper *PipelineCPU::initCacheReq() {
     CacheReqWrapper *req_wrapper = new CacheReqWrapper();
     req_wrapper->req->req = READ_SHARED;
@@ -443,12 +510,12 @@ bool PipelineCPU::preId(Inst *inst) {
     }
 
     uint64_t id_paddr;
-    Base::arch->translateAddr(pc, FETCH_TYPE::IFETCH, id_inst->paddr, id_inst->info->exception);
-    if (Base::arch->exceptionValid(id_inst->info->exception)) {
-        Base::arch->handleException(id_inst->info->exception, pc, id_inst->info);
+    Base::getArch()->translateAddr(pc, FETCH_TYPE::IFETCH, id_inst->paddr, id_inst->info->exception);
+    if (Base::getArch()->exceptionValid(id_inst->info->exception)) {
+        Base::getArch()->handleException(id_inst->info->exception, pc, id_inst->info);
         return true;
     }
-    int inst_size = Base::arch->decode(pc, id_inst->paddr, id_inst->info);
+    int inst_size = Base::getArch()->decode(pc, id_inst->paddr, id_inst->info);
     id_inst->real_size = inst_size;
     id_inst->real_pc = pc;
     uint8_t size = 0;
@@ -464,4 +531,74 @@ bool PipelineCPU::preId(Inst *inst) {
         return false;
     }
     return true;
+}
+
+void PipelineCPU::switchIn(uint64_t pc, uint64_t inst_count) {
+    this->pc = pc;
+    this->pred_pc = pc;
+    this->inst_count = inst_count;
+    Base::getArch()->setInstret(&this->inst_count);
+    wb_tick = getTick();
+}
+
+void PipelineCPU::switchOut() {
+    // instructions after ID have already updated the arch state
+    inst_count += exe_valid + mem_valid + wb_valid;
+    fetch_valid = false;
+    id_valid = false;
+    exe_valid = false;
+    mem_valid = false;
+    wb_valid = false;
+    id_stall_valid = false;
+    id_stall_dec_more = false;
+    id_stall_inst_valid = false;
+    id_remain_size = 0;
+    id_wait_redirect = false;
+    exe_stall_cycle = 0;
+    exe_end = false;
+    mem_req_valid = false;
+    while (!cache_req_list.empty()) {
+        cache_req_list.pop();
+    }
+    while (!mem_req_list.empty()) {
+        mem_req_list.pop();
+    }
+    for (uint64_t i = 0; i < retire_size; i++) {
+        mem_end_map[i] = false;
+    }
+    icache->redirect();
+    dcache->redirect();
+}
+
+void PipelineCPU::warm(uint64_t pc, uint64_t paddr, uint64_t next_pc, DecodeInfo* info) {
+    icache->warm(paddr, false);
+    bool is_mem = info->type >= MEM_START && info->type <= MEM_END;
+    if (is_mem && !(info->type == SC && info->dst_data[0])) {
+        bool is_write = info->type != LOAD && info->type != LR;
+        uint64_t mem_paddr;
+        uint64_t mem_exception = Base::getArch()->getExceptionNone();
+        Base::getArch()->translateAddr(info->exc_data, is_write ? SFETCH : LFETCH, mem_paddr, mem_exception);
+        if (!Base::getArch()->exceptionValid(mem_exception)) {
+            dcache->warm(mem_paddr, is_write);
+        }
+    }
+    predictor->warm(pc, info, info->inst_size, next_pc);
+}
+
+void PipelineCPU::save(Checkpoint* cp) {
+    cp->write(pc);
+    cp->write(inst_count);
+    if (cp->uarch) {
+        cp->addSection("predictor");
+        predictor->save(cp);
+    }
+}
+
+void PipelineCPU::restore(Checkpoint* cp) {
+    cp->read(pc);
+    cp->read(inst_count);
+    pred_pc = pc;
+    if (cp->findSection("predictor")) {
+        predictor->restore(cp);
+    }
 }
\ No newline at end of file
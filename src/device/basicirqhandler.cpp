@@ -1,4 +1,6 @@
 #include "device/basicirqhandler.h"
+#include "common/checkpoint.h"
+#include "common/log.h"
 
 void BasicIrqHandler::afterLoad() {
     end_addr = base_addr + range;
@@ -27,6 +29,11 @@ bool BasicIrqHandler::inRange(uint64_t addr) {
     return addr >= base_addr && addr < end_addr;
 }
 
+void BasicIrqHandler::getRange(uint64_t& start, uint64_t& end) {
+    start = base_addr;
+    end = end_addr;
+}
+
 bool BasicIrqHandler::addRequest(DeviceReq* req) {
     if (this->req != nullptr) {
         return false;
@@ -43,3 +50,22 @@ DeviceReq* BasicIrqHandler::checkResponse() {
     this->req = nullptr;
     return req;
 }
+
+void BasicIrqHandler::save(Checkpoint* cp) {
+    cp->write(irq);
+    cp->write(range);
+    cp->writePages(ram, range);
+}
+
+void BasicIrqHandler::restore(Checkpoint* cp) {
+    uint64_t cp_range;
+    // mip is restored with the arch state, listeners are not notified
+    cp->read(irq);
+    cp->read(cp_range);
+    if (cp_range != range) {
+        Log::error("BasicIrqHandler::restore: range mismatch, checkpoint {}, current {}", cp_range, range);
+        ExitHandler::exit(1);
+    }
+    memset(ram, 0, range);
+    cp->readPages(ram, range);
+}
@@ -22,6 +22,11 @@ bool SimpleUart::inRange(uint64_t addr) {
     return addr >= base_addr && addr < base_addr + 0x1000;
 }
 
+void SimpleUart::getRange(uint64_t& start, uint64_t& end) {
+    start = base_addr;
+    end = base_addr + 0x1000;
+}
+
 void SimpleUart::read(uint64_t addr, int size, uint8_t* data) {
     uart.do_read(addr - base_addr, size, (char*)data);
 }
@@ -1,5 +1,6 @@
 #include "device/uart.h"
 #include "device/irqhandler.h"
+#include "common/checkpoint.h"
 
 void cpu_irq_handler(void *opaque, int n, int level) {
     Uart* uart = (Uart*)opaque;
@@ -16,6 +17,11 @@ bool Uart::inRange(uint64_t addr) {
     return addr >= base_addr && addr < end_addr;
 }
 
+void Uart::getRange(uint64_t& start, uint64_t& end) {
+    start = base_addr;
+    end = end_addr;
+}
+
 bool Uart::addRequest(DeviceReq* req) {
     if (req_valid || resp_valid) {
         return false;
@@ -37,6 +43,19 @@ void Uart::tick() {
     }
 }
 
+uint64_t Uart::nextTick() {
+    if (resp_valid) {
+        return getTick();
+    }
+    return req_valid ? getTick() + current_delay : -1;
+}
+
+void Uart::skip(uint64_t ticks) {
+    if (req_valid) {
+        current_delay -= ticks;
+    }
+}
+
 DeviceReq* Uart::checkResponse() {
     if (!resp_valid) {
         return nullptr;
@@ -57,4 +76,26 @@ void Uart::write(uint64_t addr, int size, uint8_t* data) {
 
 void Uart::setIrq(bool valid) {
     irq_handler->setIrqState(irq_number, valid);
+}
+
+void Uart::save(Checkpoint* cp) {
+    cp->write(*serial);
+    cp->write(serial->recv_fifo.data, UART_FIFO_LENGTH);
+    cp->write(serial->xmit_fifo.data, UART_FIFO_LENGTH);
+}
+
+void Uart::restore(Checkpoint* cp) {
+    // host side file descriptors, irq and fifo buffers belong to this run
+    int connfd = serial->connfd;
+    int outfd = serial->outfd;
+    uint8_t* recv_data = serial->recv_fifo.data;
+    uint8_t* xmit_data = serial->xmit_fifo.data;
+    cp->read(*serial);
+    serial->connfd = connfd;
+    serial->outfd = outfd;
+    serial->irq = irq;
+    serial->recv_fifo.data = recv_data;
+    serial->xmit_fifo.data = xmit_data;
+    cp->read(recv_data, UART_FIFO_LENGTH);
+    cp->read(xmit_data, UART_FIFO_LENGTH);
 }
\ No newline at end of file
@@ -4,51 +4,437 @@
 #include "arch/riscv/riscvarch.h"
 #endif
 #include "cache/cachemanager.h"
+#include "cpu/atomiccpu.h"
 #include "common/log.h"
 #include "common/stats.h"
+#include "common/checkpoint.h"
+#include "common/layer.h"
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/wait.h>
 
 EMU::EMU() {
+    context.stats = &stats;
+    context.cache_manager = new CacheManager();
+    SimContext::setCurrent(&context);
 }
 
 EMU::~EMU() {
-    spdlog::shutdown();
+    delete profiler;
+    // cpu is one of func_cpu and detail_cpu when fast forward is on
+    if (func_cpu != nullptr) {
+        delete func_cpu;
+        delete detail_cpu;
+    } else {
+        delete cpu;
+    }
+    delete arch;
+    delete context.cache_manager;
+    if (SimContext::current() == &context) {
+        SimContext::setCurrent(nullptr);
+    }
 }
 
-void EMU::init(const std::string& path) {
-    cpu = ObjectFactory::createObject<CPU>(CPU_NAME);
+void EMU::init(const std::string& path, const std::map<std::string, std::string>& overrides) {
+    SimContext::setCurrent(&context);
 #ifdef ARCH_RISCV
     arch = new cds::arch::riscv::RiscvArch();
 #endif
-    config.setup(path);
+    config.setup(path, overrides);
+    cpu_name = CPU_NAME;
+    std::string layer_path = config.layer_path.empty() && RUNTIME_LAYER ? LAYER_PATH : config.layer_path;
+    if (!layer_path.empty()) {
+        context.layer = Layer::read(layer_path);
+        if (!context.layer->cpu.empty() && context.layer->cpu != cpu_name) {
+            if (!RUNTIME_LAYER) {
+                // SimTop is bound to the cpu of layer.xml
+                std::cerr << "Error: " << layer_path << ": cpu " << context.layer->cpu << " needs parse.py --runtime" << std::endl;
+                ExitHandler::exit(1);
+            }
+            cpu_name = context.layer->cpu;
+        }
+        // params of the config file override the ones of the layer
+        context.params = context.layer->params;
+    }
+    for (auto& param : config.params) {
+        context.params[param.first] = param.second;
+    }
+    cpu = ObjectFactory::createObject<CPU>(cpu_name);
+    if (cpu == nullptr) {
+        std::cerr << "Error: unknown cpu " << cpu_name << std::endl;
+        ExitHandler::exit(1);
+    }
+    context.arch = arch;
+    context.log_path = config.log_path;
+    context.log_start_tick = config.log_start_tick;
+    context.log_end_tick = config.log_end_tick;
     Log::initStdio(config.serial_stdio, config.log_stdio, config.log_path);
-    Log::start_tick = config.log_start_tick;
-    Log::end_tick = config.log_end_tick;
-    Base::setArch(arch);
-    Base::setTick(&tick);
     arch->setTick(&tick);
     Stats::registerStat(&tick, "tick", "tick count");
     CacheManager::getInstance().memory = new Memory(config.memory_path);
-    CacheManager::getInstance().load();
-    CacheManager::getInstance().memory->load();
-    cpu->load();
+    if (context.layer != nullptr && !RUNTIME_LAYER) {
+        for (auto& root : context.layer->roots) {
+            if (!root.second.children.empty()) {
+                Log::warn("{}: children of {} are ignored, the component tree is generated by parse.py", layer_path, root.first);
+            }
+        }
+    }
+    Layer::loadRoot(&CacheManager::getInstance(), "CacheManager");
+    Layer::loadRoot(CacheManager::getInstance().memory, "Memory");
+    Layer::loadRoot(cpu, cpu_name);
 
     CacheManager::getInstance().afterLoad();
     arch->afterLoad();
     arch->initConfig(config.arch_path);
     cpu->afterLoad();
+    if ((config.fastforward_inst != 0 || config.sample_period != 0) && dynamic_cast<AtomicCPU*>(cpu) == nullptr) {
+        detail_cpu = cpu;
+        func_cpu = ObjectFactory::createObject<CPU>(config.fastforward_cpu);
+        if (dynamic_cast<AtomicCPU*>(func_cpu) == nullptr) {
+            Log::error("fastforward_cpu {} is not a functional cpu", config.fastforward_cpu);
+            ExitHandler::exit(1);
+        }
+        Layer::loadRoot(func_cpu, config.fastforward_cpu);
+        func_cpu->afterLoad();
+        cpu = func_cpu;
+        phase = PHASE_FUNC;
+        sample_start = config.fastforward_inst;
+        switch_inst = sample_start - std::min(config.warmup_inst, sample_start);
+        if (config.sample_period != 0) {
+            Stats::registerStat(&sample_num, "sampleNum", "measured samples");
+            Stats::registerStat(&sample_cpi, "sampleCPI", "mean cpi of the samples");
+            Stats::registerStat(&sample_cpi_error, "sampleCPIError", "relative 99.7% confidence half width of sampleCPI");
+        }
+    } else if (config.sample_period != 0) {
+        Log::error("sampling needs a detailed cpu, {} is functional", cpu_name);
+        ExitHandler::exit(1);
+    }
     CacheManager::getInstance().getIrqHandler()->addIrqListener([this](uint64_t irq) {
         this->arch->irqListener(irq);
     });
+    if (config.bbv_interval != 0) {
+        profiler = new BBVProfiler(config.bbv_path, config.bbv_interval);
+        if (!cpu->setProfiler(profiler)) {
+            Log::error("{} can not profile basic blocks, use AtomicCPU or fastforward_inst", cpu_name);
+            ExitHandler::exit(1);
+        }
+    }
+    if (!config.restore_path.empty() && !restore(config.restore_path)) {
+        ExitHandler::exit(1);
+    }
+    if (config.skip_idle) {
+        Stats::registerStat(&idle_tick, "idleTick", "ticks in which the cpu and caches were idle and not simulated");
+    }
+    checkpoint_pending = config.checkpoint_tick != (uint64_t)-1 || config.checkpoint_inst != (uint64_t)-1;
+    top.bind(detail_cpu != nullptr ? detail_cpu : cpu);
+    // the layer lists every class, only the config file params are checked
+    for (auto& param : config.params) {
+        if (context.used_params.count(param.first) == 0) {
+            Log::warn("parameter {} is not used by any component", param.first);
+        }
+    }
 }
 
 void EMU::run() {
+    SimContext::setCurrent(&context);
+    bool memory_ticked = false;
     while (!stopped && Base::getTick() <= config.end_tick && arch->getInstret() < config.inst_count) {
-        CacheManager::getInstance().memory->tick();
-        for (auto& cache : CacheManager::getInstance().cache_map) {
-            cache.second->tick();
+        if (likely(!memory_ticked)) {
+            top.tickMemory();
+        }
+        top.tickCaches();
+        top.exec(cpu);
+        if (config.quantum > 1) {
+            runQuantum();
+        }
+        if (unlikely(arch->getInstret() >= switch_inst)) {
+            switchCPU();
+        }
+        if (unlikely(checkpoint_pending) &&
+            (Base::getTick() >= config.checkpoint_tick || arch->getInstret() >= config.checkpoint_inst) &&
+            arch->instCommitted()) {
+            checkpoint_pending = false;
+            save(config.checkpoint_path);
+        }
+        memory_ticked = config.skip_idle && skipIdle();
+    }
+    if (sample_fd != -1) {
+        // the program or the tick limit ended before the sample was measured
+        _exit(1);
+    }
+    while (!sample_children.empty() && waitSample(true)) {}
+}
+
+bool EMU::skipIdle() {
+    uint64_t wake = cpu->nextTick();
+    if (likely(wake <= tick)) {
+        return false;
+    }
+    CacheManager& manager = CacheManager::getInstance();
+    for (auto& cache : manager.cache_map) {
+        wake = std::min(wake, cache.second->nextTick());
+    }
+    // the loop body still runs at end_tick and checkpoint_tick
+    uint64_t limit = std::min(wake, config.end_tick);
+    if (checkpoint_pending) {
+        limit = std::min(limit, config.checkpoint_tick);
+    }
+    if (limit <= tick) {
+        return false;
+    }
+    uint64_t start = tick;
+    bool memory_ticked = false;
+    if (manager.memory->nextTick() > tick) {
+        // nothing happens before the first wakeup, jump to it
+        limit = std::min(limit, manager.memory->nextTick());
+        if (limit == (uint64_t)-1) {
+            // nothing can ever wake up, leave it to the watchdog of the cpu
+            return false;
+        }
+        tick = limit;
+        manager.memory->skip(tick - start);
+    } else {
+        // memory works alone until one of its callbacks wakes up a cache or the cpu,
+        // the rest of that tick is simulated by run()
+        while (tick < limit) {
+            top.tickMemory();
+            if (cpu->nextTick() <= tick || std::any_of(manager.cache_map.begin(), manager.cache_map.end(),
+                [this](auto& cache) { return cache.second->nextTick() <= tick; })) {
+                memory_ticked = true;
+                break;
+            }
+            tick++;
+        }
+    }
+    cpu->skip(tick - start);
+    for (auto& cache : manager.cache_map) {
+        cache.second->skip(tick - start);
+    }
+    idle_tick += tick - start;
+    return memory_ticked;
+}
+
+void EMU::runQuantum() {
+    CacheManager& manager = CacheManager::getInstance();
+    uint64_t instret = arch->getInstret();
+    if (tick > config.end_tick || instret >= config.inst_count || instret >= switch_inst) {
+        return;
+    }
+    uint64_t n = std::min(config.quantum - 1, config.end_tick - tick + 1);
+    n = std::min({n, config.inst_count - instret, switch_inst - instret});
+    if (checkpoint_pending) {
+        if (tick >= config.checkpoint_tick || instret >= config.checkpoint_inst) {
+            return;
         }
-        cpu->exec();
+        n = std::min({n, config.checkpoint_tick - tick, config.checkpoint_inst - instret});
+    }
+    uint64_t wake = manager.memory->nextEventTick();
+    for (auto& cache : manager.cache_map) {
+        wake = std::min(wake, cache.second->nextTick());
+    }
+    if (wake <= tick) {
+        return;
+    }
+    n = std::min(n, wake - tick);
+    manager.memory->beginLag();
+    uint64_t executed = cpu->execQuantum(n);
+    manager.memory->endLag();
+    for (auto& cache : manager.cache_map) {
+        cache.second->skip(executed);
+    }
+}
+
+void EMU::switchCPU() {
+    if (!arch->instCommitted()) {
+        return;
+    }
+    uint64_t instret = arch->getInstret();
+    switch (phase) {
+    case PHASE_FUNC:
+        Log::info("start warming at tick {} instret {}", tick, instret);
+        func_cpu->setWarmCPU(detail_cpu);
+        phase = PHASE_WARM;
+        switch_inst = sample_start;
+        break;
+    case PHASE_WARM:
+        if (config.sample_period != 0 && config.sample_fork) {
+            forkSample();
+            break;
+        }
+        switchTo(detail_cpu);
+        if (config.sample_period == 0) {
+            Log::info("switch to {} at tick {} instret {}", cpu_name, tick, instret);
+            // stat.log describes the detailed part only
+            Stats::reset();
+            phase = PHASE_DETAIL;
+            switch_inst = -1;
+        } else {
+            phase = PHASE_DETAIL_WARM;
+            switch_inst = instret + config.sample_warmup;
+        }
+        break;
+    case PHASE_DETAIL_WARM:
+        phase = PHASE_MEASURE;
+        sample_tick = tick;
+        sample_inst = instret;
+        switch_inst = instret + config.sample_size;
+        if (sample_fd != -1) {
+            // the stat slice of a child covers its measured window
+            Stats::reset();
+        }
+        break;
+    case PHASE_MEASURE:
+        if (sample_fd != -1) {
+            uint64_t result[2] = {tick - sample_tick, instret - sample_inst};
+            Stats::writeback();
+            bool success = ::write(sample_fd, result, sizeof(result)) == sizeof(result);
+            _exit(success ? 0 : 1);
+        }
+        addSample((double)(tick - sample_tick) / (instret - sample_inst));
+        switchTo(func_cpu);
+        func_cpu->setWarmCPU(detail_cpu);
+        phase = PHASE_WARM;
+        // the next sample starts one period after this one, or right away if detailed mode fell behind
+        sample_start = std::max(sample_start + config.sample_period, instret);
+        switch_inst = sample_start;
+        break;
+    case PHASE_DETAIL:
+        switch_inst = -1;
+        break;
+    }
+}
+
+void EMU::switchTo(CPU* next) {
+    cpu->setWarmCPU(nullptr);
+    cpu->switchOut();
+    next->switchIn(cpu->getPC(), arch->getInstret());
+    cpu = next;
+}
+
+void EMU::addSample(double cpi) {
+    // Welford's online mean and variance
+    sample_num++;
+    double delta = cpi - sample_cpi;
+    sample_cpi += delta / sample_num;
+    sample_m2 += delta * (cpi - sample_cpi);
+    if (sample_num < 2) {
+        return;
+    }
+    double stddev = std::sqrt(sample_m2 / (sample_num - 1));
+    // z = 3, 99.7% confidence
+    sample_cpi_error = 3 * stddev / std::sqrt((double)sample_num) / sample_cpi;
+    if (!stopped && sample_num >= config.sample_min && sample_cpi_error <= config.sample_error) {
+        Log::info("sampling done at instret {}: cpi {:.4f} +- {:.2f}% over {} samples",
+                  arch->getInstret(), sample_cpi, sample_cpi_error * 100, sample_num);
+        stopped = true;
+    }
+}
+
+void EMU::forkSample() {
+    while (waitSample(false)) {}
+    while (sample_children.size() >= config.sample_jobs && waitSample(true)) {}
+    int fds[2];
+    if (pipe(fds) != 0) {
+        Log::error("can not create sample pipe: {}", strerror(errno));
+        ExitHandler::exit(1);
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        Log::error("can not fork sample {}: {}", sample_id, strerror(errno));
+        ExitHandler::exit(1);
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        for (auto& child : sample_children) {
+            close(child.second);
+        }
+        sample_children.clear();
+        sample_fd = fds[1];
+        // the child shares nothing with the parent's exit path, it must not flush
+        // the parent's logs, stat.log or bbv file
+        ExitHandler::clearExitHandler();
+        ExitHandler::registerExitHandler([](int code) {
+            _exit(code);
+        });
+        for (int sig : {SIGSEGV, SIGABRT, SIGFPE, SIGILL, SIGINT}) {
+            std::signal(sig, SIG_DFL);
+        }
+        Log::initFork(Config::getLogFilePath(fmt::format("sample{}.log", sample_id)),
+                      Config::getLogFilePath(fmt::format("sample{}.stat", sample_id)));
+        checkpoint_pending = false;
+        switchTo(detail_cpu);
+        phase = PHASE_DETAIL_WARM;
+        switch_inst = arch->getInstret() + config.sample_warmup;
+        return;
+    }
+    close(fds[1]);
+    sample_children[pid] = fds[0];
+    sample_id++;
+    // the parent runs through the sample window, warming detail_cpu as usual
+    sample_start += config.sample_period;
+    switch_inst = sample_start;
+}
+
+bool EMU::waitSample(bool block) {
+    int status;
+    pid_t pid = waitpid(-1, &status, block ? 0 : WNOHANG);
+    if (pid <= 0) {
+        return false;
+    }
+    auto iter = sample_children.find(pid);
+    if (iter == sample_children.end()) {
+        return true;
+    }
+    uint64_t result[2];
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0 &&
+        read(iter->second, result, sizeof(result)) == sizeof(result) && result[1] != 0) {
+        addSample((double)result[0] / result[1]);
+    } else {
+        Log::warn("sample child {} failed with status {}", pid, status);
+    }
+    close(iter->second);
+    sample_children.erase(iter);
+    return true;
+}
+
+bool EMU::save(const std::string& path) {
+    Checkpoint cp;
+    cp.uarch = config.checkpoint_uarch;
+    cp.addSection("emu");
+    cp.write(tick);
+    cp.addSection("arch");
+    arch->save(&cp);
+    cp.addSection("cpu");
+    cpu->save(&cp);
+    CacheManager::getInstance().save(&cp);
+    if (!cp.dump(path)) {
+        return false;
+    }
+    Log::info("checkpoint saved to {} at tick {} instret {}", path, tick, arch->getInstret());
+    return true;
+}
+
+bool EMU::restore(const std::string& path) {
+    Checkpoint cp;
+    if (!cp.open(path)) {
+        return false;
+    }
+    if (!cp.findSection("emu") || !cp.findSection("arch") || !cp.findSection("cpu")) {
+        Log::error("checkpoint {} has no arch state", path);
+        return false;
     }
+    cp.findSection("emu");
+    cp.read(tick);
+    cp.findSection("arch");
+    arch->restore(&cp);
+    cp.findSection("cpu");
+    cpu->restore(&cp);
+    CacheManager::getInstance().restore(&cp);
+    Log::info("checkpoint restored from {} at tick {} instret {}", path, tick, arch->getInstret());
+    return true;
 }
 
 void EMU::stop() {
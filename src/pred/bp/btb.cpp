@@ -1,5 +1,6 @@
 #include "pred/bp/btb.h"
 #include "common/log.h"
+#include "common/checkpoint.h"
 
 BTB::~BTB() {
     for (int i = 0; i < table_size; i++) {
@@ -52,3 +53,22 @@ void BTB::update(bool real_taken, uint64_t pc, int size, uint64_t target, InstTy
 int BTB::getMetaSize() {
     return sizeof(BTBEntry);
 }
+
+void BTB::save(Checkpoint* cp) {
+    cp->write(table_size);
+    for (int i = 0; i < table_size; i++) {
+        cp->write(*table[i]);
+    }
+}
+
+void BTB::restore(Checkpoint* cp) {
+    int size;
+    cp->read(size);
+    if (size != table_size) {
+        Log::error("BTB::restore: table size mismatch, checkpoint {}, current {}", size, table_size);
+        ExitHandler::exit(1);
+    }
+    for (int i = 0; i < table_size; i++) {
+        cp->read(*table[i]);
+    }
+}
@@ -1,6 +1,7 @@
 #include "pred/bp/gshare.h"
 #include <bit>
 #include "common/log.h"
+#include "common/checkpoint.h"
 
 GShareBP::~GShareBP() {
     delete[] table;
@@ -51,4 +52,19 @@ void GShareBP::update(bool real_taken, uint64_t pc, int size, uint64_t target, I
 
 int GShareBP::getMetaSize() {
     return sizeof(GShareMeta);
+}
+
+void GShareBP::save(Checkpoint* cp) {
+    cp->write(table_size);
+    cp->write(table, table_size);
+}
+
+void GShareBP::restore(Checkpoint* cp) {
+    int size;
+    cp->read(size);
+    if (size != table_size) {
+        Log::error("GShareBP::restore: table size mismatch, checkpoint {}, current {}", size, table_size);
+        ExitHandler::exit(1);
+    }
+    cp->read(table, table_size);
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "pred/bp/ras.h"
+#include "common/log.h"
+#include "common/checkpoint.h"
 
 RAS::~RAS() {
     delete[] ras;
@@ -50,4 +52,21 @@ void RAS::redirect(bool real_taken, uint64_t pc, int size, uint64_t target, Inst
 
 int RAS::getMetaSize() {
     return sizeof(RASMeta);
+}
+
+void RAS::save(Checkpoint* cp) {
+    cp->write(size);
+    cp->write(ras, size * sizeof(uint64_t));
+    cp->write(top);
+}
+
+void RAS::restore(Checkpoint* cp) {
+    int ras_size;
+    cp->read(ras_size);
+    if (ras_size != size) {
+        Log::error("RAS::restore: size mismatch, checkpoint {}, current {}", ras_size, size);
+        ExitHandler::exit(1);
+    }
+    cp->read(ras, size * sizeof(uint64_t));
+    cp->read(top);
 }
\ No newline at end of file
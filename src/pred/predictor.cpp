@@ -2,6 +2,7 @@
 #include "common/log.h"
 #include "config.h"
 #include "common/common.h"
+#include "common/checkpoint.h"
 
 Predictor::~Predictor() {
     for (int i = 0; i < retire_size; i++) {
@@ -211,3 +212,33 @@ void Predictor::update(bool real_taken, uint64_t pc, int size, uint64_t target,
     }
     predTimes++;
 }
+
+void Predictor::warm(uint64_t pc, DecodeInfo* info, int size, uint64_t target) {
+    uint64_t next_pc;
+    uint8_t pred_size;
+    bool taken;
+    int idx = -1;
+    while (idx < 0) {
+        idx = predict(pc, info, next_pc, pred_size, taken, false);
+    }
+    bool is_branch = info->type >= BRANCH_START && info->type <= BRANCH_END;
+    bool real_taken = info->type == COND ? info->dst_data[1] != 0 : is_branch;
+    if (next_pc != target) {
+        redirect(real_taken, pc, size, target, info->type, idx);
+    }
+    if (is_branch) {
+        update(real_taken, pc, size, target, info->type, idx, 0);
+    }
+}
+
+void Predictor::save(Checkpoint* cp) {
+    for (auto bp : bps) {
+        bp->save(cp);
+    }
+}
+
+void Predictor::restore(Checkpoint* cp) {
+    for (auto bp : bps) {
+        bp->restore(cp);
+    }
+}
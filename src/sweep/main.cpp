@@ -0,0 +1,18 @@
+#include <iostream>
+#include "sweep.h"
+#include "common/log.h"
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cout << "Usage: " << argv[0] << " <sweep_file>" << std::endl;
+        return 1;
+    }
+
+    Sweep sweep;
+    sweep.setup(argv[1]);
+    sweep.run();
+    sweep.write();
+    // drain the async loggers of all points
+    spdlog::shutdown();
+    return 0;
+}
@@ -0,0 +1,207 @@
+#include "sweep.h"
+#include "emu.h"
+#include "common/log.h"
+#include <nlohmann/json.hpp>
+#include <thread>
+#include <chrono>
+#include <pthread.h>
+#include <sched.h>
+
+using json = nlohmann::json;
+
+void Sweep::setup(const std::string& path) {
+    std::fstream sweep_file(path, std::ios::in);
+    if (!sweep_file.is_open()) {
+        std::cerr << "Error: Failed to open sweep file " << path << std::endl;
+        ExitHandler::exit(1);
+    }
+    std::string line;
+    while (std::getline(sweep_file, line)) {
+        auto pos = line.find("=");
+        if (pos == std::string::npos || trim(line).starts_with("#")) {
+            continue;
+        }
+        std::string key = trim(line.substr(0, pos));
+        std::string value = trim(line.substr(pos + 1));
+        if (key == "config") {
+            config_path = value;
+        } else if (key == "output") {
+            output = value;
+        } else if (key == "jobs") {
+            jobs = std::stoull(value);
+        } else if (key == "pin") {
+            pin = std::stoi(value) != 0;
+        } else if (value.find(',') == std::string::npos) {
+            fixed[key] = value;
+        } else {
+            std::vector<std::string> values;
+            size_t start = 0;
+            while (start <= value.size()) {
+                size_t end = value.find(',', start);
+                if (end == std::string::npos) {
+                    end = value.size();
+                }
+                values.push_back(trim(value.substr(start, end - start)));
+                start = end + 1;
+            }
+            axes.push_back({key, values});
+        }
+    }
+    if (config_path.empty()) {
+        std::cerr << "Error: sweep file " << path << " has no config" << std::endl;
+        ExitHandler::exit(1);
+    }
+
+    // cartesian product, the last axis changes fastest
+    points.push_back(Point());
+    for (auto& axis : axes) {
+        std::vector<Point> next;
+        for (auto& point : points) {
+            for (auto& value : axis.second) {
+                next.push_back(point);
+                next.back().values.push_back(value);
+            }
+        }
+        points.swap(next);
+    }
+    if (jobs == 0) {
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+    jobs = std::min<uint64_t>(jobs, points.size());
+}
+
+void Sweep::run() {
+    fs::create_directories(fs::path(output));
+    std::vector<int> cpus;
+    cpu_set_t allowed;
+    if (pin && sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        for (int i = 0; i < CPU_SETSIZE; i++) {
+            if (CPU_ISSET(i, &allowed)) {
+                cpus.push_back(i);
+            }
+        }
+    }
+    std::cout << "sweep " << points.size() << " points on " << jobs << " threads" << std::endl;
+    std::vector<std::thread> workers;
+    for (uint64_t i = 0; i < jobs; i++) {
+        workers.emplace_back(&Sweep::worker, this, cpus.empty() ? -1 : cpus[i % cpus.size()]);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void Sweep::worker(int cpu) {
+    if (cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+    // a failing point must not end the other simulations
+    ExitHandler::trapExit(true);
+    size_t idx;
+    while ((idx = next_point++) < points.size()) {
+        runPoint(idx);
+    }
+}
+
+void Sweep::runPoint(size_t idx) {
+    Point& point = points[idx];
+    // points run side by side, keep their output out of the terminal
+    std::map<std::string, std::string> overrides = {{"log_stdio", "0"}, {"serial_stdio", "0"}};
+    for (auto& item : fixed) {
+        overrides[item.first] = item.second;
+    }
+    for (size_t i = 0; i < axes.size(); i++) {
+        overrides[axes[i].first] = point.values[i];
+    }
+    overrides["log_path"] = (fs::path(output) / fmt::format("point{}", idx)).string();
+    // waitpid of a forked sample would reap the children of other points
+    overrides["sample_fork"] = "0";
+
+    auto start = std::chrono::steady_clock::now();
+    try {
+        EMU emu;
+        emu.init(config_path, overrides);
+        emu.run();
+        Stats::writeback();
+        point.stats = Stats::collect();
+        point.status = 0;
+    } catch (const SimExit& e) {
+        point.status = e.code;
+    } catch (const std::exception& e) {
+        std::lock_guard<std::mutex> lock(print_mutex);
+        std::cerr << "Error: point" << idx << ": " << e.what() << std::endl;
+        point.status = -1;
+    }
+    point.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::lock_guard<std::mutex> lock(print_mutex);
+    done_points++;
+    std::string desc;
+    for (size_t i = 0; i < axes.size(); i++) {
+        desc += fmt::format(" {}={}", axes[i].first, point.values[i]);
+    }
+    std::cout << fmt::format("[{}/{}] point{}{} {} in {:.2f}s", done_points, points.size(), idx, desc,
+                             point.status == 0 ? "done" : fmt::format("failed with code {}", point.status),
+                             point.seconds) << std::endl;
+}
+
+void Sweep::write() {
+    // stats of all points, in the order they are first reported
+    std::vector<std::string> names;
+    for (auto& point : points) {
+        for (auto& stat : point.stats) {
+            if (std::find(names.begin(), names.end(), stat.first) == names.end()) {
+                names.push_back(stat.first);
+            }
+        }
+    }
+
+    std::ofstream csv(fs::path(output) / "sweep.csv");
+    csv << "point,status,seconds";
+    for (auto& axis : axes) {
+        csv << "," << axis.first;
+    }
+    for (auto& name : names) {
+        csv << "," << name;
+    }
+    csv << "\n";
+    json result = json::array();
+    for (size_t idx = 0; idx < points.size(); idx++) {
+        Point& point = points[idx];
+        csv << fmt::format("{},{},{:.3f}", idx, point.status, point.seconds);
+        json item;
+        item["point"] = idx;
+        item["status"] = point.status;
+        item["seconds"] = point.seconds;
+        item["params"] = json::object();
+        for (size_t i = 0; i < axes.size(); i++) {
+            csv << "," << point.values[i];
+            item["params"][axes[i].first] = point.values[i];
+        }
+        item["stats"] = json::object();
+        for (auto& name : names) {
+            auto iter = std::find_if(point.stats.begin(), point.stats.end(),
+                                     [&name](auto& stat) { return stat.first == name; });
+            csv << ",";
+            if (iter == point.stats.end()) {
+                continue;
+            }
+            double value = iter->second;
+            csv << fmt::format("{}", value);
+            if (std::isnan(value)) {
+                item["stats"][name] = nullptr;
+            } else if (value == std::floor(value) && std::abs(value) < 1e15) {
+                item["stats"][name] = (int64_t)value;
+            } else {
+                item["stats"][name] = value;
+            }
+        }
+        csv << "\n";
+        result.push_back(item);
+    }
+    std::ofstream(fs::path(output) / "sweep.json") << result.dump(2) << std::endl;
+    std::cout << "results written to " << (fs::path(output) / "sweep.csv").string() << " and sweep.json" << std::endl;
+}
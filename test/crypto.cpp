@@ -0,0 +1,72 @@
+// known answer checks of the Zksed instructions, see inc/arch/riscv/crypto.h
+// xmake build crypto_test && xmake run crypto_test
+#include "arch/riscv/crypto.h"
+#include <cstdio>
+#include <cstring>
+
+using namespace cds::arch::riscv;
+
+static int failed = 0;
+
+static void check(const char* name, uint32_t res, uint32_t expect) {
+    if (res != expect) {
+        printf("mismatch: %s %#010x, expected %#010x\n", name, res, expect);
+        failed++;
+    }
+}
+
+static uint32_t load_word(const uint8_t* bytes) {
+    uint32_t word;
+    memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+/**
+ * @brief T and T' of SM4 the way guest code runs them, one instruction per byte
+ */
+static uint32_t sm4_round(uint32_t rs1, uint32_t rs2, bool key) {
+    for (int shamt = 0; shamt < 32; shamt += 8) {
+        rs1 = key ? sm4ks(rs1, rs2, shamt) : sm4ed(rs1, rs2, shamt);
+    }
+    return rs1;
+}
+
+int main(int argc, char** argv) {
+    // sbox(0x6c) = 1, the values of the Sail model
+    check("sm4ed bs 0", sm4ed(0, 0x6c, 0), 0x04040105);
+    check("sm4ed bs 3", sm4ed(0, 0x6c000000, 24), 0x05040401);
+    check("sm4ks bs 0", sm4ks(0, 0x6c, 0), 0x20800001);
+
+    // example 1 of GB/T 32907, the words are loaded from memory as the guest does
+    static const uint8_t key[16] = {
+        0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10
+    };
+    static const uint8_t cipher[16] = {
+        0x68, 0x1e, 0xdf, 0x34, 0xd2, 0x06, 0x96, 0x5e, 0x86, 0xb3, 0xe9, 0x4f, 0x53, 0x6e, 0x42, 0x46
+    };
+    static const uint32_t fk[4] = { 0xa3b1bac6, 0x56aa3350, 0x677d9197, 0xb27022dc };
+    uint32_t k[4], x[4], rk[32];
+    for (int i = 0; i < 4; i++) {
+        k[i] = load_word(key + i * 4) ^ __builtin_bswap32(fk[i]);
+        x[i] = load_word(key + i * 4);
+    }
+    for (int i = 0; i < 32; i++) {
+        uint8_t ck_bytes[4];
+        for (int j = 0; j < 4; j++) {
+            ck_bytes[j] = (4 * i + j) * 7;
+        }
+        rk[i] = sm4_round(k[i % 4], k[(i + 1) % 4] ^ k[(i + 2) % 4] ^ k[(i + 3) % 4] ^ load_word(ck_bytes), true);
+        k[i % 4] = rk[i];
+    }
+    check("sm4 rk0", __builtin_bswap32(rk[0]), 0xf12186f9);
+    check("sm4 rk31", __builtin_bswap32(rk[31]), 0x9124a012);
+    for (int i = 0; i < 32; i++) {
+        x[i % 4] = sm4_round(x[i % 4], x[(i + 1) % 4] ^ x[(i + 2) % 4] ^ x[(i + 3) % 4] ^ rk[i], false);
+    }
+    for (int i = 0; i < 4; i++) {
+        check("sm4 cipher", x[3 - i], load_word(cipher + i * 4));
+    }
+
+    printf("%s\n", failed == 0 ? "all known answers match" : "known answers mismatch");
+    return failed == 0 ? 0 : 1;
+}
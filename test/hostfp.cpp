@@ -0,0 +1,120 @@
+// compares the host fpu path of fadd/fsub/fmul/fdiv with softfloat, see inc/arch/riscv/hostfp.h
+// xmake build hostfp_test && xmake run hostfp_test [iterations] [seed]
+#include "arch/riscv/hostfp.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace cds::arch::riscv;
+
+static std::mt19937_64 rng;
+
+/**
+ * @brief random operand of a format with exp_bits exponent and man_bits mantissa bits
+ */
+static uint64_t random_operand(int exp_bits, int man_bits) {
+    uint64_t exp_max = (1ULL << exp_bits) - 1;
+    uint64_t man_mask = (1ULL << man_bits) - 1;
+    uint64_t sign = (rng() & 1) << (exp_bits + man_bits);
+    uint64_t man = rng() & man_mask;
+    uint64_t exp;
+    switch (rng() % 8) {
+    case 0: exp = 0; man = 0; break;                               // zero
+    case 1: exp = 0; man = man == 0 ? 1 : man; break;              // subnormal
+    case 2: exp = 1 + rng() % 4; break;                            // tiny
+    case 3: exp = exp_max - 1 - rng() % 4; break;                  // huge
+    case 4: exp = exp_max; man = rng() % 4 == 0 ? 0 : man; break;  // inf or nan
+    case 5: exp = (exp_max >> 1) + rng() % 3 - 1; break;           // near one
+    default: exp = 1 + rng() % (exp_max - 1); break;               // any normal
+    }
+    return sign | (exp << man_bits) | man;
+}
+
+static uint16_t random_flags() {
+    static constexpr uint16_t flags[] = {
+        float_flag_invalid, float_flag_divbyzero, float_flag_overflow, float_flag_underflow
+    };
+    uint16_t res = 0;
+    for (uint16_t flag : flags) {
+        if (rng() % 4 == 0) {
+            res |= flag;
+        }
+    }
+    return res;
+}
+
+static const char* op_names[] = { "fadd", "fsub", "fmul", "fdiv" };
+
+static uint64_t soft_fp64(HostFpOp op, uint64_t a, uint64_t b, float_status* status) {
+    switch (op) {
+    case HOST_FADD: return float64_add(a, b, status);
+    case HOST_FSUB: return float64_sub(a, b, status);
+    case HOST_FMUL: return float64_mul(a, b, status);
+    default: return float64_div(a, b, status);
+    }
+}
+
+static uint32_t soft_fp32(HostFpOp op, uint32_t a, uint32_t b, float_status* status) {
+    switch (op) {
+    case HOST_FADD: return float32_add(a, b, status);
+    case HOST_FSUB: return float32_sub(a, b, status);
+    case HOST_FMUL: return float32_mul(a, b, status);
+    default: return float32_div(a, b, status);
+    }
+}
+
+int main(int argc, char** argv) {
+    uint64_t iterations = argc > 1 ? strtoull(argv[1], nullptr, 0) : 1000000;
+    uint64_t seed = argc > 2 ? strtoull(argv[2], nullptr, 0) : 1;
+    rng.seed(seed);
+    uint64_t host = 0;
+    uint64_t mismatch = 0;
+    for (uint64_t i = 0; i < iterations; i++) {
+        HostFpOp op = (HostFpOp)(i % 4);
+        bool is_double = (i / 4) % 2;
+        // half of the ops ask for rne, the only mode the host path takes
+        int rm = rng() % 2 ? (rng() % 2 ? 0 : 7) : rng() % 8;
+        uint8_t frm = rng() % 2 ? 0 : rng() % 8;
+        // both states of the sticky inexact flag, the other flags are kept as they are
+        uint16_t flags = random_flags() | (rng() % 2 ? float_flag_inexact : 0);
+        float_status host_status{};
+        float_status soft_status{};
+        host_status.float_exception_flags = flags;
+        soft_status.float_exception_flags = flags;
+        soft_status.float_rounding_mode = riscv_round_mode(rm, frm);
+        uint64_t a, b, host_res, soft_res;
+        bool taken;
+        if (is_double) {
+            a = random_operand(11, 52);
+            b = random_operand(11, 52);
+            taken = host_fp64(&host_status, frm, op, rm, a, b, host_res);
+            if (taken) {
+                soft_res = soft_fp64(op, a, b, &soft_status);
+            }
+        } else {
+            a = random_operand(8, 23);
+            b = random_operand(8, 23);
+            uint32_t res32;
+            taken = host_fp32(&host_status, frm, op, rm, a, b, res32);
+            if (taken) {
+                host_res = res32;
+                soft_res = soft_fp32(op, a, b, &soft_status);
+            }
+        }
+        // a fallback runs softfloat itself, only the host results need checking
+        if (!taken) {
+            continue;
+        }
+        host++;
+        if (host_res != soft_res || host_status.float_exception_flags != soft_status.float_exception_flags) {
+            if (mismatch < 16) {
+                printf("mismatch: %s.%c rm %d frm %d flags %#x a %#lx b %#lx host %#lx/%#x soft %#lx/%#x\n",
+                       op_names[op], is_double ? 'd' : 's', rm, frm, flags, a, b,
+                       host_res, host_status.float_exception_flags, soft_res, soft_status.float_exception_flags);
+            }
+            mismatch++;
+        }
+    }
+    printf("%lu ops, %lu on the host fpu, %lu mismatches\n", iterations, host, mismatch);
+    return mismatch == 0 ? 0 : 1;
+}
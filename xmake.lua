@@ -30,6 +30,16 @@ option("ram_sim")
     set_showmenu(true)
     set_values("ramulator2", "dramsim3")
 
+option("runtime_layer")
+    set_default(false)
+    set_showmenu(true)
+    set_description("build the component tree from a yaml/json layer at runtime, see inc/common/layer.h")
+
+option("table_decode")
+    set_default(false)
+    set_showmenu(true)
+    set_description("generate the riscv decoder as lookup tables instead of a decode tree, see scripts/decodetree.py")
+
 rule("mode.relWithDebInfo")
     after_load(function (target)
         target:set("symbols", "debug")
@@ -68,12 +78,8 @@ package("softfloat_lib")
         return result
     end)
 
-target("CPUDelaySim")
-    set_kind("binary")
-    set_default(true)
-    -- set_optimize("fastest")
-    set_rundir("$(projectdir)")
-    add_files("src/**.cpp|arch/**.cpp")
+-- sources and packages shared by the simulator and the sweep driver
+local function add_sim_sources()
     add_includedirs("inc")
     set_pcxxheader("inc/common/common.h")
     add_cxxflags("-mavx2")
@@ -93,18 +99,61 @@ target("CPUDelaySim")
         add_packages("dramsim3_lib")
     end
     add_packages("nlohmann_json", "yaml-cpp", "boost", "spdlog", "softfloat_lib", "thread-pool", "zstd")
+end
+
+target("CPUDelaySim")
+    set_kind("binary")
+    set_default(true)
+    -- set_optimize("fastest")
+    set_rundir("$(projectdir)")
+    add_files("src/**.cpp|arch/**.cpp|sweep/**.cpp")
+    add_sim_sources()
+
+-- runs a grid of configurations in one process, see inc/sweep.h
+target("CPUDelaySweep")
+    set_kind("binary")
+    set_default(false)
+    set_rundir("$(projectdir)")
+    add_files("src/**.cpp|arch/**.cpp|main.cpp")
+    add_sim_sources()
+    add_syslinks("pthread")
+
+-- checks the host fpu path of the riscv interpreter against softfloat, see test/hostfp.cpp
+target("hostfp_test")
+    set_kind("binary")
+    set_default(false)
+    add_files("test/hostfp.cpp")
+    add_includedirs("inc")
+    add_packages("softfloat_lib")
+
+-- known answer checks of the riscv crypto instructions, see test/crypto.cpp
+target("crypto_test")
+    set_kind("binary")
+    set_default(false)
+    add_files("test/crypto.cpp")
+    add_includedirs("inc")
 
 target("riscv_decode")
     set_kind("phony")
     on_load(function (target)
-        if not os.isfile("inc/arch/riscv/trans_rv16.h") then
-            os.exec("python ./scripts/decodetree.py --static-decode=decode_insn16 --insnwidth=16 inc/arch/riscv/insn16.decode -o build/trans_rv16_tmp.c.inc")
-            os.execv("python", {"./scripts/emu_cpu_put_ic.py", "build/trans_rv16_tmp.c.inc"}, {stdout = "inc/arch/riscv/trans_rv16.h"})
-        end
-        if not os.isfile("inc/arch/riscv/trans_rv32.h") then
-            os.exec("python ./scripts/decodetree.py --static-decode=decode_insn32 --insnwidth=32 inc/arch/riscv/insn32.decode -o build/trans_rv32_tmp.c.inc")
-            os.execv("python", {"./scripts/emu_cpu_put_ic.py", "build/trans_rv32_tmp.c.inc"}, {stdout = "inc/arch/riscv/trans_rv32.h"})
+        local table_decode = get_config("table_decode") == true
+        local function generate(width)
+            local header = "inc/arch/riscv/trans_rv" .. width .. ".h"
+            local need_run = not os.isfile(header)
+            -- 生成方式与 table_decode 选项不一致时重新生成
+            if not need_run then
+                local is_table = io.readfile(header):find("_entries[] = {", 1, true) ~= nil
+                need_run = is_table ~= table_decode
+            end
+            if need_run then
+                local tmp = "build/trans_rv" .. width .. "_tmp.c.inc"
+                local flags = table_decode and " --table-decode" or ""
+                os.exec("python ./scripts/decodetree.py --static-decode=decode_insn" .. width .. " --insnwidth=" .. width .. flags .. " inc/arch/riscv/insn" .. width .. ".decode -o " .. tmp)
+                os.execv("python", {"./scripts/emu_cpu_put_ic.py", tmp}, {stdout = header})
+            end
         end
+        generate("16")
+        generate("32")
     end)
 
 target("parse_param")
@@ -112,6 +161,7 @@ target("parse_param")
     on_load(function (target)
         local config_dir = "configs/" .. config
         local obj_dir = config_dir .. "/obj"
+        local runtime = get_config("runtime_layer") == true
         local need_run = false
         
         -- 检查obj目录是否存在
@@ -153,10 +203,22 @@ target("parse_param")
                     end
                 end
             end
+            -- 切换runtime_layer后重新生成
+            local emu_params = obj_dir .. "/params_EMU.h"
+            if os.isfile(emu_params) then
+                local generated_runtime = io.readfile(emu_params):find("RUNTIME_LAYER = true", 1, true) ~= nil
+                if generated_runtime ~= runtime then
+                    need_run = true
+                end
+            end
         end
         
         if need_run then
-            os.execv("python", {"./scripts/parse.py", "--filepath", config_dir})
+            local argv = {"./scripts/parse.py", "--filepath", config_dir}
+            if runtime then
+                table.insert(argv, "--runtime")
+            end
+            os.execv("python", argv)
         end
     end)
 --